@@ -7,6 +7,7 @@
 #define BX_ALLOCATOR_H_HEADER_GUARD
 
 #include "bx.h"
+#include "mutex.h"
 #include "uint32_t.h"
 
 #if BX_CONFIG_ALLOCATOR_DEBUG
@@ -45,6 +46,10 @@ void  operator delete(void*, bx::PlacementNewTag, void*) throw();
 
 namespace bx
 {
+	struct WriterI;
+	class  Error;
+	class  FilePath;
+
 	/// Abstract allocator interface.
 	///
 	struct BX_NO_VTABLE AllocatorI
@@ -95,6 +100,445 @@ namespace bx
 			) override;
 	};
 
+	/// Linear (bump pointer) allocator. Memory is carved out of large chunks obtained from
+	/// backing allocator, individual frees are ignored, and memory is reclaimed all at once with
+	/// `reset`, or by rewinding to previously obtained marker.
+	///
+	/// @remark Not thread safe.
+	///
+	class LinearAllocator : public AllocatorI
+	{
+		BX_CLASS(LinearAllocator
+			, NO_DEFAULT_CTOR
+			, NO_COPY
+			);
+
+	public:
+		/// Allocation position, used to free all allocations made after it was obtained.
+		struct Marker
+		{
+			void*  chunk;
+			size_t top;
+		};
+
+		///
+		LinearAllocator(AllocatorI* _allocator, size_t _chunkSize = 64<<10);
+
+		///
+		virtual ~LinearAllocator();
+
+		///
+		virtual void* realloc(
+			  void* _ptr
+			, size_t _size
+			, size_t _align
+			, const char* _file
+			, uint32_t _line
+			) override;
+
+		/// Free all allocations. Chunks are kept for reuse.
+		void reset();
+
+		/// Returns current allocation position.
+		Marker getMarker() const;
+
+		/// Free all allocations made after marker was obtained.
+		void rewind(const Marker& _marker);
+
+		/// Release chunks that are not in use back to backing allocator.
+		void trim();
+
+		/// Returns number of bytes allocated from chunks, including alignment padding.
+		size_t getUsedSize() const;
+
+	private:
+		struct Chunk;
+
+		///
+		void* alloc(size_t _size, size_t _align);
+
+		///
+		size_t getUsedSizeFrom(const void* _ptr) const;
+
+		AllocatorI* m_allocator;
+		Chunk*      m_first;
+		Chunk*      m_current;
+		size_t      m_chunkSize;
+		size_t      m_last;
+	};
+
+	/// Rewinds linear allocator to position at scope entry, when leaving scope.
+	class LinearAllocatorScope
+	{
+		BX_CLASS(LinearAllocatorScope
+			, NO_DEFAULT_CTOR
+			, NO_COPY
+			);
+
+	public:
+		///
+		LinearAllocatorScope(LinearAllocator& _allocator);
+
+		///
+		~LinearAllocatorScope();
+
+	private:
+		LinearAllocator&        m_allocator;
+		LinearAllocator::Marker m_marker;
+	};
+
+	/// Linear allocator over reserved range of virtual address space. Pages are committed on
+	/// demand, and the most recent allocation is resized in place, so that single buffer can grow
+	/// up to reserved size without being copied. Other frees are ignored until `reset`.
+	///
+	/// @remark Not thread safe.
+	///
+	class VirtualArenaAllocator : public AllocatorI
+	{
+		BX_CLASS(VirtualArenaAllocator
+			, NO_DEFAULT_CTOR
+			, NO_COPY
+			);
+
+	public:
+		/// Reserve `_reserveSize` bytes of address space, and commit it in `_commitSize`
+		/// increments. When `_hugePages` is set, range is hinted to be backed with huge pages.
+		VirtualArenaAllocator(size_t _reserveSize, size_t _commitSize = 64<<10, bool _hugePages = false);
+
+		///
+		virtual ~VirtualArenaAllocator();
+
+		///
+		virtual void* realloc(
+			  void* _ptr
+			, size_t _size
+			, size_t _align
+			, const char* _file
+			, uint32_t _line
+			) override;
+
+		/// Free all allocations. Pages stay committed.
+		void reset();
+
+		/// Decommit pages that are not in use.
+		void trim();
+
+		/// Returns number of bytes used by allocations, including headers and alignment padding.
+		size_t getUsedSize() const;
+
+		/// Returns number of committed bytes.
+		size_t getCommittedSize() const;
+
+		/// Returns number of reserved bytes.
+		size_t getReservedSize() const;
+
+	private:
+		///
+		bool commit(size_t _size);
+
+		uint8_t* m_data;
+		size_t   m_reserved;
+		size_t   m_committed;
+		size_t   m_commitSize;
+		size_t   m_top;
+		size_t   m_last;
+	};
+
+	/// Fixed size block pool allocator. Blocks are carved out of slabs obtained from backing
+	/// allocator, and freed blocks are kept in free list for reuse.
+	///
+	/// @remark Not thread safe.
+	///
+	class PoolAllocator : public AllocatorI
+	{
+		BX_CLASS(PoolAllocator
+			, NO_DEFAULT_CTOR
+			, NO_COPY
+			);
+
+	public:
+		///
+		PoolAllocator(AllocatorI* _allocator, uint32_t _blockSize, uint32_t _blocksPerSlab = 256);
+
+		///
+		virtual ~PoolAllocator();
+
+		/// Allocates or frees single block. Size must not be larger than block size, and
+		/// alignment must not be larger than block alignment.
+		virtual void* realloc(
+			  void* _ptr
+			, size_t _size
+			, size_t _align
+			, const char* _file
+			, uint32_t _line
+			) override;
+
+		/// Returns block size.
+		uint32_t getBlockSize() const;
+
+		/// Returns alignment of blocks.
+		uint32_t getBlockAlign() const;
+
+		/// Returns number of allocated blocks.
+		uint32_t getNumBlocks() const;
+
+	private:
+		struct Slab;
+
+		AllocatorI* m_allocator;
+		Slab*       m_slab;
+		void*       m_free;
+		uint8_t*    m_top;
+		uint8_t*    m_end;
+		uint32_t    m_blockSize;
+		uint32_t    m_blockAlign;
+		uint32_t    m_stride;
+		uint32_t    m_blocksPerSlab;
+		uint32_t    m_numBlocks;
+	};
+
+	///
+	template <uint32_t BlockSizeT, uint32_t BlocksPerSlabT = 256>
+	class PoolAllocatorT : public PoolAllocator
+	{
+	public:
+		///
+		PoolAllocatorT(AllocatorI* _allocator);
+
+		///
+		virtual ~PoolAllocatorT();
+	};
+
+	/// Thread safe fixed size block pool allocator. Free list is lock-free, and lock is taken
+	/// only when pool needs to grow. Slab sizes double with each growth.
+	///
+	class ConcurrentPoolAllocator : public AllocatorI
+	{
+		BX_CLASS(ConcurrentPoolAllocator
+			, NO_DEFAULT_CTOR
+			, NO_COPY
+			);
+
+	public:
+		///
+		ConcurrentPoolAllocator(AllocatorI* _allocator, uint32_t _blockSize, uint32_t _blocksPerSlab = 256);
+
+		///
+		virtual ~ConcurrentPoolAllocator();
+
+		/// Allocates or frees single block. Size must not be larger than block size, and
+		/// alignment must not be larger than block alignment.
+		virtual void* realloc(
+			  void* _ptr
+			, size_t _size
+			, size_t _align
+			, const char* _file
+			, uint32_t _line
+			) override;
+
+		/// Returns block size.
+		uint32_t getBlockSize() const;
+
+		/// Returns alignment of blocks.
+		uint32_t getBlockAlign() const;
+
+		/// Returns number of allocated blocks.
+		uint32_t getNumBlocks() const;
+
+	private:
+		///
+		bool grow(uint64_t _head);
+
+		///
+		uint8_t* getBlock(uint32_t _index) const;
+
+		///
+		uint32_t getIndex(const void* _ptr) const;
+
+		AllocatorI* m_allocator;
+		uint8_t*    m_slab[32];
+		Mutex       m_lock;
+
+		uint32_t m_blockSize;
+		uint32_t m_blockAlign;
+		uint32_t m_stride;
+		uint32_t m_blocksPerSlab;
+
+		volatile uint32_t m_numSlabs;
+		volatile int32_t  m_numBlocks;
+
+		BX_ALIGN_DECL_CACHE_LINE(volatile uint64_t) m_head;
+	};
+
+	///
+	template <uint32_t BlockSizeT, uint32_t BlocksPerSlabT = 256>
+	class ConcurrentPoolAllocatorT : public ConcurrentPoolAllocator
+	{
+	public:
+		///
+		ConcurrentPoolAllocatorT(AllocatorI* _allocator);
+
+		///
+		virtual ~ConcurrentPoolAllocatorT();
+	};
+
+	/// Two-Level Segregated Fit allocator. Allocation, free, and reallocation are O(1), with
+	/// bounded fragmentation. Memory is managed either within caller supplied memory region, or
+	/// in pools obtained from backing allocator, when more memory is needed.
+	///
+	/// @remark Not thread safe.
+	///
+	class TlsfAllocator : public AllocatorI
+	{
+		BX_CLASS(TlsfAllocator
+			, NO_DEFAULT_CTOR
+			, NO_COPY
+			);
+
+	public:
+		/// Manage caller supplied memory region. Allocator never grows, and allocation fails when
+		/// region is exhausted. Part of region is used for allocator bookkeeping.
+		TlsfAllocator(void* _data, size_t _size);
+
+		/// Manage memory obtained from backing allocator in pools of at least `_poolSize` bytes.
+		TlsfAllocator(AllocatorI* _allocator, size_t _poolSize = 1<<20);
+
+		///
+		virtual ~TlsfAllocator();
+
+		///
+		virtual void* realloc(
+			  void* _ptr
+			, size_t _size
+			, size_t _align
+			, const char* _file
+			, uint32_t _line
+			) override;
+
+		/// Returns number of bytes in used blocks, including block overhead.
+		size_t getUsedSize() const;
+
+		/// Returns number of bytes in all pools.
+		size_t getTotalSize() const;
+
+		/// Returns size of largest free block.
+		size_t getMaxFreeBlockSize() const;
+
+	private:
+		struct Control;
+
+		///
+		bool grow(size_t _size, size_t _align);
+
+		AllocatorI* m_allocator;
+		Control*    m_control;
+		size_t      m_poolSize;
+	};
+
+	/// Allocation statistics of single call site.
+	struct AllocationSiteStats
+	{
+		static constexpr uint32_t kNumBuckets = 16;
+
+		const char* file;                   //!< Source file, or NULL when allocation had no debug info.
+		uint32_t    line;                   //!< Source line.
+		uint64_t    numAllocs;              //!< Number of allocations, and reallocations.
+		uint64_t    numFrees;               //!< Number of frees.
+		uint64_t    liveSize;               //!< Number of bytes currently allocated.
+		uint64_t    peakSize;               //!< Peak of live bytes.
+		uint64_t    totalSize;              //!< Total number of bytes ever allocated.
+		uint64_t    histogram[kNumBuckets]; //!< Allocation count per power of two size bucket.
+	};
+
+	/// Profiling allocator. Forwards allocations to backing allocator, and records statistics
+	/// per call site, identified by `_file` and `_line` arguments. Call sites are kept in
+	/// fixed size lock-free hash table, and when it's full statistics are accumulated into single
+	/// overflow site with `file` set to "(overflow)".
+	///
+	/// @remark Call site info is only passed by `BX_ALLOC` and friends when
+	///   `BX_CONFIG_ALLOCATOR_DEBUG` is enabled, otherwise all allocations are recorded to single
+	///   site with `file` set to NULL.
+	///
+	class ProfilingAllocator : public AllocatorI
+	{
+		BX_CLASS(ProfilingAllocator
+			, NO_DEFAULT_CTOR
+			, NO_COPY
+			);
+
+	public:
+		/// Sort order of call site statistics.
+		struct SortBy
+		{
+			enum Enum
+			{
+				PeakSize,
+				LiveSize,
+				TotalSize,
+				NumAllocs,
+
+				Count
+			};
+		};
+
+		///
+		ProfilingAllocator(AllocatorI* _allocator, uint32_t _maxSites = 4096);
+
+		///
+		virtual ~ProfilingAllocator();
+
+		///
+		virtual void* realloc(
+			  void* _ptr
+			, size_t _size
+			, size_t _align
+			, const char* _file
+			, uint32_t _line
+			) override;
+
+		/// Returns number of recorded call sites.
+		uint32_t getNumSites() const;
+
+		/// Copy up to `_max` call site statistics into `_stats`, sorted in descending order.
+		///
+		/// @returns Number of call sites written.
+		///
+		uint32_t getStats(
+			  AllocationSiteStats* _stats
+			, uint32_t _max
+			, SortBy::Enum _sortBy = SortBy::PeakSize
+			) const;
+
+		/// Write human readable report, sorted by `_sortBy`.
+		void writeReport(
+			  WriterI* _writer
+			, SortBy::Enum _sortBy = SortBy::PeakSize
+			, Error* _err = NULL
+			) const;
+
+		/// Write human readable report into file.
+		bool writeReport(
+			  const FilePath& _filePath
+			, SortBy::Enum _sortBy = SortBy::PeakSize
+			, Error* _err = NULL
+			) const;
+
+	private:
+		struct Site;
+
+		///
+		Site* findSite(const char* _file, uint32_t _line);
+
+		///
+		void* record(void* _ptr, uint32_t _offset, size_t _size, const char* _file, uint32_t _line);
+
+		AllocatorI* m_allocator;
+		Site*       m_site;
+		uint32_t    m_maxSites;
+
+		volatile uint32_t m_numSites;
+	};
+
 	/// Aligns pointer to nearest next aligned address. _align must be power of two.
 	void* alignPtr(
 		  void* _ptr
@@ -10,6 +10,8 @@
 
 namespace bx
 {
+	class JobSystem;
+
 	///
 	struct Line
 	{
@@ -159,8 +161,9 @@ namespace bx
 	/// Convert triangle to axis aligned bounding box.
 	void toAabb(Aabb& _outAabb, const Triangle& _triangle);
 
-	/// Calculate axis aligned bounding box.
-	void toAabb(Aabb& _outAabb, const void* _vertices, uint32_t _numVertices, uint32_t _stride);
+	/// Calculate axis aligned bounding box. When job system is provided, large vertex arrays are
+	/// processed in parallel.
+	void toAabb(Aabb& _outAabb, const void* _vertices, uint32_t _numVertices, uint32_t _stride, JobSystem* _jobSystem = NULL);
 
 	/// Transform vertices and calculate axis aligned bounding box.
 	void toAabb(Aabb& _outAabb, const float* _mtx, const void* _vertices, uint32_t _numVertices, uint32_t _stride);
@@ -180,8 +183,9 @@ namespace bx
 	/// Calculate oriented bounding box.
 	void calcObb(Obb& _outObb, const void* _vertices, uint32_t _numVertices, uint32_t _stride, uint32_t _steps = 17);
 
-	/// Calculate maximum bounding sphere.
-	void calcMaxBoundingSphere(Sphere& _outSphere, const void* _vertices, uint32_t _numVertices, uint32_t _stride);
+	/// Calculate maximum bounding sphere. When job system is provided, large vertex arrays are
+	/// processed in parallel.
+	void calcMaxBoundingSphere(Sphere& _outSphere, const void* _vertices, uint32_t _numVertices, uint32_t _stride, JobSystem* _jobSystem = NULL);
 
 	/// Calculate minimum bounding sphere.
 	void calcMinBoundingSphere(Sphere& _outSphere, const void* _vertices, uint32_t _numVertices, uint32_t _stride, float _step = 0.01f);
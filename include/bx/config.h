@@ -20,4 +20,28 @@
 			)
 #endif // BX_CONFIG_SUPPORTS_THREADING
 
+#ifndef BX_CONFIG_SUPPORTS_FIBERS
+#	define BX_CONFIG_SUPPORTS_FIBERS (1 \
+			&& BX_CONFIG_SUPPORTS_THREADING \
+			&& !BX_CRT_NONE                 \
+			&& (0                           \
+			||  BX_PLATFORM_BSD             \
+			||  BX_PLATFORM_LINUX           \
+			||  BX_PLATFORM_RPI             \
+			)                               \
+			)
+#endif // BX_CONFIG_SUPPORTS_FIBERS
+
+#ifndef BX_CONFIG_SUPPORTS_FUTEX
+#	define BX_CONFIG_SUPPORTS_FUTEX (1 \
+			&& BX_CONFIG_SUPPORTS_THREADING \
+			&& !BX_CRT_NONE                 \
+			&& 0 != BX_CRT_GLIBC            \
+			&& (0                           \
+			||  BX_PLATFORM_LINUX           \
+			||  BX_PLATFORM_RPI             \
+			)                               \
+			)
+#endif // BX_CONFIG_SUPPORTS_FUTEX
+
 #endif // BX_CONFIG_H_HEADER_GUARD
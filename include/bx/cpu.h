@@ -22,6 +22,9 @@ namespace bx
 	///
 	void memoryBarrier();
 
+	/// Hint to CPU that calling thread is in spin-wait loop.
+	void spinPause();
+
 	///
 	template<typename Ty>
 	Ty atomicFetchAndAdd(volatile Ty* _ptr, Ty _value);
@@ -61,6 +64,14 @@ namespace bx
 	///
 	void* atomicExchangePtr(void** _ptr, void* _new);
 
+	/// Atomically load value with acquire semantics.
+	template<typename Ty>
+	Ty atomicLoad(const volatile Ty* _ptr);
+
+	/// Atomically store value with release semantics.
+	template<typename Ty>
+	void atomicStore(volatile Ty* _ptr, Ty _value);
+
 } // namespace bx
 
 #include "inline/cpu.inl"
@@ -0,0 +1,112 @@
+/*
+ * Copyright 2010-2023 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bx/blob/master/LICENSE
+ */
+
+#ifndef BX_CPU_TOPOLOGY_H_HEADER_GUARD
+#define BX_CPU_TOPOLOGY_H_HEADER_GUARD
+
+#include "bx.h"
+
+namespace bx
+{
+	/// Logical CPU. Except `id`, ids are dense indices starting from zero.
+	struct CpuInfo
+	{
+		uint16_t id;       //!< OS logical CPU number, bit position in affinity mask.
+		uint16_t core;     //!< Physical core, SMT siblings have the same core.
+		uint16_t package;  //!< Physical package (socket).
+		uint16_t numaNode; //!< NUMA node.
+		uint16_t l2;       //!< L2 cache, CPUs with the same id share L2 cache.
+		uint16_t l3;       //!< L3 cache, CPUs with the same id share L3 cache.
+	};
+
+	/// CPU topology of the system. On Linux it's read from `/sys/devices/system/cpu`, on other
+	/// platforms each logical CPU is reported as its own core.
+	///
+	/// Affinity masks returned by topology have one bit per logical CPU, and they can be passed
+	/// to `Thread::init` and `Thread::setAffinity`.
+	///
+	/// @remark Only first `kMaxCpus` logical CPUs are enumerated.
+	///
+	class CpuTopology
+	{
+	public:
+		static constexpr uint32_t kMaxCpus = 64;
+
+		/// Query CPU topology.
+		CpuTopology();
+
+		/// Create topology of `_numCpus` logical CPUs, each reported as its own core, without
+		/// querying system. Same topology is used when system topology is not available.
+		///
+		explicit CpuTopology(uint32_t _numCpus);
+
+		///
+		uint32_t getNumCpus() const;
+
+		///
+		uint32_t getNumCores() const;
+
+		///
+		uint32_t getNumPackages() const;
+
+		///
+		uint32_t getNumNumaNodes() const;
+
+		///
+		uint32_t getNumL2() const;
+
+		///
+		uint32_t getNumL3() const;
+
+		/// Returns size of single L2 cache in bytes, or zero if unknown.
+		uint32_t getL2Size() const;
+
+		/// Returns size of single L3 cache in bytes, or zero if unknown.
+		uint32_t getL3Size() const;
+
+		///
+		const CpuInfo& getCpu(uint32_t _cpu) const;
+
+		/// Returns affinity mask of all logical CPUs.
+		uint64_t getMask() const;
+
+		/// Returns affinity mask of core, including all of its SMT siblings.
+		uint64_t getCoreMask(uint32_t _core) const;
+
+		/// Returns affinity mask of CPUs sharing L2 cache.
+		uint64_t getL2Mask(uint32_t _l2) const;
+
+		/// Returns affinity mask of CPUs sharing L3 cache.
+		uint64_t getL3Mask(uint32_t _l3) const;
+
+		///
+		uint64_t getNumaNodeMask(uint32_t _numaNode) const;
+
+		/// Returns affinity mask with single logical CPU per physical core. Threads pinned to
+		/// different CPUs from this mask don't share core with each other.
+		///
+		uint64_t getPhysicalCoreMask() const;
+
+	private:
+		///
+		void init(uint32_t _numCpus);
+
+		///
+		uint64_t getMask(uint16_t CpuInfo::* _member, uint32_t _id) const;
+
+		CpuInfo  m_cpu[kMaxCpus];
+		uint32_t m_numCpus;
+		uint32_t m_numCores;
+		uint32_t m_numPackages;
+		uint32_t m_numNumaNodes;
+		uint32_t m_numL2;
+		uint32_t m_numL3;
+		uint32_t m_l2Size;
+		uint32_t m_l3Size;
+	};
+
+} // namespace bx
+
+#endif // BX_CPU_TOPOLOGY_H_HEADER_GUARD
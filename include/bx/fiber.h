@@ -0,0 +1,68 @@
+/*
+ * Copyright 2010-2023 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bx/blob/master/LICENSE
+ */
+
+#ifndef BX_FIBER_H_HEADER_GUARD
+#define BX_FIBER_H_HEADER_GUARD
+
+#include "allocator.h"
+
+#if BX_CONFIG_SUPPORTS_FIBERS
+
+namespace bx
+{
+	///
+	typedef void (*FiberFn)(void* _userData);
+
+	/// Execution context with its own stack. Switching between fibers is cooperative, and doesn't
+	/// involve OS scheduler.
+	///
+	class Fiber
+	{
+		BX_CLASS(Fiber
+			, NO_DEFAULT_CTOR
+			, NO_COPY
+			);
+
+	public:
+		///
+		Fiber(AllocatorI* _allocator);
+
+		///
+		~Fiber();
+
+		/// Initialize fiber that runs function on its own stack, stack is allocated with guard
+		/// page below it, so that stack overflow faults instead of corrupting memory.
+		///
+		/// @param[in] _fn Fiber function. Function must not return, it must switch to other
+		///   fiber instead.
+		/// @param[in] _userData User data passed to fiber function.
+		/// @param[in] _stackSize Stack size, rounded up to page size.
+		/// @returns True if fiber is initialized.
+		///
+		bool init(FiberFn _fn, void* _userData, uint32_t _stackSize = 64<<10);
+
+		/// Initialize fiber representing calling thread, it's used to switch back to thread.
+		void initFromThread();
+
+		/// Save current context to `_from`, and switch to `_to`.
+		static void switchTo(Fiber* _from, Fiber* _to);
+
+	private:
+		///
+		static void entry(uint32_t _hi, uint32_t _lo);
+
+		AllocatorI* m_allocator;
+		void*       m_context;
+		void*       m_stack;
+		size_t      m_stackSize;
+		FiberFn     m_fn;
+		void*       m_userData;
+	};
+
+} // namespace bx
+
+#endif // BX_CONFIG_SUPPORTS_FIBERS
+
+#endif // BX_FIBER_H_HEADER_GUARD
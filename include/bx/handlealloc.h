@@ -8,11 +8,14 @@
 
 #include "bx.h"
 #include "allocator.h"
+#include "cpu.h"
+#include "endian.h"
 #include "uint32_t.h"
 
 namespace bx
 {
 	constexpr uint16_t kInvalidHandle = UINT16_MAX;
+	constexpr uint32_t kInvalidHandle32 = UINT32_MAX;
 
 	///
 	class HandleAlloc
@@ -42,6 +45,9 @@ namespace bx
 		///
 		bool isValid(uint16_t _handle) const;
 
+		/// Returns position of handle in array returned by `getHandles`.
+		uint16_t getIndex(uint16_t _handle) const;
+
 		///
 		void free(uint16_t _handle);
 
@@ -82,6 +88,250 @@ namespace bx
 		uint16_t m_padding[2*MaxHandlesT];
 	};
 
+	/// Component columns storage used by `SparseSetT`.
+	template <uint16_t MaxHandlesT, typename... ComponentsT>
+	struct SparseSetColumnsT
+	{
+		///
+		void move(uint16_t _dst, uint16_t _src);
+
+		///
+		void clear(uint16_t _index);
+	};
+
+	///
+	template <uint16_t MaxHandlesT, typename Ty, typename... ComponentsT>
+	struct SparseSetColumnsT<MaxHandlesT, Ty, ComponentsT...> : public SparseSetColumnsT<MaxHandlesT, ComponentsT...>
+	{
+		typedef SparseSetColumnsT<MaxHandlesT, ComponentsT...> BaseT;
+
+		///
+		void move(uint16_t _dst, uint16_t _src);
+
+		///
+		void clear(uint16_t _index);
+
+		Ty m_data[MaxHandlesT];
+	};
+
+	/// Selects component type and column storage by component index.
+	template <uint32_t IndexT, typename ColumnsT>
+	struct SparseSetColumnAtT;
+
+	///
+	template <uint16_t MaxHandlesT, typename Ty, typename... ComponentsT>
+	struct SparseSetColumnAtT<0, SparseSetColumnsT<MaxHandlesT, Ty, ComponentsT...> >
+	{
+		typedef Ty Type;
+		typedef SparseSetColumnsT<MaxHandlesT, Ty, ComponentsT...> ColumnsT;
+	};
+
+	///
+	template <uint32_t IndexT, uint16_t MaxHandlesT, typename Ty, typename... ComponentsT>
+	struct SparseSetColumnAtT<IndexT, SparseSetColumnsT<MaxHandlesT, Ty, ComponentsT...> >
+		: public SparseSetColumnAtT<IndexT-1, SparseSetColumnsT<MaxHandlesT, ComponentsT...> >
+	{
+	};
+
+	/// Sparse set with components stored in structure-of-arrays layout. Components of live
+	/// handles are kept packed in the same order as handles in `HandleAlloc` dense array, so
+	/// systems can iterate linearly over `getData<IndexT>()` arrays. Freeing handle moves last
+	/// element into freed slot.
+	///
+	/// @remark Components must be default constructible and copy assignable.
+	///
+	template <uint16_t MaxHandlesT, typename... ComponentsT>
+	class SparseSetT
+	{
+		typedef SparseSetColumnsT<MaxHandlesT, ComponentsT...> ColumnsT;
+
+	public:
+		///
+		template <uint32_t IndexT>
+		using ComponentT = typename SparseSetColumnAtT<IndexT, ColumnsT>::Type;
+
+		///
+		SparseSetT();
+
+		///
+		~SparseSetT();
+
+		///
+		const uint16_t* getHandles() const;
+
+		///
+		uint16_t getNumHandles() const;
+
+		///
+		uint16_t getMaxHandles() const;
+
+		/// Allocates handle, and resets its components to default value.
+		uint16_t alloc();
+
+		///
+		bool isValid(uint16_t _handle) const;
+
+		/// Frees handle, last element is moved into freed slot.
+		void free(uint16_t _handle);
+
+		///
+		void reset();
+
+		/// Returns packed array of component `IndexT`, with `getNumHandles` elements.
+		template <uint32_t IndexT>
+		ComponentT<IndexT>* getData();
+
+		///
+		template <uint32_t IndexT>
+		const ComponentT<IndexT>* getData() const;
+
+		/// Returns component `IndexT` of handle.
+		template <uint32_t IndexT>
+		ComponentT<IndexT>& get(uint16_t _handle);
+
+		///
+		template <uint32_t IndexT>
+		const ComponentT<IndexT>& get(uint16_t _handle) const;
+
+	private:
+		HandleAllocT<MaxHandlesT> m_handleAlloc;
+		ColumnsT m_columns;
+	};
+
+	/// Thread safe handle allocator. Free handles are kept in lock-free free list, and handle
+	/// state is kept per handle, so that `isValid` is wait-free.
+	///
+	/// @remark Unlike `HandleAlloc`, allocated handles are not kept in dense array, and can't be
+	///   iterated.
+	///
+	template <uint16_t MaxHandlesT>
+	class ConcurrentHandleAllocT
+	{
+		BX_CLASS(ConcurrentHandleAllocT
+			, NO_COPY
+			);
+
+	public:
+		///
+		ConcurrentHandleAllocT();
+
+		///
+		~ConcurrentHandleAllocT();
+
+		///
+		uint16_t getNumHandles() const;
+
+		///
+		uint16_t getMaxHandles() const;
+
+		///
+		uint16_t alloc();
+
+		///
+		bool isValid(uint16_t _handle) const;
+
+		///
+		void free(uint16_t _handle);
+
+		/// Free all handles.
+		///
+		/// @remark Not thread safe.
+		///
+		void reset();
+
+	private:
+		volatile uint16_t m_next[MaxHandlesT];
+		volatile uint8_t  m_alive[MaxHandlesT];
+		volatile int32_t  m_numHandles;
+
+		BX_ALIGN_DECL_CACHE_LINE(volatile uint64_t) m_head;
+	};
+
+	/// 32-bit generational handle allocator. Handle is made of index, in lower `kIndexBits`
+	/// bits, and generation, in upper bits. Generation is incremented each time handle is freed,
+	/// so stale handles are detected by `isValid` without any lookup table.
+	///
+	class HandleAlloc32
+	{
+	public:
+		static constexpr uint32_t kIndexBits      = 20;
+		static constexpr uint32_t kIndexMask      = (UINT32_C(1)<<kIndexBits)-1;
+		static constexpr uint32_t kGenerationMask = UINT32_MAX>>kIndexBits;
+		static constexpr uint32_t kMaxHandles     = UINT32_C(1)<<kIndexBits;
+
+		///
+		HandleAlloc32(uint32_t _maxHandles);
+
+		///
+		~HandleAlloc32();
+
+		///
+		const uint32_t* getHandles() const;
+
+		///
+		uint32_t getHandleAt(uint32_t _at) const;
+
+		///
+		uint32_t getNumHandles() const;
+
+		///
+		uint32_t getMaxHandles() const;
+
+		///
+		uint32_t alloc();
+
+		///
+		bool isValid(uint32_t _handle) const;
+
+		///
+		void free(uint32_t _handle);
+
+		/// Free all handles. Generation of each freed handle is incremented.
+		void reset();
+
+		/// Returns index part of handle, in range [0, max handles).
+		static uint32_t getIndex(uint32_t _handle);
+
+		/// Returns generation part of handle.
+		static uint32_t getGeneration(uint32_t _handle);
+
+	private:
+		HandleAlloc32();
+
+		///
+		static uint32_t nextGeneration(uint32_t _handle);
+
+		///
+		uint32_t* getDensePtr() const;
+
+		///
+		uint32_t* getSparsePtr() const;
+
+		uint32_t m_numHandles;
+		uint32_t m_maxHandles;
+	};
+
+	///
+	HandleAlloc32* createHandleAlloc32(AllocatorI* _allocator, uint32_t _maxHandles);
+
+	///
+	void destroyHandleAlloc32(AllocatorI* _allocator, HandleAlloc32* _handleAlloc);
+
+	///
+	template <uint32_t MaxHandlesT>
+	class HandleAlloc32T : public HandleAlloc32
+	{
+	public:
+		///
+		HandleAlloc32T();
+
+		///
+		~HandleAlloc32T();
+
+	private:
+		uint32_t m_padding[2*MaxHandlesT];
+	};
+
 	///
 	template <uint16_t MaxHandlesT>
 	class HandleListT
@@ -117,10 +367,19 @@ namespace bx
 		///
 		void remove(uint16_t _handle);
 
+		/// Move handles to front, same as calling `remove` and `pushFront` for each handle in
+		/// order, but each distinct handle is unlinked once, and moved handles are linked to
+		/// front as single run. Handles that are not in list are skipped.
+		///
+		void moveToFront(const uint16_t* _handles, uint32_t _num);
+
 		///
 		void reset();
 
 	private:
+		/// Returns true if handle is in list.
+		bool isLinked(uint16_t _handle) const;
+
 		///
 		void insertBefore(uint16_t _before, uint16_t _handle);
 
@@ -180,6 +439,12 @@ namespace bx
 		///
 		void touch(uint16_t _handle);
 
+		/// Touch multiple handles, equivalent to calling `touch` for each handle in order.
+		/// Handles that are already at front are not relinked, and handles that are not valid
+		/// anymore (freed since they were recorded) are skipped.
+		///
+		void touch(const uint16_t* _handles, uint32_t _num);
+
 		///
 		uint16_t getFront() const;
 
@@ -200,8 +465,71 @@ namespace bx
 		HandleAllocT<MaxHandlesT> m_alloc;
 	};
 
+	/// Handle allocator with CLOCK (second-chance) approximation of LRU. Touch only sets
+	/// reference bit, and handles are swept lazily when looking for eviction victim.
+	///
+	template <uint16_t MaxHandlesT>
+	class HandleAllocClockT
+	{
+	public:
+		///
+		HandleAllocClockT();
+
+		///
+		~HandleAllocClockT();
+
+		///
+		const uint16_t* getHandles() const;
+
+		///
+		uint16_t getHandleAt(uint16_t _at) const;
+
+		///
+		uint16_t getNumHandles() const;
+
+		///
+		uint16_t getMaxHandles() const;
+
+		///
+		uint16_t alloc();
+
+		///
+		bool isValid(uint16_t _handle) const;
+
+		///
+		void free(uint16_t _handle);
+
+		///
+		void touch(uint16_t _handle);
+
+		/// Touch multiple handles. Handles that are not valid anymore are skipped.
+		void touch(const uint16_t* _handles, uint32_t _num);
+
+		/// Returns least recently used handle approximation. Clock hand advances over handles,
+		/// clearing reference bits, until it finds handle that was not referenced.
+		///
+		/// @remark Handle is not freed.
+		///
+		uint16_t getVictim();
+
+		///
+		void reset();
+
+	private:
+		HandleAllocT<MaxHandlesT> m_alloc;
+		uint8_t  m_referenced[MaxHandlesT];
+		uint16_t m_hand;
+	};
+
+	/// Hash map of keys to handles, with open addressing and linear probing.
+	///
+	/// @tparam MaxCapacityT Number of slots in hash table.
+	/// @tparam KeyT Key type.
+	/// @tparam MaxHandlesT When not zero, handle to slot reverse index is kept for handles in
+	///   range [0, MaxHandlesT), and `removeByHandle` becomes O(1) instead of scanning all slots.
+	///   With reverse index each handle must be inserted with single key only.
 	///
-	template <uint32_t MaxCapacityT, typename KeyT = uint32_t>
+	template <uint32_t MaxCapacityT, typename KeyT = uint32_t, uint32_t MaxHandlesT = 0>
 	class HandleHashMapT
 	{
 	public:
@@ -238,15 +566,15 @@ namespace bx
 			uint16_t handle;
 
 		private:
-			friend class HandleHashMapT<MaxCapacityT, KeyT>;
+			friend class HandleHashMapT<MaxCapacityT, KeyT, MaxHandlesT>;
 			uint32_t pos;
 			uint32_t num;
 		};
 
-		///
+		/// Returns iterator positioned before first element.
 		Iterator first() const;
 
-		///
+		/// Advances iterator to next element, returns false when there are no more elements.
 		bool next(Iterator& _it) const;
 
 	private:
@@ -256,6 +584,9 @@ namespace bx
 		///
 		void removeIndex(uint32_t _idx);
 
+		///
+		void setSlot(uint16_t _handle, uint32_t _idx);
+
 		///
 		uint32_t mix(uint32_t _x) const;
 
@@ -267,6 +598,99 @@ namespace bx
 
 		KeyT     m_key[MaxCapacityT];
 		uint16_t m_handle[MaxCapacityT];
+		uint32_t m_slot[0 == MaxHandlesT ? 1 : MaxHandlesT];
+	};
+
+	/// Growable hash map of keys to handles, with runtime power of two capacity. Slots are
+	/// organized in groups of 8, and each slot has control byte holding 7 bits of key hash.
+	/// Lookup compares all control bytes of group at once, and only compares keys of slots with
+	/// matching hash bits.
+	///
+	template <typename KeyT = uint32_t>
+	class GrowableHandleHashMapT
+	{
+		BX_CLASS(GrowableHandleHashMapT
+			, NO_DEFAULT_CTOR
+			, NO_COPY
+			);
+
+	public:
+		///
+		GrowableHandleHashMapT(AllocatorI* _allocator, uint32_t _capacity = 0);
+
+		///
+		~GrowableHandleHashMapT();
+
+		///
+		bool insert(KeyT _key, uint16_t _handle);
+
+		///
+		bool removeByKey(KeyT _key);
+
+		///
+		bool removeByHandle(uint16_t _handle);
+
+		///
+		uint16_t find(KeyT _key) const;
+
+		/// Grow capacity so that `_num` elements can be inserted without rehashing.
+		bool reserve(uint32_t _num);
+
+		///
+		void reset();
+
+		///
+		uint32_t getNumElements() const;
+
+		///
+		uint32_t getMaxCapacity() const;
+
+		///
+		struct Iterator
+		{
+			uint16_t handle;
+
+		private:
+			friend class GrowableHandleHashMapT<KeyT>;
+			uint32_t pos;
+			uint32_t num;
+		};
+
+		/// Returns iterator positioned before first element.
+		Iterator first() const;
+
+		/// Advances iterator to next element, returns false when there are no more elements.
+		bool next(Iterator& _it) const;
+
+	private:
+		///
+		uint32_t findIndex(KeyT _key) const;
+
+		///
+		uint32_t findInsertIndex(uint32_t _hash) const;
+
+		///
+		void removeIndex(uint32_t _idx);
+
+		///
+		bool rehash(uint32_t _capacity);
+
+		///
+		uint64_t loadGroup(uint32_t _group) const;
+
+		///
+		uint32_t mix(uint32_t _x) const;
+
+		///
+		uint32_t mix(uint64_t _x) const;
+
+		AllocatorI* m_allocator;
+		uint8_t*    m_ctrl;
+		KeyT*       m_key;
+		uint16_t*   m_handle;
+		uint32_t    m_capacity;
+		uint32_t    m_numElements;
+		uint32_t    m_numDeleted;
 	};
 
 	///
@@ -311,7 +735,7 @@ namespace bx
 		void reset();
 
 	private:
-		HandleHashMapT<MaxHandlesT+MaxHandlesT/2, KeyT> m_table;
+		HandleHashMapT<MaxHandlesT+MaxHandlesT/2, KeyT, MaxHandlesT> m_table;
 		HandleAllocT<MaxHandlesT> m_alloc;
 	};
 
@@ -95,6 +95,39 @@ namespace bx
 		return newAligned;
 	}
 
+	inline LinearAllocatorScope::LinearAllocatorScope(LinearAllocator& _allocator)
+		: m_allocator(_allocator)
+		, m_marker(_allocator.getMarker() )
+	{
+	}
+
+	inline LinearAllocatorScope::~LinearAllocatorScope()
+	{
+		m_allocator.rewind(m_marker);
+	}
+
+	template <uint32_t BlockSizeT, uint32_t BlocksPerSlabT>
+	inline PoolAllocatorT<BlockSizeT, BlocksPerSlabT>::PoolAllocatorT(AllocatorI* _allocator)
+		: PoolAllocator(_allocator, BlockSizeT, BlocksPerSlabT)
+	{
+	}
+
+	template <uint32_t BlockSizeT, uint32_t BlocksPerSlabT>
+	inline PoolAllocatorT<BlockSizeT, BlocksPerSlabT>::~PoolAllocatorT()
+	{
+	}
+
+	template <uint32_t BlockSizeT, uint32_t BlocksPerSlabT>
+	inline ConcurrentPoolAllocatorT<BlockSizeT, BlocksPerSlabT>::ConcurrentPoolAllocatorT(AllocatorI* _allocator)
+		: ConcurrentPoolAllocator(_allocator, BlockSizeT, BlocksPerSlabT)
+	{
+	}
+
+	template <uint32_t BlockSizeT, uint32_t BlocksPerSlabT>
+	inline ConcurrentPoolAllocatorT<BlockSizeT, BlocksPerSlabT>::~ConcurrentPoolAllocatorT()
+	{
+	}
+
 	template <typename ObjectT>
 	inline void deleteObject(AllocatorI* _allocator, ObjectT* _object, size_t _align, const char* _file, uint32_t _line)
 	{
@@ -105,6 +105,21 @@ namespace bx
 #endif // BX_COMPILER_MSVC
 	}
 
+	inline void spinPause()
+	{
+#if BX_CPU_X86
+#	if BX_COMPILER_MSVC
+		_mm_pause();
+#	else
+		__builtin_ia32_pause();
+#	endif // BX_COMPILER_MSVC
+#elif BX_CPU_ARM && !BX_COMPILER_MSVC
+		asm volatile("yield":::"memory");
+#else
+		readWriteBarrier();
+#endif // BX_CPU_*
+	}
+
 	template<>
 	inline int32_t atomicCompareAndSwap<int32_t>(volatile int32_t* _ptr, int32_t _old, int32_t _new)
 	{
@@ -355,4 +370,68 @@ namespace bx
 #endif // BX_COMPILER_*
 	}
 
+	template<typename Ty>
+	inline Ty atomicLoad(const volatile Ty* _ptr)
+	{
+#if BX_COMPILER_MSVC
+		const Ty result = *_ptr;
+#	if BX_CPU_X86
+		_ReadWriteBarrier();
+#	else
+		MemoryBarrier();
+#	endif // BX_CPU_X86
+		return result;
+#else
+		return __atomic_load_n(_ptr, __ATOMIC_ACQUIRE);
+#endif // BX_COMPILER_*
+	}
+
+	template<typename Ty>
+	inline void atomicStore(volatile Ty* _ptr, Ty _value)
+	{
+#if BX_COMPILER_MSVC
+#	if BX_CPU_X86
+		_ReadWriteBarrier();
+#	else
+		MemoryBarrier();
+#	endif // BX_CPU_X86
+		*_ptr = _value;
+#else
+		__atomic_store_n(_ptr, _value, __ATOMIC_RELEASE);
+#endif // BX_COMPILER_*
+	}
+
+#if BX_COMPILER_MSVC && BX_ARCH_32BIT
+	template<>
+	inline int64_t atomicLoad<int64_t>(const volatile int64_t* _ptr)
+	{
+		return atomicCompareAndSwap<int64_t>(const_cast<volatile int64_t*>(_ptr), 0, 0);
+	}
+
+	template<>
+	inline uint64_t atomicLoad<uint64_t>(const volatile uint64_t* _ptr)
+	{
+		return atomicCompareAndSwap<uint64_t>(const_cast<volatile uint64_t*>(_ptr), 0, 0);
+	}
+
+	template<>
+	inline void atomicStore<int64_t>(volatile int64_t* _ptr, int64_t _value)
+	{
+		int64_t oldVal;
+		int64_t newVal = *_ptr;
+		do
+		{
+			oldVal = newVal;
+			newVal = atomicCompareAndSwap<int64_t>(_ptr, oldVal, _value);
+
+		} while (oldVal != newVal);
+	}
+
+	template<>
+	inline void atomicStore<uint64_t>(volatile uint64_t* _ptr, uint64_t _value)
+	{
+		atomicStore<int64_t>( (volatile int64_t*)_ptr, int64_t(_value) );
+	}
+#endif // BX_COMPILER_MSVC && BX_ARCH_32BIT
+
 } // namespace bx
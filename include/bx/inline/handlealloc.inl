@@ -68,6 +68,11 @@ namespace bx
 			;
 	}
 
+	inline uint16_t HandleAlloc::getIndex(uint16_t _handle) const
+	{
+		return getSparsePtr()[_handle];
+	}
+
 	inline void HandleAlloc::free(uint16_t _handle)
 	{
 		uint16_t* dense  = getDensePtr();
@@ -124,6 +129,385 @@ namespace bx
 	{
 	}
 
+	template <uint16_t MaxHandlesT, typename... ComponentsT>
+	inline void SparseSetColumnsT<MaxHandlesT, ComponentsT...>::move(uint16_t _dst, uint16_t _src)
+	{
+		BX_UNUSED(_dst, _src);
+	}
+
+	template <uint16_t MaxHandlesT, typename... ComponentsT>
+	inline void SparseSetColumnsT<MaxHandlesT, ComponentsT...>::clear(uint16_t _index)
+	{
+		BX_UNUSED(_index);
+	}
+
+	template <uint16_t MaxHandlesT, typename Ty, typename... ComponentsT>
+	inline void SparseSetColumnsT<MaxHandlesT, Ty, ComponentsT...>::move(uint16_t _dst, uint16_t _src)
+	{
+		m_data[_dst] = m_data[_src];
+		BaseT::move(_dst, _src);
+	}
+
+	template <uint16_t MaxHandlesT, typename Ty, typename... ComponentsT>
+	inline void SparseSetColumnsT<MaxHandlesT, Ty, ComponentsT...>::clear(uint16_t _index)
+	{
+		m_data[_index] = Ty();
+		BaseT::clear(_index);
+	}
+
+	template <uint16_t MaxHandlesT, typename... ComponentsT>
+	inline SparseSetT<MaxHandlesT, ComponentsT...>::SparseSetT()
+	{
+	}
+
+	template <uint16_t MaxHandlesT, typename... ComponentsT>
+	inline SparseSetT<MaxHandlesT, ComponentsT...>::~SparseSetT()
+	{
+	}
+
+	template <uint16_t MaxHandlesT, typename... ComponentsT>
+	inline const uint16_t* SparseSetT<MaxHandlesT, ComponentsT...>::getHandles() const
+	{
+		return m_handleAlloc.getHandles();
+	}
+
+	template <uint16_t MaxHandlesT, typename... ComponentsT>
+	inline uint16_t SparseSetT<MaxHandlesT, ComponentsT...>::getNumHandles() const
+	{
+		return m_handleAlloc.getNumHandles();
+	}
+
+	template <uint16_t MaxHandlesT, typename... ComponentsT>
+	inline uint16_t SparseSetT<MaxHandlesT, ComponentsT...>::getMaxHandles() const
+	{
+		return MaxHandlesT;
+	}
+
+	template <uint16_t MaxHandlesT, typename... ComponentsT>
+	inline uint16_t SparseSetT<MaxHandlesT, ComponentsT...>::alloc()
+	{
+		const uint16_t handle = m_handleAlloc.alloc();
+
+		if (kInvalidHandle != handle)
+		{
+			m_columns.clear(m_handleAlloc.getIndex(handle) );
+		}
+
+		return handle;
+	}
+
+	template <uint16_t MaxHandlesT, typename... ComponentsT>
+	inline bool SparseSetT<MaxHandlesT, ComponentsT...>::isValid(uint16_t _handle) const
+	{
+		return m_handleAlloc.isValid(_handle);
+	}
+
+	template <uint16_t MaxHandlesT, typename... ComponentsT>
+	inline void SparseSetT<MaxHandlesT, ComponentsT...>::free(uint16_t _handle)
+	{
+		BX_ASSERT(isValid(_handle), "SparseSetT: Freeing invalid handle %d.", _handle);
+
+		const uint16_t index = m_handleAlloc.getIndex(_handle);
+		const uint16_t last  = m_handleAlloc.getNumHandles() - 1;
+
+		if (index != last)
+		{
+			m_columns.move(index, last);
+		}
+
+		m_handleAlloc.free(_handle);
+	}
+
+	template <uint16_t MaxHandlesT, typename... ComponentsT>
+	inline void SparseSetT<MaxHandlesT, ComponentsT...>::reset()
+	{
+		m_handleAlloc.reset();
+	}
+
+	template <uint16_t MaxHandlesT, typename... ComponentsT>
+	template <uint32_t IndexT>
+	inline typename SparseSetT<MaxHandlesT, ComponentsT...>::template ComponentT<IndexT>* SparseSetT<MaxHandlesT, ComponentsT...>::getData()
+	{
+		typedef typename SparseSetColumnAtT<IndexT, ColumnsT>::ColumnsT ColumnT;
+		return static_cast<ColumnT&>(m_columns).m_data;
+	}
+
+	template <uint16_t MaxHandlesT, typename... ComponentsT>
+	template <uint32_t IndexT>
+	inline const typename SparseSetT<MaxHandlesT, ComponentsT...>::template ComponentT<IndexT>* SparseSetT<MaxHandlesT, ComponentsT...>::getData() const
+	{
+		typedef typename SparseSetColumnAtT<IndexT, ColumnsT>::ColumnsT ColumnT;
+		return static_cast<const ColumnT&>(m_columns).m_data;
+	}
+
+	template <uint16_t MaxHandlesT, typename... ComponentsT>
+	template <uint32_t IndexT>
+	inline typename SparseSetT<MaxHandlesT, ComponentsT...>::template ComponentT<IndexT>& SparseSetT<MaxHandlesT, ComponentsT...>::get(uint16_t _handle)
+	{
+		BX_ASSERT(isValid(_handle), "SparseSetT: Invalid handle %d.", _handle);
+		return getData<IndexT>()[m_handleAlloc.getIndex(_handle)];
+	}
+
+	template <uint16_t MaxHandlesT, typename... ComponentsT>
+	template <uint32_t IndexT>
+	inline const typename SparseSetT<MaxHandlesT, ComponentsT...>::template ComponentT<IndexT>& SparseSetT<MaxHandlesT, ComponentsT...>::get(uint16_t _handle) const
+	{
+		BX_ASSERT(isValid(_handle), "SparseSetT: Invalid handle %d.", _handle);
+		return getData<IndexT>()[m_handleAlloc.getIndex(_handle)];
+	}
+
+	static constexpr uint64_t kHandleFreeListTagInc  = UINT64_C(1)<<32;
+	static constexpr uint64_t kHandleFreeListTagMask = ~(kHandleFreeListTagInc-1);
+
+	template <uint16_t MaxHandlesT>
+	inline ConcurrentHandleAllocT<MaxHandlesT>::ConcurrentHandleAllocT()
+	{
+		reset();
+	}
+
+	template <uint16_t MaxHandlesT>
+	inline ConcurrentHandleAllocT<MaxHandlesT>::~ConcurrentHandleAllocT()
+	{
+	}
+
+	template <uint16_t MaxHandlesT>
+	inline uint16_t ConcurrentHandleAllocT<MaxHandlesT>::getNumHandles() const
+	{
+		return uint16_t(atomicLoad(&m_numHandles) );
+	}
+
+	template <uint16_t MaxHandlesT>
+	inline uint16_t ConcurrentHandleAllocT<MaxHandlesT>::getMaxHandles() const
+	{
+		return MaxHandlesT;
+	}
+
+	template <uint16_t MaxHandlesT>
+	inline uint16_t ConcurrentHandleAllocT<MaxHandlesT>::alloc()
+	{
+		// Free list head is tagged with counter that's incremented on each change, so that
+		// compare-and-swap fails if head was popped and pushed back in the meantime (ABA).
+		uint64_t head = atomicLoad(&m_head);
+
+		for (;;)
+		{
+			const uint16_t handle = uint16_t(head);
+
+			if (kInvalidHandle == handle)
+			{
+				return kInvalidHandle;
+			}
+
+			const uint64_t next = atomicLoad(&m_next[handle]);
+			const uint64_t oldHead = head;
+			head = atomicCompareAndSwap<uint64_t>(&m_head, oldHead, ( (oldHead & kHandleFreeListTagMask) + kHandleFreeListTagInc) | next);
+
+			if (head == oldHead)
+			{
+				atomicStore<uint8_t>(&m_alive[handle], 1);
+				atomicFetchAndAdd<int32_t>(&m_numHandles, 1);
+				return handle;
+			}
+		}
+	}
+
+	template <uint16_t MaxHandlesT>
+	inline bool ConcurrentHandleAllocT<MaxHandlesT>::isValid(uint16_t _handle) const
+	{
+		return _handle < MaxHandlesT
+			&& 0 != atomicLoad(&m_alive[_handle])
+			;
+	}
+
+	template <uint16_t MaxHandlesT>
+	inline void ConcurrentHandleAllocT<MaxHandlesT>::free(uint16_t _handle)
+	{
+		BX_ASSERT(isValid(_handle), "ConcurrentHandleAllocT: Freeing invalid handle %d.", _handle);
+
+		atomicStore<uint8_t>(&m_alive[_handle], 0);
+		atomicFetchAndSub<int32_t>(&m_numHandles, 1);
+
+		uint64_t head = atomicLoad(&m_head);
+
+		for (;;)
+		{
+			atomicStore<uint16_t>(&m_next[_handle], uint16_t(head) );
+
+			const uint64_t oldHead = head;
+			head = atomicCompareAndSwap<uint64_t>(&m_head, oldHead, ( (oldHead & kHandleFreeListTagMask) + kHandleFreeListTagInc) | _handle);
+
+			if (head == oldHead)
+			{
+				return;
+			}
+		}
+	}
+
+	template <uint16_t MaxHandlesT>
+	inline void ConcurrentHandleAllocT<MaxHandlesT>::reset()
+	{
+		for (uint16_t ii = 0; ii < MaxHandlesT; ++ii)
+		{
+			m_next[ii]  = ii+1 < MaxHandlesT ? uint16_t(ii+1) : kInvalidHandle;
+			m_alive[ii] = 0;
+		}
+
+		m_numHandles = 0;
+		m_head       = 0 < MaxHandlesT ? 0 : kInvalidHandle;
+	}
+
+	inline HandleAlloc32::HandleAlloc32(uint32_t _maxHandles)
+		: m_numHandles(0)
+		, m_maxHandles(_maxHandles)
+	{
+		BX_ASSERT(_maxHandles <= kMaxHandles, "HandleAlloc32: Max handles %d is above limit %d.", _maxHandles, kMaxHandles);
+
+		uint32_t* dense  = getDensePtr();
+		uint32_t* sparse = getSparsePtr();
+		for (uint32_t ii = 0, num = m_maxHandles; ii < num; ++ii)
+		{
+			dense[ii]  = ii;
+			sparse[ii] = ii;
+		}
+	}
+
+	inline HandleAlloc32::~HandleAlloc32()
+	{
+	}
+
+	inline const uint32_t* HandleAlloc32::getHandles() const
+	{
+		return getDensePtr();
+	}
+
+	inline uint32_t HandleAlloc32::getHandleAt(uint32_t _at) const
+	{
+		return getDensePtr()[_at];
+	}
+
+	inline uint32_t HandleAlloc32::getNumHandles() const
+	{
+		return m_numHandles;
+	}
+
+	inline uint32_t HandleAlloc32::getMaxHandles() const
+	{
+		return m_maxHandles;
+	}
+
+	inline uint32_t HandleAlloc32::alloc()
+	{
+		if (m_numHandles < m_maxHandles)
+		{
+			uint32_t index = m_numHandles;
+			++m_numHandles;
+
+			uint32_t* dense  = getDensePtr();
+			uint32_t  handle = dense[index];
+			uint32_t* sparse = getSparsePtr();
+			sparse[getIndex(handle)] = index;
+			return handle;
+		}
+
+		return kInvalidHandle32;
+	}
+
+	inline bool HandleAlloc32::isValid(uint32_t _handle) const
+	{
+		const uint32_t idx = getIndex(_handle);
+
+		if (idx >= m_maxHandles)
+		{
+			return false;
+		}
+
+		uint32_t* dense  = getDensePtr();
+		uint32_t* sparse = getSparsePtr();
+		uint32_t  index  = sparse[idx];
+
+		return index < m_numHandles
+			&& dense[index] == _handle
+			;
+	}
+
+	inline void HandleAlloc32::free(uint32_t _handle)
+	{
+		BX_ASSERT(isValid(_handle), "HandleAlloc32: Freeing invalid handle %x.", _handle);
+
+		uint32_t* dense  = getDensePtr();
+		uint32_t* sparse = getSparsePtr();
+		uint32_t index = sparse[getIndex(_handle)];
+		--m_numHandles;
+		uint32_t temp = dense[m_numHandles];
+		dense[m_numHandles] = nextGeneration(_handle);
+		sparse[getIndex(temp)]    = index;
+		sparse[getIndex(_handle)] = m_numHandles;
+		dense[index] = temp;
+	}
+
+	inline void HandleAlloc32::reset()
+	{
+		uint32_t* dense = getDensePtr();
+		for (uint32_t ii = 0, num = m_numHandles; ii < num; ++ii)
+		{
+			dense[ii] = nextGeneration(dense[ii]);
+		}
+
+		m_numHandles = 0;
+	}
+
+	inline uint32_t HandleAlloc32::getIndex(uint32_t _handle)
+	{
+		return _handle & kIndexMask;
+	}
+
+	inline uint32_t HandleAlloc32::getGeneration(uint32_t _handle)
+	{
+		return _handle >> kIndexBits;
+	}
+
+	inline uint32_t HandleAlloc32::nextGeneration(uint32_t _handle)
+	{
+		// Generation never reaches all ones, so that kInvalidHandle32 is never valid handle.
+		uint32_t generation = getGeneration(_handle) + 1;
+		generation = generation == kGenerationMask ? 0 : generation;
+		return (generation << kIndexBits) | getIndex(_handle);
+	}
+
+	inline uint32_t* HandleAlloc32::getDensePtr() const
+	{
+		uint8_t* ptr = (uint8_t*)reinterpret_cast<const uint8_t*>(this);
+		return (uint32_t*)&ptr[sizeof(HandleAlloc32)];
+	}
+
+	inline uint32_t* HandleAlloc32::getSparsePtr() const
+	{
+		return &getDensePtr()[m_maxHandles];
+	}
+
+	inline HandleAlloc32* createHandleAlloc32(AllocatorI* _allocator, uint32_t _maxHandles)
+	{
+		uint8_t* ptr = (uint8_t*)BX_ALLOC(_allocator, sizeof(HandleAlloc32) + 2*_maxHandles*sizeof(uint32_t) );
+		return BX_PLACEMENT_NEW(ptr, HandleAlloc32)(_maxHandles);
+	}
+
+	inline void destroyHandleAlloc32(AllocatorI* _allocator, HandleAlloc32* _handleAlloc)
+	{
+		_handleAlloc->~HandleAlloc32();
+		BX_FREE(_allocator, _handleAlloc);
+	}
+
+	template <uint32_t MaxHandlesT>
+	inline HandleAlloc32T<MaxHandlesT>::HandleAlloc32T()
+		: HandleAlloc32(MaxHandlesT)
+	{
+	}
+
+	template <uint32_t MaxHandlesT>
+	inline HandleAlloc32T<MaxHandlesT>::~HandleAlloc32T()
+	{
+	}
+
 	template <uint16_t MaxHandlesT>
 	inline HandleListT<MaxHandlesT>::HandleListT()
 	{
@@ -229,6 +613,67 @@ namespace bx
 		curr.m_next = kInvalidHandle;
 	}
 
+	template <uint16_t MaxHandlesT>
+	inline void HandleListT<MaxHandlesT>::moveToFront(const uint16_t* _handles, uint32_t _num)
+	{
+		// Last occurrence of handle determines its position, so handles are visited from the
+		// last one. Each is unlinked, and appended to detached run. Run is linked only through
+		// next, while previous link points to handle itself, marking it as not in list.
+		uint16_t first = kInvalidHandle;
+		uint16_t last  = kInvalidHandle;
+
+		for (uint32_t ii = _num; 0 < ii; --ii)
+		{
+			const uint16_t handle = _handles[ii-1];
+
+			if (!isLinked(handle) )
+			{
+				continue;
+			}
+
+			remove(handle);
+
+			Link& curr = m_links[handle];
+			curr.m_prev = handle;
+
+			if (kInvalidHandle == last)
+			{
+				first = handle;
+			}
+			else
+			{
+				m_links[last].m_next = handle;
+			}
+
+			last = handle;
+		}
+
+		if (kInvalidHandle == first)
+		{
+			return;
+		}
+
+		uint16_t prev = kInvalidHandle;
+		for (uint16_t handle = first; kInvalidHandle != handle; handle = m_links[handle].m_next)
+		{
+			m_links[handle].m_prev = prev;
+			prev = handle;
+		}
+
+		m_links[last].m_next = m_front;
+
+		if (kInvalidHandle != m_front)
+		{
+			m_links[m_front].m_prev = last;
+		}
+		else
+		{
+			m_back = last;
+		}
+
+		m_front = first;
+	}
+
 	template <uint16_t MaxHandlesT>
 	inline void HandleListT<MaxHandlesT>::reset()
 	{
@@ -282,13 +727,28 @@ namespace bx
 	}
 
 	template <uint16_t MaxHandlesT>
-	inline bool HandleListT<MaxHandlesT>::isValid(uint16_t _handle) const
+	inline bool HandleListT<MaxHandlesT>::isLinked(uint16_t _handle) const
 	{
-		return _handle < MaxHandlesT;
-	}
+		if (!isValid(_handle) )
+		{
+			return false;
+		}
 
-	template <uint16_t MaxHandlesT>
-	inline void HandleListT<MaxHandlesT>::updateFrontBack(uint16_t _handle)
+		const Link& curr = m_links[_handle];
+
+		return _handle != curr.m_prev
+			&& (kInvalidHandle != curr.m_prev || _handle == m_front)
+			;
+	}
+
+	template <uint16_t MaxHandlesT>
+	inline bool HandleListT<MaxHandlesT>::isValid(uint16_t _handle) const
+	{
+		return _handle < MaxHandlesT;
+	}
+
+	template <uint16_t MaxHandlesT>
+	inline void HandleListT<MaxHandlesT>::updateFrontBack(uint16_t _handle)
 	{
 		Link& curr = m_links[_handle];
 
@@ -371,6 +831,13 @@ namespace bx
 		m_list.pushFront(_handle);
 	}
 
+	template <uint16_t MaxHandlesT>
+	inline void HandleAllocLruT<MaxHandlesT>::touch(const uint16_t* _handles, uint32_t _num)
+	{
+		// Allocated handles are always in list, and freed handles are removed from it.
+		m_list.moveToFront(_handles, _num);
+	}
+
 	template <uint16_t MaxHandlesT>
 	inline uint16_t HandleAllocLruT<MaxHandlesT>::getFront() const
 	{
@@ -402,20 +869,137 @@ namespace bx
 		m_alloc.reset();
 	}
 
-	template <uint32_t MaxCapacityT, typename KeyT>
-	inline HandleHashMapT<MaxCapacityT, KeyT>::HandleHashMapT()
+	template <uint16_t MaxHandlesT>
+	inline HandleAllocClockT<MaxHandlesT>::HandleAllocClockT()
+	{
+		reset();
+	}
+
+	template <uint16_t MaxHandlesT>
+	inline HandleAllocClockT<MaxHandlesT>::~HandleAllocClockT()
+	{
+	}
+
+	template <uint16_t MaxHandlesT>
+	inline const uint16_t* HandleAllocClockT<MaxHandlesT>::getHandles() const
+	{
+		return m_alloc.getHandles();
+	}
+
+	template <uint16_t MaxHandlesT>
+	inline uint16_t HandleAllocClockT<MaxHandlesT>::getHandleAt(uint16_t _at) const
+	{
+		return m_alloc.getHandleAt(_at);
+	}
+
+	template <uint16_t MaxHandlesT>
+	inline uint16_t HandleAllocClockT<MaxHandlesT>::getNumHandles() const
+	{
+		return m_alloc.getNumHandles();
+	}
+
+	template <uint16_t MaxHandlesT>
+	inline uint16_t HandleAllocClockT<MaxHandlesT>::getMaxHandles() const
+	{
+		return m_alloc.getMaxHandles();
+	}
+
+	template <uint16_t MaxHandlesT>
+	inline uint16_t HandleAllocClockT<MaxHandlesT>::alloc()
+	{
+		uint16_t handle = m_alloc.alloc();
+		if (kInvalidHandle != handle)
+		{
+			m_referenced[handle] = 1;
+		}
+		return handle;
+	}
+
+	template <uint16_t MaxHandlesT>
+	inline bool HandleAllocClockT<MaxHandlesT>::isValid(uint16_t _handle) const
+	{
+		return m_alloc.isValid(_handle);
+	}
+
+	template <uint16_t MaxHandlesT>
+	inline void HandleAllocClockT<MaxHandlesT>::free(uint16_t _handle)
+	{
+		BX_ASSERT(isValid(_handle), "Invalid handle %d!", _handle);
+		m_referenced[_handle] = 0;
+		m_alloc.free(_handle);
+	}
+
+	template <uint16_t MaxHandlesT>
+	inline void HandleAllocClockT<MaxHandlesT>::touch(uint16_t _handle)
+	{
+		BX_ASSERT(isValid(_handle), "Invalid handle %d!", _handle);
+		m_referenced[_handle] = 1;
+	}
+
+	template <uint16_t MaxHandlesT>
+	inline void HandleAllocClockT<MaxHandlesT>::touch(const uint16_t* _handles, uint32_t _num)
+	{
+		for (uint32_t ii = 0; ii < _num; ++ii)
+		{
+			const uint16_t handle = _handles[ii];
+
+			if (isValid(handle) )
+			{
+				m_referenced[handle] = 1;
+			}
+		}
+	}
+
+	template <uint16_t MaxHandlesT>
+	inline uint16_t HandleAllocClockT<MaxHandlesT>::getVictim()
+	{
+		if (0 == m_alloc.getNumHandles() )
+		{
+			return kInvalidHandle;
+		}
+
+		// At most two full sweeps, first one might only clear reference bits.
+		for (uint32_t ii = 0; ii < 2*MaxHandlesT; ++ii)
+		{
+			const uint16_t handle = m_hand;
+			m_hand = uint16_t( (m_hand + 1) % MaxHandlesT);
+
+			if (m_alloc.isValid(handle) )
+			{
+				if (0 == m_referenced[handle])
+				{
+					return handle;
+				}
+
+				m_referenced[handle] = 0;
+			}
+		}
+
+		return kInvalidHandle;
+	}
+
+	template <uint16_t MaxHandlesT>
+	inline void HandleAllocClockT<MaxHandlesT>::reset()
+	{
+		m_alloc.reset();
+		memSet(m_referenced, 0, sizeof(m_referenced) );
+		m_hand = 0;
+	}
+
+	template <uint32_t MaxCapacityT, typename KeyT, uint32_t MaxHandlesT>
+	inline HandleHashMapT<MaxCapacityT, KeyT, MaxHandlesT>::HandleHashMapT()
 		: m_maxCapacity(MaxCapacityT)
 	{
 		reset();
 	}
 
-	template <uint32_t MaxCapacityT, typename KeyT>
-	inline HandleHashMapT<MaxCapacityT, KeyT>::~HandleHashMapT()
+	template <uint32_t MaxCapacityT, typename KeyT, uint32_t MaxHandlesT>
+	inline HandleHashMapT<MaxCapacityT, KeyT, MaxHandlesT>::~HandleHashMapT()
 	{
 	}
 
-	template <uint32_t MaxCapacityT, typename KeyT>
-	inline bool HandleHashMapT<MaxCapacityT, KeyT>::insert(KeyT _key, uint16_t _handle)
+	template <uint32_t MaxCapacityT, typename KeyT, uint32_t MaxHandlesT>
+	inline bool HandleHashMapT<MaxCapacityT, KeyT, MaxHandlesT>::insert(KeyT _key, uint16_t _handle)
 	{
 		if (kInvalidHandle == _handle)
 		{
@@ -431,6 +1015,7 @@ namespace bx
 			{
 				m_key[idx]    = _key;
 				m_handle[idx] = _handle;
+				setSlot(_handle, idx);
 				++m_numElements;
 				return true;
 			}
@@ -447,8 +1032,8 @@ namespace bx
 		return false;
 	}
 
-	template <uint32_t MaxCapacityT, typename KeyT>
-	inline bool HandleHashMapT<MaxCapacityT, KeyT>::removeByKey(KeyT _key)
+	template <uint32_t MaxCapacityT, typename KeyT, uint32_t MaxHandlesT>
+	inline bool HandleHashMapT<MaxCapacityT, KeyT, MaxHandlesT>::removeByKey(KeyT _key)
 	{
 		uint32_t idx = findIndex(_key);
 		if (UINT32_MAX != idx)
@@ -460,25 +1045,52 @@ namespace bx
 		return false;
 	}
 
-	template <uint32_t MaxCapacityT, typename KeyT>
-	inline bool HandleHashMapT<MaxCapacityT, KeyT>::removeByHandle(uint16_t _handle)
+	template <uint32_t MaxCapacityT, typename KeyT, uint32_t MaxHandlesT>
+	inline bool HandleHashMapT<MaxCapacityT, KeyT, MaxHandlesT>::removeByHandle(uint16_t _handle)
 	{
-		if (kInvalidHandle != _handle)
+		if (kInvalidHandle == _handle)
+		{
+			return false;
+		}
+
+		if (0 != MaxHandlesT)
 		{
-			for (uint32_t idx = 0; idx < MaxCapacityT; ++idx)
+			if (_handle < MaxHandlesT)
 			{
-				if (m_handle[idx] == _handle)
+				const uint32_t idx = m_slot[_handle];
+
+				if (idx < MaxCapacityT
+				&&  m_handle[idx] == _handle)
 				{
 					removeIndex(idx);
+					return true;
 				}
+
+				return false;
 			}
 		}
 
-		return false;
+		bool removed = false;
+
+		for (uint32_t idx = 0; idx < MaxCapacityT;)
+		{
+			if (m_handle[idx] == _handle)
+			{
+				// Removal can shift following entry into this slot, check it again.
+				removeIndex(idx);
+				removed = true;
+			}
+			else
+			{
+				++idx;
+			}
+		}
+
+		return removed;
 	}
 
-	template <uint32_t MaxCapacityT, typename KeyT>
-	inline uint16_t HandleHashMapT<MaxCapacityT, KeyT>::find(KeyT _key) const
+	template <uint32_t MaxCapacityT, typename KeyT, uint32_t MaxHandlesT>
+	inline uint16_t HandleHashMapT<MaxCapacityT, KeyT, MaxHandlesT>::find(KeyT _key) const
 	{
 		uint32_t idx = findIndex(_key);
 		if (UINT32_MAX != idx)
@@ -489,45 +1101,38 @@ namespace bx
 		return kInvalidHandle;
 	}
 
-	template <uint32_t MaxCapacityT, typename KeyT>
-	inline void HandleHashMapT<MaxCapacityT, KeyT>::reset()
+	template <uint32_t MaxCapacityT, typename KeyT, uint32_t MaxHandlesT>
+	inline void HandleHashMapT<MaxCapacityT, KeyT, MaxHandlesT>::reset()
 	{
 		memSet(m_handle, 0xff, sizeof(m_handle) );
+		memSet(m_slot,   0xff, sizeof(m_slot) );
 		m_numElements = 0;
 	}
 
-	template <uint32_t MaxCapacityT, typename KeyT>
-	inline uint32_t HandleHashMapT<MaxCapacityT, KeyT>::getNumElements() const
+	template <uint32_t MaxCapacityT, typename KeyT, uint32_t MaxHandlesT>
+	inline uint32_t HandleHashMapT<MaxCapacityT, KeyT, MaxHandlesT>::getNumElements() const
 	{
 		return m_numElements;
 	}
 
-	template <uint32_t MaxCapacityT, typename KeyT>
-	inline uint32_t HandleHashMapT<MaxCapacityT, KeyT>::getMaxCapacity() const
+	template <uint32_t MaxCapacityT, typename KeyT, uint32_t MaxHandlesT>
+	inline uint32_t HandleHashMapT<MaxCapacityT, KeyT, MaxHandlesT>::getMaxCapacity() const
 	{
 		return m_maxCapacity;
 	}
 
-	template <uint32_t MaxCapacityT, typename KeyT>
-	inline typename HandleHashMapT<MaxCapacityT, KeyT>::Iterator HandleHashMapT<MaxCapacityT, KeyT>::first() const
+	template <uint32_t MaxCapacityT, typename KeyT, uint32_t MaxHandlesT>
+	inline typename HandleHashMapT<MaxCapacityT, KeyT, MaxHandlesT>::Iterator HandleHashMapT<MaxCapacityT, KeyT, MaxHandlesT>::first() const
 	{
 		Iterator it;
 		it.handle = kInvalidHandle;
 		it.pos    = 0;
 		it.num    = m_numElements;
-
-		if (0 == it.num)
-		{
-			return it;
-		}
-
-		++it.num;
-		next(it);
 		return it;
 	}
 
-	template <uint32_t MaxCapacityT, typename KeyT>
-	inline bool HandleHashMapT<MaxCapacityT, KeyT>::next(Iterator& _it) const
+	template <uint32_t MaxCapacityT, typename KeyT, uint32_t MaxHandlesT>
+	inline bool HandleHashMapT<MaxCapacityT, KeyT, MaxHandlesT>::next(Iterator& _it) const
 	{
 		if (0 == _it.num)
 		{
@@ -544,8 +1149,8 @@ namespace bx
 		return true;
 	}
 
-	template <uint32_t MaxCapacityT, typename KeyT>
-	inline uint32_t HandleHashMapT<MaxCapacityT, KeyT>::findIndex(KeyT _key) const
+	template <uint32_t MaxCapacityT, typename KeyT, uint32_t MaxHandlesT>
+	inline uint32_t HandleHashMapT<MaxCapacityT, KeyT, MaxHandlesT>::findIndex(KeyT _key) const
 	{
 		const KeyT hash = mix(_key);
 
@@ -570,32 +1175,392 @@ namespace bx
 		return UINT32_MAX;
 	}
 
-	template <uint32_t MaxCapacityT, typename KeyT>
-	inline void HandleHashMapT<MaxCapacityT, KeyT>::removeIndex(uint32_t _idx)
+	template <uint32_t MaxCapacityT, typename KeyT, uint32_t MaxHandlesT>
+	inline void HandleHashMapT<MaxCapacityT, KeyT, MaxHandlesT>::removeIndex(uint32_t _idx)
 	{
+		setSlot(m_handle[_idx], UINT32_MAX);
 		m_handle[_idx] = kInvalidHandle;
 		--m_numElements;
 
+		// Backward shift deletion. Entries following the hole are moved into it, unless their
+		// home slot lies cyclically between the hole and their current slot.
+		uint32_t hole = _idx;
+
 		for (uint32_t idx = (_idx + 1) % MaxCapacityT
-				; m_handle[idx] != kInvalidHandle
+				; m_handle[idx] != kInvalidHandle && idx != _idx
 				; idx = (idx + 1) % MaxCapacityT)
 		{
-			if (m_handle[idx] != kInvalidHandle)
+			const uint32_t home = uint32_t(mix(m_key[idx]) % MaxCapacityT);
+			const uint32_t dist = (idx + MaxCapacityT - home) % MaxCapacityT;
+
+			if (dist >= (idx + MaxCapacityT - hole) % MaxCapacityT)
 			{
-				const KeyT key = m_key[idx];
-				if (idx != findIndex(key) )
+				m_key[hole]    = m_key[idx];
+				m_handle[hole] = m_handle[idx];
+				setSlot(m_handle[hole], hole);
+				m_handle[idx]  = kInvalidHandle;
+				hole = idx;
+			}
+		}
+	}
+
+	template <uint32_t MaxCapacityT, typename KeyT, uint32_t MaxHandlesT>
+	inline void HandleHashMapT<MaxCapacityT, KeyT, MaxHandlesT>::setSlot(uint16_t _handle, uint32_t _idx)
+	{
+		if (0 != MaxHandlesT
+		&&  _handle < MaxHandlesT)
+		{
+			m_slot[_handle] = _idx;
+		}
+	}
+
+	template <uint32_t MaxCapacityT, typename KeyT, uint32_t MaxHandlesT>
+	inline uint32_t HandleHashMapT<MaxCapacityT, KeyT, MaxHandlesT>::mix(uint32_t _x) const
+	{
+		const uint32_t tmp0   = uint32_mul(_x,   UINT32_C(2246822519) );
+		const uint32_t tmp1   = uint32_rol(tmp0, 13);
+		const uint32_t result = uint32_mul(tmp1, UINT32_C(2654435761) );
+		return result;
+	}
+
+	template <uint32_t MaxCapacityT, typename KeyT, uint32_t MaxHandlesT>
+	inline uint64_t HandleHashMapT<MaxCapacityT, KeyT, MaxHandlesT>::mix(uint64_t _x) const
+	{
+		const uint64_t tmp0   = uint64_mul(_x,   UINT64_C(14029467366897019727) );
+		const uint64_t tmp1   = uint64_rol(tmp0, 31);
+		const uint64_t result = uint64_mul(tmp1, UINT64_C(11400714785074694791) );
+		return result;
+	}
+
+	static constexpr uint8_t  kHashMapCtrlEmpty   = 0x80;
+	static constexpr uint8_t  kHashMapCtrlDeleted = 0xfe;
+	static constexpr uint32_t kHashMapGroupSize   = 8;
+	static constexpr uint64_t kHashMapGroupLsbs   = UINT64_C(0x0101010101010101);
+	static constexpr uint64_t kHashMapGroupMsbs   = UINT64_C(0x8080808080808080);
+
+	/// Returns mask with MSB set in each byte of group that matches `_h2`. It can have false
+	/// positives, but only when there is also true positive in group.
+	inline uint64_t hashMapGroupMatch(uint64_t _group, uint8_t _h2)
+	{
+		const uint64_t xx = _group ^ (kHashMapGroupLsbs * _h2);
+		return (xx - kHashMapGroupLsbs) & ~xx & kHashMapGroupMsbs;
+	}
+
+	inline uint64_t hashMapGroupMatchEmpty(uint64_t _group)
+	{
+		return _group & ~(_group << 6) & kHashMapGroupMsbs;
+	}
+
+	inline uint64_t hashMapGroupMatchEmptyOrDeleted(uint64_t _group)
+	{
+		return _group & ~(_group << 7) & kHashMapGroupMsbs;
+	}
+
+	template <typename KeyT>
+	inline GrowableHandleHashMapT<KeyT>::GrowableHandleHashMapT(AllocatorI* _allocator, uint32_t _capacity)
+		: m_allocator(_allocator)
+		, m_ctrl(NULL)
+		, m_key(NULL)
+		, m_handle(NULL)
+		, m_capacity(0)
+		, m_numElements(0)
+		, m_numDeleted(0)
+	{
+		if (0 != _capacity)
+		{
+			rehash(uint32_nextpow2(max(_capacity, kHashMapGroupSize) ) );
+		}
+	}
+
+	template <typename KeyT>
+	inline GrowableHandleHashMapT<KeyT>::~GrowableHandleHashMapT()
+	{
+		BX_FREE(m_allocator, m_ctrl);
+	}
+
+	template <typename KeyT>
+	inline bool GrowableHandleHashMapT<KeyT>::insert(KeyT _key, uint16_t _handle)
+	{
+		if (kInvalidHandle == _handle
+		||  UINT32_MAX != findIndex(_key) )
+		{
+			return false;
+		}
+
+		// Keep load factor, including deleted slots, at or below 7/8. When most of load is
+		// deleted slots, table is rehashed at the same size to clean them up.
+		if ( (m_numElements + m_numDeleted + 1) * 8 > m_capacity * 7)
+		{
+			const uint32_t capacity = (m_numElements + 1) * 16 > m_capacity * 7
+				? max(m_capacity * 2, kHashMapGroupSize)
+				: m_capacity
+				;
+
+			if (!rehash(capacity) )
+			{
+				return false;
+			}
+		}
+
+		const uint32_t hash = mix(_key);
+		const uint32_t idx  = findInsertIndex(hash);
+
+		if (kHashMapCtrlDeleted == m_ctrl[idx])
+		{
+			--m_numDeleted;
+		}
+
+		m_ctrl[idx]    = uint8_t(hash & 0x7f);
+		m_key[idx]     = _key;
+		m_handle[idx]  = _handle;
+		++m_numElements;
+
+		return true;
+	}
+
+	template <typename KeyT>
+	inline bool GrowableHandleHashMapT<KeyT>::removeByKey(KeyT _key)
+	{
+		const uint32_t idx = findIndex(_key);
+
+		if (UINT32_MAX != idx)
+		{
+			removeIndex(idx);
+			return true;
+		}
+
+		return false;
+	}
+
+	template <typename KeyT>
+	inline bool GrowableHandleHashMapT<KeyT>::removeByHandle(uint16_t _handle)
+	{
+		if (kInvalidHandle == _handle)
+		{
+			return false;
+		}
+
+		bool removed = false;
+
+		for (uint32_t idx = 0; idx < m_capacity; ++idx)
+		{
+			if (0 == (m_ctrl[idx] & 0x80)
+			&&  m_handle[idx] == _handle)
+			{
+				removeIndex(idx);
+				removed = true;
+			}
+		}
+
+		return removed;
+	}
+
+	template <typename KeyT>
+	inline uint16_t GrowableHandleHashMapT<KeyT>::find(KeyT _key) const
+	{
+		const uint32_t idx = findIndex(_key);
+
+		if (UINT32_MAX != idx)
+		{
+			return m_handle[idx];
+		}
+
+		return kInvalidHandle;
+	}
+
+	template <typename KeyT>
+	inline bool GrowableHandleHashMapT<KeyT>::reserve(uint32_t _num)
+	{
+		const uint32_t capacity = uint32_nextpow2(max( (_num * 8 + 6) / 7, kHashMapGroupSize) );
+
+		if (capacity > m_capacity)
+		{
+			return rehash(capacity);
+		}
+
+		return true;
+	}
+
+	template <typename KeyT>
+	inline void GrowableHandleHashMapT<KeyT>::reset()
+	{
+		if (0 != m_capacity)
+		{
+			memSet(m_ctrl, kHashMapCtrlEmpty, m_capacity);
+		}
+
+		m_numElements = 0;
+		m_numDeleted  = 0;
+	}
+
+	template <typename KeyT>
+	inline uint32_t GrowableHandleHashMapT<KeyT>::getNumElements() const
+	{
+		return m_numElements;
+	}
+
+	template <typename KeyT>
+	inline uint32_t GrowableHandleHashMapT<KeyT>::getMaxCapacity() const
+	{
+		return m_capacity;
+	}
+
+	template <typename KeyT>
+	inline typename GrowableHandleHashMapT<KeyT>::Iterator GrowableHandleHashMapT<KeyT>::first() const
+	{
+		Iterator it;
+		it.handle = kInvalidHandle;
+		it.pos    = 0;
+		it.num    = m_numElements;
+		return it;
+	}
+
+	template <typename KeyT>
+	inline bool GrowableHandleHashMapT<KeyT>::next(Iterator& _it) const
+	{
+		if (0 == _it.num)
+		{
+			return false;
+		}
+
+		for (
+			;_it.pos < m_capacity && 0 != (m_ctrl[_it.pos] & 0x80)
+			; ++_it.pos
+			);
+		_it.handle = m_handle[_it.pos];
+		++_it.pos;
+		--_it.num;
+		return true;
+	}
+
+	template <typename KeyT>
+	inline uint32_t GrowableHandleHashMapT<KeyT>::findIndex(KeyT _key) const
+	{
+		if (0 == m_capacity)
+		{
+			return UINT32_MAX;
+		}
+
+		const uint32_t hash      = mix(_key);
+		const uint8_t  h2        = uint8_t(hash & 0x7f);
+		const uint32_t groupMask = m_capacity / kHashMapGroupSize - 1;
+
+		// Triangular probing visits each group once, when number of groups is power of two.
+		for (uint32_t ii = 0, group = (hash >> 7) & groupMask; ii <= groupMask; ++ii, group = (group + ii) & groupMask)
+		{
+			const uint64_t ctrl = loadGroup(group);
+
+			for (uint64_t match = hashMapGroupMatch(ctrl, h2); 0 != match; match &= match - 1)
+			{
+				const uint32_t idx = group * kHashMapGroupSize + uint64_cnttz(match) / 8;
+
+				if (m_ctrl[idx] == h2
+				&&  m_key[idx]  == _key)
 				{
-					const uint16_t handle = m_handle[idx];
-					m_handle[idx] = kInvalidHandle;
-					--m_numElements;
-					insert(key, handle);
+					return idx;
 				}
 			}
+
+			if (0 != hashMapGroupMatchEmpty(ctrl) )
+			{
+				break;
+			}
 		}
+
+		return UINT32_MAX;
 	}
 
-	template <uint32_t MaxCapacityT, typename KeyT>
-	inline uint32_t HandleHashMapT<MaxCapacityT, KeyT>::mix(uint32_t _x) const
+	template <typename KeyT>
+	inline uint32_t GrowableHandleHashMapT<KeyT>::findInsertIndex(uint32_t _hash) const
+	{
+		const uint32_t groupMask = m_capacity / kHashMapGroupSize - 1;
+
+		for (uint32_t ii = 0, group = (_hash >> 7) & groupMask; ii <= groupMask; ++ii, group = (group + ii) & groupMask)
+		{
+			const uint64_t match = hashMapGroupMatchEmptyOrDeleted(loadGroup(group) );
+
+			if (0 != match)
+			{
+				return group * kHashMapGroupSize + uint64_cnttz(match) / 8;
+			}
+		}
+
+		BX_ASSERT(false, "GrowableHandleHashMapT: Table is full.");
+		return UINT32_MAX;
+	}
+
+	template <typename KeyT>
+	inline void GrowableHandleHashMapT<KeyT>::removeIndex(uint32_t _idx)
+	{
+		// Lookup stops at first group with empty slot, so if group already has one, slot can be
+		// marked as empty, otherwise it must be marked as deleted to keep probe chains intact.
+		const uint32_t group = _idx / kHashMapGroupSize;
+
+		if (0 != hashMapGroupMatchEmpty(loadGroup(group) ) )
+		{
+			m_ctrl[_idx] = kHashMapCtrlEmpty;
+		}
+		else
+		{
+			m_ctrl[_idx] = kHashMapCtrlDeleted;
+			++m_numDeleted;
+		}
+
+		--m_numElements;
+	}
+
+	template <typename KeyT>
+	inline bool GrowableHandleHashMapT<KeyT>::rehash(uint32_t _capacity)
+	{
+		const size_t keyOffset    = alignUp(_capacity, int32_t(alignof(KeyT) ) );
+		const size_t handleOffset = keyOffset + _capacity*sizeof(KeyT);
+		const size_t size         = handleOffset + _capacity*sizeof(uint16_t);
+
+		uint8_t* data = (uint8_t*)BX_ALLOC(m_allocator, size);
+
+		if (NULL == data)
+		{
+			return false;
+		}
+
+		uint8_t*  ctrl   = m_ctrl;
+		KeyT*     key    = m_key;
+		uint16_t* handle = m_handle;
+		uint32_t  num    = m_capacity;
+
+		m_ctrl     = data;
+		m_key      = (KeyT*)&data[keyOffset];
+		m_handle   = (uint16_t*)&data[handleOffset];
+		m_capacity = _capacity;
+		reset();
+
+		for (uint32_t ii = 0; ii < num; ++ii)
+		{
+			if (0 == (ctrl[ii] & 0x80) )
+			{
+				const uint32_t idx = findInsertIndex(mix(key[ii]) );
+				m_ctrl[idx]   = ctrl[ii];
+				m_key[idx]    = key[ii];
+				m_handle[idx] = handle[ii];
+				++m_numElements;
+			}
+		}
+
+		BX_FREE(m_allocator, ctrl);
+
+		return true;
+	}
+
+	template <typename KeyT>
+	inline uint64_t GrowableHandleHashMapT<KeyT>::loadGroup(uint32_t _group) const
+	{
+		uint64_t ctrl;
+		memCopy(&ctrl, &m_ctrl[_group * kHashMapGroupSize], sizeof(ctrl) );
+		return toLittleEndian(ctrl);
+	}
+
+	template <typename KeyT>
+	inline uint32_t GrowableHandleHashMapT<KeyT>::mix(uint32_t _x) const
 	{
 		const uint32_t tmp0   = uint32_mul(_x,   UINT32_C(2246822519) );
 		const uint32_t tmp1   = uint32_rol(tmp0, 13);
@@ -603,13 +1568,13 @@ namespace bx
 		return result;
 	}
 
-	template <uint32_t MaxCapacityT, typename KeyT>
-	inline uint64_t HandleHashMapT<MaxCapacityT, KeyT>::mix(uint64_t _x) const
+	template <typename KeyT>
+	inline uint32_t GrowableHandleHashMapT<KeyT>::mix(uint64_t _x) const
 	{
 		const uint64_t tmp0   = uint64_mul(_x,   UINT64_C(14029467366897019727) );
 		const uint64_t tmp1   = uint64_rol(tmp0, 31);
 		const uint64_t result = uint64_mul(tmp1, UINT64_C(11400714785074694791) );
-		return result;
+		return uint32_t(result >> 32);
 	}
 
 	template <uint16_t MaxHandlesT, typename KeyT>
@@ -0,0 +1,79 @@
+/*
+ * Copyright 2010-2023 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bx/blob/master/LICENSE
+ */
+
+#ifndef BX_JOB_SYSTEM_H_HEADER_GUARD
+#	error "Must be included from bx/jobsystem.h!"
+#endif // BX_JOB_SYSTEM_H_HEADER_GUARD
+
+namespace bx
+{
+	// Upper limit on number of chunks range is split into.
+	static constexpr uint32_t kParallelMaxChunks = 256;
+
+	template<typename FnT>
+	inline void parallelFor(JobSystem* _jobSystem, uint32_t _begin, uint32_t _end, uint32_t _grainSize, const FnT& _fn)
+	{
+		parallelFor(
+			  _jobSystem
+			, _begin
+			, _end
+			, _grainSize
+			, [](uint32_t _chunkBegin, uint32_t _chunkEnd, void* _userData)
+			{
+				const FnT& fn = *(const FnT*)_userData;
+				fn(_chunkBegin, _chunkEnd);
+			}
+			, const_cast<FnT*>(&_fn)
+			);
+	}
+
+	template<typename Ty, typename MapFnT, typename ReduceFnT>
+	inline Ty parallelReduce(
+		  JobSystem* _jobSystem
+		, uint32_t _begin
+		, uint32_t _end
+		, uint32_t _grainSize
+		, const Ty& _identity
+		, const MapFnT& _map
+		, const ReduceFnT& _reduce
+		)
+	{
+		if (_begin >= _end)
+		{
+			return _identity;
+		}
+
+		const uint32_t num       = _end - _begin;
+		const uint32_t chunkSize = calcParallelChunkSize(_jobSystem, num, _grainSize);
+		const uint32_t numChunks = (num + chunkSize - 1) / chunkSize;
+
+		if (1 == numChunks)
+		{
+			return _reduce(_identity, _map(_begin, _end) );
+		}
+
+		Ty partial[kParallelMaxChunks];
+
+		parallelFor(_jobSystem, 0, numChunks, 1
+			, [&](uint32_t _chunkBegin, uint32_t _chunkEnd)
+			{
+				for (uint32_t ii = _chunkBegin; ii < _chunkEnd; ++ii)
+				{
+					const uint32_t begin = _begin + ii*chunkSize;
+					partial[ii] = _map(begin, begin + min(chunkSize, _end - begin) );
+				}
+			});
+
+		Ty result = _identity;
+
+		for (uint32_t ii = 0; ii < numChunks; ++ii)
+		{
+			result = _reduce(result, partial[ii]);
+		}
+
+		return result;
+	}
+
+} // namespace bx
@@ -0,0 +1,198 @@
+/*
+ * Copyright 2010-2023 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bx/blob/master/LICENSE
+ */
+
+#ifndef BX_MPMCQUEUE_H_HEADER_GUARD
+#	error "Must be included from bx/mpmcqueue.h!"
+#endif // BX_MPMCQUEUE_H_HEADER_GUARD
+
+namespace bx
+{
+	// Reference(s):
+	// - Bounded MPMC queue
+	//   https://web.archive.org/web/20221116040709/https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+	//
+	inline MpMcBoundedQueue::MpMcBoundedQueue(AllocatorI* _allocator, uint32_t _capacity)
+		: m_allocator(_allocator)
+		, m_cells(NULL)
+		, m_mask(uint32_nextpow2(max(_capacity, 2) ) - 1)
+		, m_enqueuePos(0)
+		, m_dequeuePos(0)
+	{
+		m_cells = (Cell*)BX_ALIGNED_ALLOC(m_allocator, (m_mask+1)*sizeof(Cell), BX_CACHE_LINE_SIZE);
+
+		for (uint32_t ii = 0; ii <= m_mask; ++ii)
+		{
+			m_cells[ii].m_sequence = ii;
+			m_cells[ii].m_ptr      = NULL;
+		}
+	}
+
+	inline MpMcBoundedQueue::~MpMcBoundedQueue()
+	{
+		BX_ALIGNED_FREE(m_allocator, m_cells, BX_CACHE_LINE_SIZE);
+	}
+
+	inline uint32_t MpMcBoundedQueue::getCapacity() const
+	{
+		return m_mask+1;
+	}
+
+	inline bool MpMcBoundedQueue::tryPush(void* _ptr)
+	{
+		return 1 == tryPush(&_ptr, 1);
+	}
+
+	inline uint32_t MpMcBoundedQueue::tryPush(void* const* _ptrs, uint32_t _num)
+	{
+		uint32_t pos = atomicLoad(&m_enqueuePos);
+
+		for (;;)
+		{
+			// Count consecutive free slots, slot is free when its sequence matches position.
+			uint32_t num = 0;
+			int32_t  diff = 0;
+
+			for (; num < _num; ++num)
+			{
+				const Cell& cell = m_cells[(pos+num) & m_mask];
+				diff = int32_t(atomicLoad(&cell.m_sequence) - (pos+num) );
+
+				if (0 != diff)
+				{
+					break;
+				}
+			}
+
+			if (0 == num)
+			{
+				if (0 > diff)
+				{
+					// Queue is full.
+					return 0;
+				}
+
+				// Other producer claimed slot, retry with current position.
+				pos = atomicLoad(&m_enqueuePos);
+				continue;
+			}
+
+			const uint32_t oldPos = pos;
+			pos = atomicCompareAndSwap<uint32_t>(&m_enqueuePos, oldPos, oldPos+num);
+
+			if (pos == oldPos)
+			{
+				for (uint32_t ii = 0; ii < num; ++ii)
+				{
+					BX_ASSERT(NULL != _ptrs[ii], "MpMcBoundedQueue: Pushing NULL pointer.");
+
+					Cell& cell = m_cells[(pos+ii) & m_mask];
+					cell.m_ptr = _ptrs[ii];
+					atomicStore(&cell.m_sequence, pos+ii+1);
+				}
+
+				return num;
+			}
+		}
+	}
+
+	inline void* MpMcBoundedQueue::tryPop()
+	{
+		void* ptr;
+		return 1 == tryPop(&ptr, 1) ? ptr : NULL;
+	}
+
+	inline uint32_t MpMcBoundedQueue::tryPop(void** _ptrs, uint32_t _max)
+	{
+		uint32_t pos = atomicLoad(&m_dequeuePos);
+
+		for (;;)
+		{
+			// Count consecutive full slots, slot is full when its sequence is one ahead of position.
+			uint32_t num = 0;
+			int32_t  diff = 0;
+
+			for (; num < _max; ++num)
+			{
+				const Cell& cell = m_cells[(pos+num) & m_mask];
+				diff = int32_t(atomicLoad(&cell.m_sequence) - (pos+num+1) );
+
+				if (0 != diff)
+				{
+					break;
+				}
+			}
+
+			if (0 == num)
+			{
+				if (0 > diff)
+				{
+					// Queue is empty.
+					return 0;
+				}
+
+				// Other consumer claimed slot, retry with current position.
+				pos = atomicLoad(&m_dequeuePos);
+				continue;
+			}
+
+			const uint32_t oldPos = pos;
+			pos = atomicCompareAndSwap<uint32_t>(&m_dequeuePos, oldPos, oldPos+num);
+
+			if (pos == oldPos)
+			{
+				for (uint32_t ii = 0; ii < num; ++ii)
+				{
+					Cell& cell = m_cells[(pos+ii) & m_mask];
+					_ptrs[ii] = cell.m_ptr;
+					atomicStore(&cell.m_sequence, pos+ii+m_mask+1);
+				}
+
+				return num;
+			}
+		}
+	}
+
+	template <typename Ty>
+	inline MpMcBoundedQueueT<Ty>::MpMcBoundedQueueT(AllocatorI* _allocator, uint32_t _capacity)
+		: m_queue(_allocator, _capacity)
+	{
+	}
+
+	template <typename Ty>
+	inline MpMcBoundedQueueT<Ty>::~MpMcBoundedQueueT()
+	{
+	}
+
+	template <typename Ty>
+	inline uint32_t MpMcBoundedQueueT<Ty>::getCapacity() const
+	{
+		return m_queue.getCapacity();
+	}
+
+	template <typename Ty>
+	inline bool MpMcBoundedQueueT<Ty>::tryPush(Ty* _ptr)
+	{
+		return m_queue.tryPush(_ptr);
+	}
+
+	template <typename Ty>
+	inline uint32_t MpMcBoundedQueueT<Ty>::tryPush(Ty* const* _ptrs, uint32_t _num)
+	{
+		return m_queue.tryPush( (void* const*)_ptrs, _num);
+	}
+
+	template <typename Ty>
+	inline Ty* MpMcBoundedQueueT<Ty>::tryPop()
+	{
+		return (Ty*)m_queue.tryPop();
+	}
+
+	template <typename Ty>
+	inline uint32_t MpMcBoundedQueueT<Ty>::tryPop(Ty** _ptrs, uint32_t _max)
+	{
+		return m_queue.tryPop( (void**)_ptrs, _max);
+	}
+
+} // namespace bx
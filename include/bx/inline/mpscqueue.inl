@@ -39,6 +39,75 @@ namespace bx
 		return m_queue.pop();
 	}
 
+	// Reference(s):
+	// - Non-intrusive MPSC node-based queue
+	//   https://web.archive.org/web/20221116040735/https://www.1024cores.net/home/lock-free-algorithms/queues/non-intrusive-mpsc-node-based-queue
+	//
+	template <typename Ty>
+	inline MpScUnboundedLockFreeQueueT<Ty>::MpScUnboundedLockFreeQueueT(AllocatorI* _allocator)
+		: m_allocator(_allocator)
+		, m_head(BX_NEW(m_allocator, Node)(NULL) )
+		, m_tail(m_head)
+	{
+	}
+
+	template <typename Ty>
+	inline MpScUnboundedLockFreeQueueT<Ty>::~MpScUnboundedLockFreeQueueT()
+	{
+		while (NULL != m_tail)
+		{
+			Node* node = m_tail;
+			m_tail = node->m_next;
+			BX_DELETE(m_allocator, node);
+		}
+	}
+
+	template <typename Ty>
+	inline void MpScUnboundedLockFreeQueueT<Ty>::push(Ty* _ptr)
+	{
+		Node* node = BX_NEW(m_allocator, Node)(_ptr);
+		Node* prev = (Node*)atomicExchangePtr( (void**)&m_head, node);
+
+		// Until previous node is linked, consumer sees queue as ending at previous node.
+		atomicStore<Node*>(&prev->m_next, node);
+	}
+
+	template <typename Ty>
+	inline Ty* MpScUnboundedLockFreeQueueT<Ty>::peek()
+	{
+		Node* next = atomicLoad<Node*>(&m_tail->m_next);
+
+		if (NULL != next)
+		{
+			return next->m_ptr;
+		}
+
+		return NULL;
+	}
+
+	template <typename Ty>
+	inline Ty* MpScUnboundedLockFreeQueueT<Ty>::pop()
+	{
+		Node* next = atomicLoad<Node*>(&m_tail->m_next);
+
+		if (NULL != next)
+		{
+			Ty* ptr = next->m_ptr;
+			BX_DELETE(m_allocator, m_tail);
+			m_tail = next;
+			return ptr;
+		}
+
+		return NULL;
+	}
+
+	template <typename Ty>
+	inline MpScUnboundedLockFreeQueueT<Ty>::Node::Node(Ty* _ptr)
+		: m_ptr(_ptr)
+		, m_next(NULL)
+	{
+	}
+
 	template <typename Ty>
 	inline MpScUnboundedBlockingQueue<Ty>::MpScUnboundedBlockingQueue(AllocatorI* _allocator)
 		: m_queue(_allocator)
@@ -74,7 +74,11 @@ namespace bx
 	{
 		if (0 < _size)
 		{
-			m_size += _size;
+			const uint64_t size = max<uint64_t>(
+				  uint64_t(m_size) + _size
+				, uint64_t(m_size) + m_size/2
+				);
+			m_size = uint32_t(min<uint64_t>(size, UINT32_MAX) );
 			m_data = BX_REALLOC(m_allocator, m_data, m_size);
 		}
 
@@ -86,6 +90,179 @@ namespace bx
 		return m_size;
 	}
 
+	inline ChunkedMemoryBlock::ChunkedMemoryBlock(AllocatorI* _allocator, uint32_t _chunkSize)
+		: m_allocator(_allocator)
+		, m_chunk(NULL)
+		, m_size(0)
+		, m_capacity(0)
+		, m_num(0)
+		, m_max(0)
+		, m_chunkSize(max(_chunkSize, 16) )
+	{
+	}
+
+	inline ChunkedMemoryBlock::~ChunkedMemoryBlock()
+	{
+		for (uint32_t ii = 0; ii < m_num; ++ii)
+		{
+			BX_FREE(m_allocator, m_chunk[ii].data);
+		}
+
+		BX_FREE(m_allocator, m_chunk);
+	}
+
+	inline bool ChunkedMemoryBlock::grow()
+	{
+		if (m_num == m_max)
+		{
+			const uint32_t num = max(m_max*2, 16);
+			Chunk* chunk = (Chunk*)BX_REALLOC(m_allocator, m_chunk, num*sizeof(Chunk) );
+
+			if (NULL == chunk)
+			{
+				return false;
+			}
+
+			m_chunk = chunk;
+			m_max   = num;
+		}
+
+		uint8_t* data = (uint8_t*)BX_ALLOC(m_allocator, m_chunkSize);
+
+		if (NULL == data)
+		{
+			return false;
+		}
+
+		Chunk& chunk = m_chunk[m_num++];
+		chunk.data   = data;
+		chunk.offset = m_capacity;
+		chunk.size   = m_chunkSize;
+
+		m_capacity  += m_chunkSize;
+		m_chunkSize  = min(m_chunkSize*2, 64<<20);
+
+		return true;
+	}
+
+	inline uint32_t ChunkedMemoryBlock::findChunk(int64_t _offset) const
+	{
+		uint32_t first = 0;
+		uint32_t last  = m_num;
+
+		while (first + 1 < last)
+		{
+			const uint32_t mid = (first + last) / 2;
+
+			if (m_chunk[mid].offset <= _offset)
+			{
+				first = mid;
+			}
+			else
+			{
+				last = mid;
+			}
+		}
+
+		return first;
+	}
+
+	inline bool ChunkedMemoryBlock::resize(int64_t _size)
+	{
+		while (m_capacity < _size)
+		{
+			if (!grow() )
+			{
+				m_size = m_capacity;
+				return false;
+			}
+		}
+
+		m_size = max<int64_t>(_size, 0);
+
+		return true;
+	}
+
+	inline int64_t ChunkedMemoryBlock::getSize() const
+	{
+		return m_size;
+	}
+
+	inline int64_t ChunkedMemoryBlock::getCapacity() const
+	{
+		return m_capacity;
+	}
+
+	inline void* ChunkedMemoryBlock::getPtr(int64_t _offset, uint32_t* _outSize) const
+	{
+		if (_offset < 0
+		||  _offset >= m_capacity)
+		{
+			*_outSize = 0;
+			return NULL;
+		}
+
+		const Chunk& chunk = m_chunk[findChunk(_offset)];
+		const uint32_t offset = uint32_t(_offset - chunk.offset);
+		*_outSize = chunk.size - offset;
+
+		return &chunk.data[offset];
+	}
+
+	inline uint32_t ChunkedMemoryBlock::getNumChunks() const
+	{
+		return m_num;
+	}
+
+	inline const void* ChunkedMemoryBlock::getChunk(uint32_t _idx, uint32_t* _outSize) const
+	{
+		BX_ASSERT(_idx < m_num, "ChunkedMemoryBlock: Invalid chunk index %d (max: %d).", _idx, m_num);
+
+		const Chunk& chunk = m_chunk[_idx];
+		*_outSize = uint32_t(clamp<int64_t>(m_size - chunk.offset, 0, chunk.size) );
+
+		return chunk.data;
+	}
+
+	inline int64_t ChunkedMemoryBlock::gather(WriterI* _writer, Error* _err) const
+	{
+		BX_ERROR_SCOPE(_err);
+
+		int64_t total = 0;
+
+		for (uint32_t ii = 0; ii < m_num && _err->isOk(); ++ii)
+		{
+			uint32_t size;
+			const void* data = getChunk(ii, &size);
+
+			if (0 == size)
+			{
+				break;
+			}
+
+			total += _writer->write(data, int32_t(size), _err);
+		}
+
+		return total;
+	}
+
+	inline int64_t ChunkedMemoryBlock::flatten(void* _data, int64_t _size) const
+	{
+		uint8_t* data = (uint8_t*)_data;
+		int64_t total = 0;
+		const int64_t size = min(_size, m_size);
+
+		for (uint32_t ii = 0; ii < m_num && total < size; ++ii)
+		{
+			const Chunk& chunk = m_chunk[ii];
+			const int64_t num  = min<int64_t>(chunk.size, size - total);
+			memCopy(&data[total], chunk.data, size_t(num) );
+			total += num;
+		}
+
+		return total;
+	}
+
 	inline SizerWriter::SizerWriter()
 		: m_pos(0)
 		, m_top(0)
@@ -256,6 +433,68 @@ namespace bx
 		return size;
 	}
 
+	inline ChunkedMemoryWriter::ChunkedMemoryWriter(ChunkedMemoryBlock* _memBlock)
+		: m_memBlock(_memBlock)
+		, m_pos(0)
+	{
+	}
+
+	inline ChunkedMemoryWriter::~ChunkedMemoryWriter()
+	{
+	}
+
+	inline int64_t ChunkedMemoryWriter::seek(int64_t _offset, Whence::Enum _whence)
+	{
+		const int64_t top = m_memBlock->getSize();
+
+		switch (_whence)
+		{
+			case Whence::Begin:
+				m_pos = clamp<int64_t>(_offset, 0, top);
+				break;
+
+			case Whence::Current:
+				m_pos = clamp<int64_t>(m_pos + _offset, 0, top);
+				break;
+
+			case Whence::End:
+				m_pos = clamp<int64_t>(top - _offset, 0, top);
+				break;
+		}
+
+		return m_pos;
+	}
+
+	inline int32_t ChunkedMemoryWriter::write(const void* _data, int32_t _size, Error* _err)
+	{
+		BX_ASSERT(NULL != _err, "Reader/Writer interface calling functions must handle errors.");
+
+		const int64_t top = max(m_memBlock->getSize(), m_pos + _size);
+		m_memBlock->resize(top);
+
+		const int32_t size = int32_t(clamp<int64_t>(m_memBlock->getSize() - m_pos, 0, _size) );
+		const uint8_t* data = (const uint8_t*)_data;
+
+		for (int32_t ii = 0; ii < size;)
+		{
+			uint32_t avail;
+			uint8_t* ptr = (uint8_t*)m_memBlock->getPtr(m_pos, &avail);
+
+			const int32_t num = int32_t(min<int64_t>(avail, size - ii) );
+			memCopy(ptr, &data[ii], num);
+
+			ii    += num;
+			m_pos += num;
+		}
+
+		if (size != _size)
+		{
+			BX_ERROR_SET(_err, kErrorReaderWriterWrite, "ChunkedMemoryWriter: write truncated.");
+		}
+
+		return size;
+	}
+
 	inline StaticMemoryBlockWriter::StaticMemoryBlockWriter(void* _data, uint32_t _size)
 		: MemoryWriter(&m_smb)
 		, m_smb(_data, _size)
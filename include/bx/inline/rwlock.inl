@@ -0,0 +1,127 @@
+/*
+ * Copyright 2010-2023 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bx/blob/master/LICENSE
+ */
+
+#ifndef BX_RWLOCK_H_HEADER_GUARD
+#	error "Must be included from bx/rwlock.h!"
+#endif // BX_RWLOCK_H_HEADER_GUARD
+
+namespace bx
+{
+	inline RwLockReadScope::RwLockReadScope(RwLock& _lock)
+		: m_lock(_lock)
+	{
+		m_lock.readLock();
+	}
+
+	inline RwLockReadScope::~RwLockReadScope()
+	{
+		m_lock.readUnlock();
+	}
+
+	inline RwLockWriteScope::RwLockWriteScope(RwLock& _lock)
+		: m_lock(_lock)
+	{
+		m_lock.writeLock();
+	}
+
+	inline RwLockWriteScope::~RwLockWriteScope()
+	{
+		m_lock.writeUnlock();
+	}
+
+	inline SeqLock::SeqLock()
+		: m_sequence(0)
+	{
+	}
+
+	inline uint32_t SeqLock::readBegin() const
+	{
+		uint32_t sequence = atomicLoad(&m_sequence);
+
+		while (0 != (sequence & 1) )
+		{
+			spinPause();
+			sequence = atomicLoad(&m_sequence);
+		}
+
+		return sequence;
+	}
+
+	inline bool SeqLock::readRetry(uint32_t _sequence) const
+	{
+		// Data loads must complete before sequence is loaded again. x86 doesn't reorder loads
+		// with other loads, so only compiler barrier is needed there.
+#if BX_CPU_X86
+		readBarrier();
+#else
+		memoryBarrier();
+#endif // BX_CPU_X86
+
+		return _sequence != atomicLoad(&m_sequence);
+	}
+
+	inline void SeqLock::writeBegin()
+	{
+		// Odd sequence marks active writer, compare and swap from even value serializes
+		// writers, and it's full barrier, so data stores can't move before it.
+		for (;;)
+		{
+			const uint32_t sequence = atomicLoad(&m_sequence);
+
+			if (0 == (sequence & 1)
+			&&  sequence == atomicCompareAndSwap<uint32_t>(&m_sequence, sequence, sequence+1) )
+			{
+				return;
+			}
+
+			spinPause();
+		}
+	}
+
+	inline void SeqLock::writeEnd()
+	{
+		BX_ASSERT(0 != (m_sequence & 1), "SeqLock: writeEnd without writeBegin.");
+		atomicStore<uint32_t>(&m_sequence, m_sequence+1);
+	}
+
+	template<typename Ty>
+	inline SeqLockT<Ty>::SeqLockT()
+		: m_value()
+	{
+		BX_STATIC_ASSERT(isTriviallyCopyable<Ty>(), "SeqLockT: Value type must be trivially copyable.");
+	}
+
+	template<typename Ty>
+	inline SeqLockT<Ty>::SeqLockT(const Ty& _value)
+		: m_value(_value)
+	{
+		BX_STATIC_ASSERT(isTriviallyCopyable<Ty>(), "SeqLockT: Value type must be trivially copyable.");
+	}
+
+	template<typename Ty>
+	inline Ty SeqLockT<Ty>::read() const
+	{
+		Ty value;
+		uint32_t sequence;
+
+		do
+		{
+			sequence = m_lock.readBegin();
+			memCopy(&value, &m_value, sizeof(Ty) );
+		}
+		while (m_lock.readRetry(sequence) );
+
+		return value;
+	}
+
+	template<typename Ty>
+	inline void SeqLockT<Ty>::write(const Ty& _value)
+	{
+		m_lock.writeBegin();
+		memCopy(&m_value, &_value, sizeof(Ty) );
+		m_lock.writeEnd();
+	}
+
+} // namespace bx
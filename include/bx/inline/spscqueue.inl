@@ -100,6 +100,261 @@ namespace bx
 		return (Ty*)m_queue.pop();
 	}
 
+	inline SpScUnboundedChunkedQueue::SpScUnboundedChunkedQueue(AllocatorI* _allocator, uint32_t _chunkSize)
+		: m_allocator(_allocator)
+		, m_chunkSize(max(_chunkSize, 2) )
+		, m_first(NULL)
+		, m_write(NULL)
+		, m_writePos(0)
+		, m_read(NULL)
+		, m_readPos(0)
+		, m_readNum(0)
+	{
+		m_first = allocChunk();
+		m_write = m_first;
+		m_read  = m_first;
+	}
+
+	inline SpScUnboundedChunkedQueue::~SpScUnboundedChunkedQueue()
+	{
+		while (NULL != m_first)
+		{
+			Chunk* chunk = m_first;
+			m_first = chunk->m_next;
+			BX_FREE(m_allocator, chunk);
+		}
+	}
+
+	inline void SpScUnboundedChunkedQueue::push(void* _ptr)
+	{
+		if (m_writePos == m_chunkSize)
+		{
+			Chunk* chunk = allocChunk();
+			atomicStore<Chunk*>(&m_write->m_next, chunk);
+			m_write    = chunk;
+			m_writePos = 0;
+		}
+
+		getPtrs(m_write)[m_writePos] = _ptr;
+		++m_writePos;
+		atomicStore(&m_write->m_num, m_writePos);
+	}
+
+	inline void* SpScUnboundedChunkedQueue::peek()
+	{
+		if (isEmpty() )
+		{
+			return NULL;
+		}
+
+		return getPtrs(m_read)[m_readPos];
+	}
+
+	inline void* SpScUnboundedChunkedQueue::pop()
+	{
+		if (isEmpty() )
+		{
+			return NULL;
+		}
+
+		void* ptr = getPtrs(m_read)[m_readPos];
+		++m_readPos;
+		return ptr;
+	}
+
+	inline SpScUnboundedChunkedQueue::Chunk* SpScUnboundedChunkedQueue::allocChunk()
+	{
+		Chunk* chunk;
+
+		// Chunks before the one consumer is reading from are done, and can be reused.
+		if (m_first != atomicLoad<Chunk*>(&m_read) )
+		{
+			chunk   = m_first;
+			m_first = chunk->m_next;
+		}
+		else
+		{
+			chunk = (Chunk*)BX_ALLOC(m_allocator, sizeof(Chunk) + m_chunkSize*sizeof(void*) );
+		}
+
+		chunk->m_next = NULL;
+		chunk->m_num  = 0;
+		return chunk;
+	}
+
+	inline void** SpScUnboundedChunkedQueue::getPtrs(Chunk* _chunk) const
+	{
+		return (void**)&_chunk[1];
+	}
+
+	inline bool SpScUnboundedChunkedQueue::isEmpty()
+	{
+		if (m_readPos < m_readNum)
+		{
+			return false;
+		}
+
+		m_readNum = atomicLoad(&m_read->m_num);
+
+		if (m_readPos < m_readNum)
+		{
+			return false;
+		}
+
+		if (m_readPos == m_chunkSize)
+		{
+			Chunk* next = atomicLoad<Chunk*>(&m_read->m_next);
+
+			if (NULL != next)
+			{
+				m_readPos = 0;
+				m_readNum = atomicLoad(&next->m_num);
+				atomicStore<Chunk*>(&m_read, next);
+				return 0 == m_readNum;
+			}
+		}
+
+		return true;
+	}
+
+	template<typename Ty>
+	inline SpScUnboundedChunkedQueueT<Ty>::SpScUnboundedChunkedQueueT(AllocatorI* _allocator, uint32_t _chunkSize)
+		: m_queue(_allocator, _chunkSize)
+	{
+	}
+
+	template<typename Ty>
+	inline SpScUnboundedChunkedQueueT<Ty>::~SpScUnboundedChunkedQueueT()
+	{
+	}
+
+	template<typename Ty>
+	inline void SpScUnboundedChunkedQueueT<Ty>::push(Ty* _ptr)
+	{
+		m_queue.push(_ptr);
+	}
+
+	template<typename Ty>
+	inline Ty* SpScUnboundedChunkedQueueT<Ty>::peek()
+	{
+		return (Ty*)m_queue.peek();
+	}
+
+	template<typename Ty>
+	inline Ty* SpScUnboundedChunkedQueueT<Ty>::pop()
+	{
+		return (Ty*)m_queue.pop();
+	}
+
+	template<typename Ty>
+	inline SpScBoundedQueueT<Ty>::SpScBoundedQueueT(AllocatorI* _allocator, uint32_t _capacity)
+		: m_allocator(_allocator)
+		, m_values(NULL)
+		, m_mask(uint32_nextpow2(max(_capacity, 2) ) - 1)
+		, m_write(0)
+		, m_readCache(0)
+		, m_read(0)
+		, m_writeCache(0)
+	{
+		BX_STATIC_ASSERT(isTriviallyCopyable<Ty>(), "SpScBoundedQueueT: Ty must be trivially copyable.");
+
+		m_values = (Ty*)BX_ALIGNED_ALLOC(m_allocator, (m_mask+1)*sizeof(Ty), max(BX_ALIGNOF(Ty), BX_CACHE_LINE_SIZE) );
+	}
+
+	template<typename Ty>
+	inline SpScBoundedQueueT<Ty>::~SpScBoundedQueueT()
+	{
+		BX_ALIGNED_FREE(m_allocator, m_values, max(BX_ALIGNOF(Ty), BX_CACHE_LINE_SIZE) );
+	}
+
+	template<typename Ty>
+	inline uint32_t SpScBoundedQueueT<Ty>::getCapacity() const
+	{
+		return m_mask+1;
+	}
+
+	template<typename Ty>
+	inline bool SpScBoundedQueueT<Ty>::push(const Ty& _value)
+	{
+		return 1 == pushN(&_value, 1);
+	}
+
+	template<typename Ty>
+	inline uint32_t SpScBoundedQueueT<Ty>::pushN(const Ty* _values, uint32_t _num)
+	{
+		const uint32_t write    = m_write;
+		const uint32_t capacity = m_mask+1;
+
+		uint32_t avail = capacity - (write - m_readCache);
+
+		if (avail < _num)
+		{
+			m_readCache = atomicLoad(&m_read);
+			avail = capacity - (write - m_readCache);
+		}
+
+		const uint32_t num   = min(avail, _num);
+		const uint32_t pos   = write & m_mask;
+		const uint32_t first = min(num, capacity - pos);
+
+		memCopy(&m_values[pos], _values,         first      *sizeof(Ty) );
+		memCopy(&m_values[0],   &_values[first], (num-first)*sizeof(Ty) );
+
+		atomicStore(&m_write, write+num);
+
+		return num;
+	}
+
+	template<typename Ty>
+	inline const Ty* SpScBoundedQueueT<Ty>::peek()
+	{
+		const uint32_t read = m_read;
+
+		if (read == m_writeCache)
+		{
+			m_writeCache = atomicLoad(&m_write);
+
+			if (read == m_writeCache)
+			{
+				return NULL;
+			}
+		}
+
+		return &m_values[read & m_mask];
+	}
+
+	template<typename Ty>
+	inline bool SpScBoundedQueueT<Ty>::pop(Ty& _value)
+	{
+		return 1 == popN(&_value, 1);
+	}
+
+	template<typename Ty>
+	inline uint32_t SpScBoundedQueueT<Ty>::popN(Ty* _values, uint32_t _max)
+	{
+		const uint32_t read     = m_read;
+		const uint32_t capacity = m_mask+1;
+
+		uint32_t avail = m_writeCache - read;
+
+		if (avail < _max)
+		{
+			m_writeCache = atomicLoad(&m_write);
+			avail = m_writeCache - read;
+		}
+
+		const uint32_t num   = min(avail, _max);
+		const uint32_t pos   = read & m_mask;
+		const uint32_t first = min(num, capacity - pos);
+
+		memCopy(_values,         &m_values[pos], first      *sizeof(Ty) );
+		memCopy(&_values[first], &m_values[0],   (num-first)*sizeof(Ty) );
+
+		atomicStore(&m_read, read+num);
+
+		return num;
+	}
+
 #if BX_CONFIG_SUPPORTS_THREADING
 	inline SpScBlockingUnboundedQueue::SpScBlockingUnboundedQueue(AllocatorI* _allocator)
 		: m_queue(_allocator)
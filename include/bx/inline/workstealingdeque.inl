@@ -0,0 +1,183 @@
+/*
+ * Copyright 2010-2023 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bx/blob/master/LICENSE
+ */
+
+#ifndef BX_WORK_STEALING_DEQUE_H_HEADER_GUARD
+#	error "Must be included from bx/workstealingdeque.h!"
+#endif // BX_WORK_STEALING_DEQUE_H_HEADER_GUARD
+
+namespace bx
+{
+	// Reference(s):
+	// - Dynamic Circular Work-Stealing Deque, David Chase and Yossi Lev, SPAA 2005
+	// - Correct and Efficient Work-Stealing for Weak Memory Models, Nhat Minh Le, Antoniu
+	//   Pop, Albert Cohen and Francesco Zappa Nardelli, PPoPP 2013
+	//
+	inline WorkStealingDeque::WorkStealingDeque(AllocatorI* _allocator, uint32_t _capacity)
+		: m_allocator(_allocator)
+		, m_top(0)
+		, m_bottom(0)
+		, m_array(NULL)
+	{
+		m_array = allocArray(uint32_nextpow2(max(_capacity, 2) ) );
+	}
+
+	inline WorkStealingDeque::~WorkStealingDeque()
+	{
+		// Arrays replaced by grow are kept alive until destruction, since thieves might still
+		// read from them.
+		for (Array* array = m_array; NULL != array;)
+		{
+			Array* prev = array->m_prev;
+			BX_FREE(m_allocator, array);
+			array = prev;
+		}
+	}
+
+	inline uint32_t WorkStealingDeque::getNumItems() const
+	{
+		const int64_t bottom = atomicLoad(&m_bottom);
+		const int64_t top    = atomicLoad(&m_top);
+		return uint32_t(max<int64_t>(bottom - top, 0) );
+	}
+
+	inline void WorkStealingDeque::push(void* _ptr)
+	{
+		BX_ASSERT(NULL != _ptr, "WorkStealingDeque: Pushing NULL pointer.");
+
+		const int64_t bottom = m_bottom;
+		const int64_t top    = atomicLoad(&m_top);
+		Array* array = m_array;
+
+		if (bottom - top > array->m_mask)
+		{
+			array = grow(array, bottom, top);
+		}
+
+		getPtrs(array)[bottom & array->m_mask] = _ptr;
+		atomicStore(&m_bottom, bottom+1);
+	}
+
+	inline void* WorkStealingDeque::pop()
+	{
+		const int64_t bottom = m_bottom - 1;
+		Array* array = m_array;
+
+		// Reserve bottom item before reading top, full barrier orders store with load, so owner
+		// and thief can't both take the last item.
+		atomicStore(&m_bottom, bottom);
+		memoryBarrier();
+		const int64_t top = atomicLoad(&m_top);
+
+		if (top > bottom)
+		{
+			atomicStore(&m_bottom, bottom+1);
+			return NULL;
+		}
+
+		void* ptr = getPtrs(array)[bottom & array->m_mask];
+
+		if (top == bottom)
+		{
+			// Last item, race with thieves for it.
+			if (top != atomicCompareAndSwap<int64_t>(&m_top, top, top+1) )
+			{
+				ptr = NULL;
+			}
+
+			atomicStore(&m_bottom, bottom+1);
+		}
+
+		return ptr;
+	}
+
+	inline void* WorkStealingDeque::steal()
+	{
+		const int64_t top = atomicLoad(&m_top);
+		memoryBarrier();
+		const int64_t bottom = atomicLoad(&m_bottom);
+
+		if (top >= bottom)
+		{
+			return NULL;
+		}
+
+		Array* array = atomicLoad<Array*>(&m_array);
+		void* ptr = getPtrs(array)[top & array->m_mask];
+
+		if (top != atomicCompareAndSwap<int64_t>(&m_top, top, top+1) )
+		{
+			return NULL;
+		}
+
+		return ptr;
+	}
+
+	inline WorkStealingDeque::Array* WorkStealingDeque::allocArray(int64_t _size)
+	{
+		Array* array = (Array*)BX_ALLOC(m_allocator, sizeof(Array) + _size*sizeof(void*) );
+		array->m_prev = NULL;
+		array->m_mask = _size-1;
+		return array;
+	}
+
+	inline void* volatile* WorkStealingDeque::getPtrs(Array* _array) const
+	{
+		return (void* volatile*)&_array[1];
+	}
+
+	inline WorkStealingDeque::Array* WorkStealingDeque::grow(Array* _array, int64_t _bottom, int64_t _top)
+	{
+		Array* array = allocArray( (_array->m_mask+1)*2);
+		array->m_prev = _array;
+
+		void* volatile* src = getPtrs(_array);
+		void* volatile* dst = getPtrs(array);
+
+		for (int64_t ii = _top; ii < _bottom; ++ii)
+		{
+			dst[ii & array->m_mask] = src[ii & _array->m_mask];
+		}
+
+		atomicStore<Array*>(&m_array, array);
+
+		return array;
+	}
+
+	template<typename Ty>
+	inline WorkStealingDequeT<Ty>::WorkStealingDequeT(AllocatorI* _allocator, uint32_t _capacity)
+		: m_deque(_allocator, _capacity)
+	{
+	}
+
+	template<typename Ty>
+	inline WorkStealingDequeT<Ty>::~WorkStealingDequeT()
+	{
+	}
+
+	template<typename Ty>
+	inline uint32_t WorkStealingDequeT<Ty>::getNumItems() const
+	{
+		return m_deque.getNumItems();
+	}
+
+	template<typename Ty>
+	inline void WorkStealingDequeT<Ty>::push(Ty* _ptr)
+	{
+		m_deque.push(_ptr);
+	}
+
+	template<typename Ty>
+	inline Ty* WorkStealingDequeT<Ty>::pop()
+	{
+		return (Ty*)m_deque.pop();
+	}
+
+	template<typename Ty>
+	inline Ty* WorkStealingDequeT<Ty>::steal()
+	{
+		return (Ty*)m_deque.steal();
+	}
+
+} // namespace bx
@@ -0,0 +1,212 @@
+/*
+ * Copyright 2010-2023 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bx/blob/master/LICENSE
+ */
+
+#ifndef BX_JOB_SYSTEM_H_HEADER_GUARD
+#define BX_JOB_SYSTEM_H_HEADER_GUARD
+
+#include "allocator.h"
+#include "mpmcqueue.h"
+#include "semaphore.h"
+#include "thread.h"
+
+#if BX_CONFIG_SUPPORTS_THREADING
+
+namespace bx
+{
+	///
+	typedef void (*JobFn)(void* _userData);
+
+	/// Number of jobs in flight, used to wait for group of jobs to finish.
+	struct JobCounter
+	{
+		///
+		JobCounter();
+
+		///
+		bool isDone() const;
+
+		volatile int32_t m_value;
+	};
+
+	/// Work-stealing job system. Each worker thread has its own deque, jobs added from worker
+	/// thread go to its deque, and jobs added from other threads go to shared queue. Idle workers
+	/// steal from other workers, spin briefly, and then sleep on their own semaphore.
+	///
+	/// In fiber mode each job runs on fiber from fixed pool. When job waits on counter that
+	/// is not done, its fiber is suspended, and worker continues with other jobs instead of
+	/// blocking. Suspended fiber is resumed on the same worker once counter is done, so jobs
+	/// can use thread local state across wait.
+	///
+	class JobSystem
+	{
+		BX_CLASS(JobSystem
+			, NO_DEFAULT_CTOR
+			, NO_COPY
+			);
+
+	public:
+		/// Create job system.
+		///
+		/// @param[in] _allocator Allocator.
+		/// @param[in] _numWorkers Number of worker threads, when zero number of CPUs is used.
+		/// @param[in] _maxJobs Maximum number of jobs in flight. When all jobs are in flight,
+		///   `add` runs pending jobs on calling thread until job becomes available.
+		/// @param[in] _numFibers Number of fibers in pool, when zero jobs run directly on worker
+		///   threads. When all fibers are in use, jobs run directly on worker threads. Ignored
+		///   when `BX_CONFIG_SUPPORTS_FIBERS` is 0.
+		/// @param[in] _fiberStackSize Fiber stack size.
+		///
+		JobSystem(
+			  AllocatorI* _allocator
+			, uint32_t _numWorkers = 0
+			, uint32_t _maxJobs = 4096
+			, uint32_t _numFibers = 0
+			, uint32_t _fiberStackSize = 64<<10
+			);
+
+		/// Waits for worker threads to finish. Jobs that didn't start are not executed.
+		~JobSystem();
+
+		///
+		uint32_t getNumWorkers() const;
+
+		/// Returns number of fibers in pool.
+		uint32_t getNumFibers() const;
+
+		/// Add job.
+		///
+		/// @param[in] _fn Job function.
+		/// @param[in] _userData User data passed to job function.
+		/// @param[in] _counter Counter incremented now, and decremented when job finishes.
+		///
+		void add(JobFn _fn, void* _userData, JobCounter* _counter = NULL);
+
+		/// Wait for counter to reach zero. When called from job running on fiber, fiber is
+		/// suspended until counter is done.
+		///
+		/// @param[in] _counter Counter.
+		/// @param[in] _runJobs When true, calling thread runs pending jobs while waiting.
+		///
+		void wait(const JobCounter* _counter, bool _runJobs = true);
+
+		/// Run one pending job on calling thread.
+		///
+		/// @returns False if there was no pending job.
+		///
+		bool runOne();
+
+	private:
+		struct Job;
+		struct JobFiber;
+		struct Worker;
+
+		///
+		static int32_t workerFn(Thread* _thread, void* _userData);
+
+		///
+		Job* allocJob();
+
+		///
+		Job* findJob(Worker* _worker);
+
+		///
+		void execute(Job* _job);
+
+		/// Wake one sleeping worker.
+		void wake();
+
+		/// Wake worker if it's sleeping, returns false if it wasn't sleeping.
+		bool wake(Worker* _worker);
+
+		/// Returns true if worker has suspended fiber whose counter is done.
+		bool isResumable(const Worker* _worker) const;
+
+		///
+		static void fiberFn(void* _userData);
+
+		///
+		void run(Worker* _worker, Job* _job);
+
+		///
+		void resume(Worker* _worker);
+
+		///
+		void switchTo(Worker* _worker, JobFiber* _fiber);
+
+		AllocatorI* m_allocator;
+		Job*        m_jobs;
+		Worker*     m_workers;
+		uint32_t    m_numWorkers;
+		JobFiber*   m_fibers;
+		uint32_t    m_numFibers;
+
+		MpMcBoundedQueue m_free;
+		MpMcBoundedQueue m_freeFibers;
+		MpMcBoundedQueue m_queue;
+		TlsData          m_tls;
+
+		volatile int32_t m_numSleeping;
+		volatile int32_t m_numSuspended;
+		volatile int32_t m_exit;
+	};
+
+	///
+	typedef void (*ParallelForFn)(uint32_t _begin, uint32_t _end, void* _userData);
+
+	/// Returns number of iterations per chunk used by `parallelFor` and `parallelReduce`.
+	/// Range is split into few chunks per worker, so that stealing can balance uneven work, but
+	/// chunk is never smaller than `_grainSize`.
+	///
+	uint32_t calcParallelChunkSize(const JobSystem* _jobSystem, uint32_t _num, uint32_t _grainSize);
+
+	/// Call function for chunks of range [_begin, _end) in parallel. Calling thread runs first
+	/// chunk, and runs other pending jobs while waiting, so it's safe to call from inside of job.
+	/// When job system is NULL, or range fits in single chunk, function is called on calling
+	/// thread.
+	///
+	/// @param[in] _jobSystem Job system.
+	/// @param[in] _begin First iteration.
+	/// @param[in] _end One past last iteration.
+	/// @param[in] _grainSize Minimum number of iterations per chunk.
+	/// @param[in] _fn Function called with chunk range.
+	/// @param[in] _userData User data passed to function.
+	///
+	void parallelFor(
+		  JobSystem* _jobSystem
+		, uint32_t _begin
+		, uint32_t _end
+		, uint32_t _grainSize
+		, ParallelForFn _fn
+		, void* _userData
+		);
+
+	/// Call `_fn(uint32_t _begin, uint32_t _end)` for chunks of range [_begin, _end) in parallel.
+	template<typename FnT>
+	void parallelFor(JobSystem* _jobSystem, uint32_t _begin, uint32_t _end, uint32_t _grainSize, const FnT& _fn);
+
+	/// Map chunks of range [_begin, _end) in parallel with `Ty _map(uint32_t _begin, uint32_t _end)`,
+	/// and combine chunk results with `Ty _reduce(const Ty& _a, const Ty& _b)`. Chunk results are
+	/// combined in range order, so result doesn't depend on scheduling.
+	///
+	/// @remark `Ty` must be default constructible.
+	///
+	template<typename Ty, typename MapFnT, typename ReduceFnT>
+	Ty parallelReduce(
+		  JobSystem* _jobSystem
+		, uint32_t _begin
+		, uint32_t _end
+		, uint32_t _grainSize
+		, const Ty& _identity
+		, const MapFnT& _map
+		, const ReduceFnT& _reduce
+		);
+
+} // namespace bx
+
+#include "inline/jobsystem.inl"
+
+#endif // BX_CONFIG_SUPPORTS_THREADING
+
+#endif // BX_JOB_SYSTEM_H_HEADER_GUARD
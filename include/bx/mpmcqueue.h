@@ -0,0 +1,104 @@
+/*
+ * Copyright 2010-2023 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bx/blob/master/LICENSE
+ */
+
+#ifndef BX_MPMCQUEUE_H_HEADER_GUARD
+#define BX_MPMCQUEUE_H_HEADER_GUARD
+
+#include "allocator.h"
+#include "cpu.h"
+#include "uint32_t.h"
+
+namespace bx
+{
+	/// Bounded lock-free multi-producer multi-consumer queue. Each slot has sequence counter,
+	/// that tells producers and consumers whether slot is free or full for current lap.
+	///
+	/// @remark Queue stores pointers, and NULL is returned when queue is empty, so NULL can't
+	///   be pushed.
+	///
+	class MpMcBoundedQueue
+	{
+		BX_CLASS(MpMcBoundedQueue
+			, NO_DEFAULT_CTOR
+			, NO_COPY
+			);
+
+	public:
+		/// Capacity is rounded up to power of 2.
+		MpMcBoundedQueue(AllocatorI* _allocator, uint32_t _capacity);
+
+		///
+		~MpMcBoundedQueue();
+
+		///
+		uint32_t getCapacity() const;
+
+		/// Returns false if queue is full.
+		bool tryPush(void* _ptr);
+
+		/// Pushes up to `_num` pointers, returns number of pointers pushed.
+		uint32_t tryPush(void* const* _ptrs, uint32_t _num);
+
+		/// Returns NULL if queue is empty.
+		void* tryPop();
+
+		/// Pops up to `_max` pointers, returns number of pointers popped.
+		uint32_t tryPop(void** _ptrs, uint32_t _max);
+
+	private:
+		BX_ALIGN_DECL_CACHE_LINE(struct) Cell
+		{
+			volatile uint32_t m_sequence;
+			void* m_ptr;
+		};
+
+		AllocatorI* m_allocator;
+		Cell* m_cells;
+		uint32_t m_mask;
+
+		BX_ALIGN_DECL_CACHE_LINE(volatile uint32_t) m_enqueuePos;
+		BX_ALIGN_DECL_CACHE_LINE(volatile uint32_t) m_dequeuePos;
+	};
+
+	///
+	template <typename Ty>
+	class MpMcBoundedQueueT
+	{
+		BX_CLASS(MpMcBoundedQueueT
+			, NO_DEFAULT_CTOR
+			, NO_COPY
+			);
+
+	public:
+		///
+		MpMcBoundedQueueT(AllocatorI* _allocator, uint32_t _capacity);
+
+		///
+		~MpMcBoundedQueueT();
+
+		///
+		uint32_t getCapacity() const;
+
+		///
+		bool tryPush(Ty* _ptr);
+
+		///
+		uint32_t tryPush(Ty* const* _ptrs, uint32_t _num);
+
+		///
+		Ty* tryPop();
+
+		///
+		uint32_t tryPop(Ty** _ptrs, uint32_t _max);
+
+	private:
+		MpMcBoundedQueue m_queue;
+	};
+
+} // namespace bx
+
+#include "inline/mpmcqueue.inl"
+
+#endif // BX_MPMCQUEUE_H_HEADER_GUARD
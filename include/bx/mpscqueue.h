@@ -42,6 +42,55 @@ namespace bx
 		SpScUnboundedQueueT<Ty> m_queue;
 	};
 
+	/// Unbounded multi-producer single-consumer queue. Producers are lock-free, push is single
+	/// atomic exchange.
+	///
+	/// Until producer links its node, consumer might see queue as ending before items pushed
+	/// by other producers after it. Items from each producer are popped in the order they were
+	/// pushed.
+	///
+	/// @remark Allocator must be thread safe, since nodes are allocated by producers and freed by
+	///   consumer.
+	///
+	template <typename Ty>
+	class MpScUnboundedLockFreeQueueT
+	{
+		BX_CLASS(MpScUnboundedLockFreeQueueT
+			, NO_DEFAULT_CTOR
+			, NO_COPY
+			);
+
+	public:
+		///
+		MpScUnboundedLockFreeQueueT(AllocatorI* _allocator);
+
+		///
+		~MpScUnboundedLockFreeQueueT();
+
+		///
+		void push(Ty* _ptr); // producer only
+
+		///
+		Ty* peek(); // consumer only
+
+		///
+		Ty* pop(); // consumer only
+
+	private:
+		struct Node
+		{
+			///
+			Node(Ty* _ptr);
+
+			Ty* m_ptr;
+			Node* volatile m_next;
+		};
+
+		AllocatorI* m_allocator;
+		Node* volatile m_head;
+		Node* m_tail;
+	};
+
 	///
 	template <typename Ty>
 	class MpScUnboundedBlockingQueue
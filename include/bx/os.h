@@ -18,6 +18,21 @@
 
 namespace bx
 {
+	/// Virtual memory page protection.
+	struct PageProtect
+	{
+		enum Enum
+		{
+			None,
+			Read,
+			ReadWrite,
+			ReadExecute,
+			ReadWriteExecute,
+
+			Count
+		};
+	};
+
 	///
 	void sleep(uint32_t _ms);
 
@@ -30,6 +45,34 @@ namespace bx
 	///
 	size_t getProcessMemoryUsed();
 
+	/// Returns number of logical processors available to process.
+	uint32_t getNumCpus();
+
+	/// Returns virtual memory page size.
+	size_t getPageSize();
+
+	/// Reserve range of virtual address space without backing it with physical memory. Size is
+	/// rounded up to page size. When `_hugePages` is set, OS is hinted to back range with
+	/// transparent huge pages, once it's committed.
+	///
+	/// @returns Pointer to reserved range, or NULL if reservation failed.
+	///
+	void* virtualReserve(size_t _size, bool _hugePages = false);
+
+	/// Commit pages in reserved range for read and write access. Pointer and size must be page
+	/// aligned.
+	bool virtualCommit(void* _ptr, size_t _size);
+
+	/// Decommit pages in reserved range, and return physical memory to OS. Range stays reserved.
+	/// Pointer and size must be page aligned.
+	void virtualDecommit(void* _ptr, size_t _size);
+
+	/// Change protection of committed pages. Pointer and size must be page aligned.
+	bool virtualProtect(void* _ptr, size_t _size, PageProtect::Enum _protect);
+
+	/// Release reserved range. Pointer and size must match ones used with `virtualReserve`.
+	void virtualRelease(void* _ptr, size_t _size);
+
 	///
 	void* dlopen(const FilePath& _filePath);
 
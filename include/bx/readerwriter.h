@@ -152,7 +152,8 @@ namespace bx
 		uint32_t m_size;
 	};
 
-	/// Memory block.
+	/// Memory block. Block grows geometrically, so that growing it by small amounts doesn't
+	/// reallocate, and copy, each time.
 	class MemoryBlock : public MemoryBlockI
 	{
 	public:
@@ -162,7 +163,7 @@ namespace bx
 		///
 		virtual ~MemoryBlock();
 
-		///
+		/// Grow block by at least `_size` bytes.
 		virtual void* more(uint32_t _size = 0) override;
 
 		///
@@ -174,6 +175,77 @@ namespace bx
 		uint32_t    m_size;
 	};
 
+	/// Chunked memory block. Memory is allocated in chunks that are never moved, so growing block
+	/// doesn't copy data, and block can be larger than 4GiB. Chunk sizes double with each growth.
+	///
+	/// @remark Memory is not contiguous, use `gather` or `flatten` to obtain its content.
+	///
+	class ChunkedMemoryBlock
+	{
+		BX_CLASS(ChunkedMemoryBlock
+			, NO_DEFAULT_CTOR
+			, NO_COPY
+			);
+
+	public:
+		///
+		ChunkedMemoryBlock(AllocatorI* _allocator, uint32_t _chunkSize = 64<<10);
+
+		///
+		~ChunkedMemoryBlock();
+
+		/// Resize block. Memory is allocated when block grows, and it's kept when it shrinks.
+		///
+		/// @returns True if block was resized to `_size`, otherwise block is resized to as much
+		///   memory as it was possible to allocate.
+		///
+		bool resize(int64_t _size);
+
+		/// Returns block size.
+		int64_t getSize() const;
+
+		/// Returns number of allocated bytes.
+		int64_t getCapacity() const;
+
+		/// Returns pointer at `_offset` within block, and number of contiguous bytes available from
+		/// it in `_outSize`.
+		void* getPtr(int64_t _offset, uint32_t* _outSize) const;
+
+		/// Returns number of chunks.
+		uint32_t getNumChunks() const;
+
+		/// Returns pointer to chunk data, and number of used bytes in chunk in `_outSize`.
+		const void* getChunk(uint32_t _idx, uint32_t* _outSize) const;
+
+		/// Write content of block into writer.
+		int64_t gather(WriterI* _writer, Error* _err) const;
+
+		/// Copy up to `_size` bytes of block content into contiguous memory.
+		int64_t flatten(void* _data, int64_t _size) const;
+
+	private:
+		struct Chunk
+		{
+			uint8_t* data;
+			int64_t  offset;
+			uint32_t size;
+		};
+
+		///
+		bool grow();
+
+		///
+		uint32_t findChunk(int64_t _offset) const;
+
+		AllocatorI* m_allocator;
+		Chunk*      m_chunk;
+		int64_t     m_size;
+		int64_t     m_capacity;
+		uint32_t    m_num;
+		uint32_t    m_max;
+		uint32_t    m_chunkSize;
+	};
+
 	/// Sizer writer. Dummy writer that only counts number of bytes written into it.
 	class SizerWriter : public WriterSeekerI
 	{
@@ -250,6 +322,27 @@ namespace bx
 		int64_t  m_size;
 	};
 
+	/// Chunked memory block writer.
+	class ChunkedMemoryWriter : public WriterSeekerI
+	{
+	public:
+		///
+		ChunkedMemoryWriter(ChunkedMemoryBlock* _memBlock);
+
+		///
+		virtual ~ChunkedMemoryWriter();
+
+		///
+		virtual int64_t seek(int64_t _offset = 0, Whence::Enum _whence = Whence::Current) override;
+
+		///
+		virtual int32_t write(const void* _data, int32_t _size, Error* _err) override;
+
+	private:
+		ChunkedMemoryBlock* m_memBlock;
+		int64_t m_pos;
+	};
+
 	/// Static (fixed size) memory block writer.
 	class StaticMemoryBlockWriter : public MemoryWriter
 	{
@@ -0,0 +1,159 @@
+/*
+ * Copyright 2010-2023 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bx/blob/master/LICENSE
+ */
+
+#ifndef BX_RWLOCK_H_HEADER_GUARD
+#define BX_RWLOCK_H_HEADER_GUARD
+
+#include "cpu.h"
+#include "typetraits.h"
+
+namespace bx
+{
+	/// Reader-writer lock. Multiple readers can hold lock at the same time, writer holds it
+	/// exclusively. Lock is not recursive.
+	///
+	/// Futex implementation prefers writers, new readers wait while writer is waiting, so that
+	/// frequent readers can't starve writer. Other platforms use native reader-writer lock.
+	///
+	class RwLock
+	{
+		BX_CLASS(RwLock
+			, NO_COPY
+			);
+
+	public:
+		///
+		RwLock();
+
+		///
+		~RwLock();
+
+		///
+		void readLock();
+
+		///
+		void readUnlock();
+
+		///
+		void writeLock();
+
+		///
+		void writeUnlock();
+
+	private:
+		BX_ALIGN_DECL(16, uint8_t) m_internal[64];
+	};
+
+	///
+	class RwLockReadScope
+	{
+		BX_CLASS(RwLockReadScope
+			, NO_DEFAULT_CTOR
+			, NO_COPY
+			);
+
+	public:
+		///
+		RwLockReadScope(RwLock& _lock);
+
+		///
+		~RwLockReadScope();
+
+	private:
+		RwLock& m_lock;
+	};
+
+	///
+	class RwLockWriteScope
+	{
+		BX_CLASS(RwLockWriteScope
+			, NO_DEFAULT_CTOR
+			, NO_COPY
+			);
+
+	public:
+		///
+		RwLockWriteScope(RwLock& _lock);
+
+		///
+		~RwLockWriteScope();
+
+	private:
+		RwLock& m_lock;
+	};
+
+	/// Sequence lock. Writer increments sequence before and after modifying data, and reader
+	/// retries when sequence was odd, or changed while it was reading. Readers never write
+	/// shared memory, so they don't contend with each other, but they might have to retry while
+	/// writer is active. Writers are serialized with each other.
+	///
+	/// Usage:
+	///
+	///     uint32_t seq;
+	///     do
+	///     {
+	///         seq  = lock.readBegin();
+	///         copy = data;
+	///     } while (lock.readRetry(seq) );
+	///
+	class SeqLock
+	{
+		BX_CLASS(SeqLock
+			, NO_COPY
+			);
+
+	public:
+		///
+		SeqLock();
+
+		/// Returns sequence, waits while writer is active.
+		uint32_t readBegin() const;
+
+		/// Returns true if data read since `readBegin` might be inconsistent.
+		bool readRetry(uint32_t _sequence) const;
+
+		///
+		void writeBegin();
+
+		///
+		void writeEnd();
+
+	private:
+		volatile uint32_t m_sequence;
+	};
+
+	/// Small trivially copyable value protected by sequence lock. Reads return consistent copy
+	/// of value.
+	///
+	template<typename Ty>
+	class SeqLockT
+	{
+		BX_CLASS(SeqLockT
+			, NO_COPY
+			);
+
+	public:
+		///
+		SeqLockT();
+
+		///
+		SeqLockT(const Ty& _value);
+
+		///
+		Ty read() const;
+
+		///
+		void write(const Ty& _value);
+
+	private:
+		SeqLock m_lock;
+		Ty      m_value;
+	};
+
+} // namespace bx
+
+#include "inline/rwlock.inl"
+
+#endif // BX_RWLOCK_H_HEADER_GUARD
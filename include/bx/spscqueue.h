@@ -81,6 +81,141 @@ namespace bx
 		SpScUnboundedQueue m_queue;
 	};
 
+	/// Unbounded single-producer single-consumer queue made of fixed-size chunks. Chunks that
+	/// consumer is done with are reused by producer, so after warm-up push and pop don't
+	/// allocate.
+	///
+	class SpScUnboundedChunkedQueue
+	{
+		BX_CLASS(SpScUnboundedChunkedQueue
+			, NO_DEFAULT_CTOR
+			, NO_COPY
+			);
+
+	public:
+		///
+		SpScUnboundedChunkedQueue(AllocatorI* _allocator, uint32_t _chunkSize = 1024);
+
+		///
+		~SpScUnboundedChunkedQueue();
+
+		///
+		void push(void* _ptr); // producer only
+
+		///
+		void* peek(); // consumer only
+
+		///
+		void* pop(); // consumer only
+
+	private:
+		struct Chunk
+		{
+			Chunk* volatile m_next;
+			volatile uint32_t m_num;
+		};
+
+		///
+		Chunk* allocChunk();
+
+		///
+		void** getPtrs(Chunk* _chunk) const;
+
+		///
+		bool isEmpty();
+
+		AllocatorI* m_allocator;
+		uint32_t m_chunkSize;
+
+		Chunk* m_first;
+		Chunk* m_write;
+		uint32_t m_writePos;
+
+		BX_ALIGN_DECL_CACHE_LINE(Chunk* volatile) m_read;
+		uint32_t m_readPos;
+		uint32_t m_readNum;
+	};
+
+	///
+	template<typename Ty>
+	class SpScUnboundedChunkedQueueT
+	{
+		BX_CLASS(SpScUnboundedChunkedQueueT
+			, NO_DEFAULT_CTOR
+			, NO_COPY
+			);
+
+	public:
+		///
+		SpScUnboundedChunkedQueueT(AllocatorI* _allocator, uint32_t _chunkSize = 1024);
+
+		///
+		~SpScUnboundedChunkedQueueT();
+
+		///
+		void push(Ty* _ptr); // producer only
+
+		///
+		Ty* peek(); // consumer only
+
+		///
+		Ty* pop(); // consumer only
+
+	private:
+		SpScUnboundedChunkedQueue m_queue;
+	};
+
+	/// Bounded single-producer single-consumer ring of values. Producer and consumer positions
+	/// are on separate cache lines, and each side keeps cached copy of other side's position, so
+	/// shared position is loaded only when cached one says queue is full or empty.
+	///
+	/// @remark Values are copied with memCopy, `Ty` must be trivially copyable.
+	///
+	template<typename Ty>
+	class SpScBoundedQueueT
+	{
+		BX_CLASS(SpScBoundedQueueT
+			, NO_DEFAULT_CTOR
+			, NO_COPY
+			);
+
+	public:
+		/// Capacity is rounded up to power of 2.
+		SpScBoundedQueueT(AllocatorI* _allocator, uint32_t _capacity);
+
+		///
+		~SpScBoundedQueueT();
+
+		///
+		uint32_t getCapacity() const;
+
+		/// Returns false if queue is full.
+		bool push(const Ty& _value); // producer only
+
+		/// Pushes up to `_num` values, returns number of values pushed.
+		uint32_t pushN(const Ty* _values, uint32_t _num); // producer only
+
+		/// Returns NULL if queue is empty.
+		const Ty* peek(); // consumer only
+
+		/// Returns false if queue is empty.
+		bool pop(Ty& _value); // consumer only
+
+		/// Pops up to `_max` values, returns number of values popped.
+		uint32_t popN(Ty* _values, uint32_t _max); // consumer only
+
+	private:
+		AllocatorI* m_allocator;
+		Ty* m_values;
+		uint32_t m_mask;
+
+		BX_ALIGN_DECL_CACHE_LINE(volatile uint32_t) m_write;
+		uint32_t m_readCache;
+
+		BX_ALIGN_DECL_CACHE_LINE(volatile uint32_t) m_read;
+		uint32_t m_writeCache;
+	};
+
 #if BX_CONFIG_SUPPORTS_THREADING
 	///
 	class SpScBlockingUnboundedQueue
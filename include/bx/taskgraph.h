@@ -0,0 +1,111 @@
+/*
+ * Copyright 2010-2023 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bx/blob/master/LICENSE
+ */
+
+#ifndef BX_TASK_GRAPH_H_HEADER_GUARD
+#define BX_TASK_GRAPH_H_HEADER_GUARD
+
+#include "handlealloc.h"
+#include "jobsystem.h"
+
+#if BX_CONFIG_SUPPORTS_THREADING
+
+namespace bx
+{
+	/// Directed acyclic graph of tasks, declared once and executed many times. Task runs when
+	/// all of its predecessors are done, tracked with atomic predecessor count per task.
+	///
+	/// Each task has priority equal to cost of the longest path from task to the end of graph
+	/// (critical path). Roots are started, and ready successors are scheduled, in priority order.
+	/// Thread that finishes task continues with its highest priority ready successor, and
+	/// other ready successors are added to job system.
+	///
+	class TaskGraph
+	{
+		BX_CLASS(TaskGraph
+			, NO_DEFAULT_CTOR
+			, NO_COPY
+			);
+
+	public:
+		/// Create task graph.
+		///
+		/// @param[in] _allocator Allocator.
+		/// @param[in] _maxTasks Maximum number of tasks.
+		/// @param[in] _maxEdges Maximum number of edges.
+		///
+		TaskGraph(AllocatorI* _allocator, uint32_t _maxTasks = 256, uint32_t _maxEdges = 1024);
+
+		///
+		~TaskGraph();
+
+		/// Add task.
+		///
+		/// @param[in] _fn Task function.
+		/// @param[in] _userData User data passed to task function.
+		/// @param[in] _cost Estimated cost of task, used to find critical path.
+		/// @returns Task index, or `kInvalidHandle` when graph is full.
+		///
+		uint16_t add(JobFn _fn, void* _userData, uint32_t _cost = 1);
+
+		/// Add edge, task `_to` runs after task `_from` is done.
+		///
+		/// @returns False when graph is full.
+		///
+		bool addEdge(uint16_t _from, uint16_t _to);
+
+		/// Remove all tasks and edges.
+		void reset();
+
+		///
+		uint16_t getNumTasks() const;
+
+		/// Returns cost of the longest path from task to the end of graph.
+		uint32_t getPriority(uint16_t _task);
+
+		/// Execute graph, and wait for all tasks to finish. Graph is prepared on first run after
+		/// it's modified, following runs only reset predecessor counts. Graph must not be
+		/// modified, or executed from other thread, while it's executing.
+		///
+		/// @param[in] _jobSystem Job system. When NULL, tasks run on calling thread in
+		///   dependency order.
+		/// @returns False when graph has cycle, in that case no task is executed.
+		///
+		bool run(JobSystem* _jobSystem);
+
+	private:
+		struct Task;
+		struct Edge;
+
+		///
+		void compile();
+
+		///
+		static void taskFn(void* _userData);
+
+		///
+		void execute(Task* _task);
+
+		AllocatorI* m_allocator;
+		JobSystem*  m_jobSystem;
+		Task*       m_tasks;
+		Edge*       m_edges;
+		uint16_t*   m_successors;
+		uint16_t*   m_roots;
+		uint16_t*   m_order;
+		uint32_t    m_maxTasks;
+		uint32_t    m_maxEdges;
+		uint16_t    m_numTasks;
+		uint16_t    m_numRoots;
+		uint16_t    m_numOrdered;
+		uint32_t    m_numEdges;
+		bool        m_dirty;
+		JobCounter  m_counter;
+	};
+
+} // namespace bx
+
+#endif // BX_CONFIG_SUPPORTS_THREADING
+
+#endif // BX_TASK_GRAPH_H_HEADER_GUARD
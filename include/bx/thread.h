@@ -16,6 +16,22 @@ namespace bx
 	///
 	typedef int32_t (*ThreadFn)(class Thread* _self, void* _userData);
 
+	/// Thread scheduling priority.
+	struct ThreadPriority
+	{
+		enum Enum
+		{
+			Idle,
+			Lowest,
+			Low,
+			Normal,
+			High,
+			Highest,
+
+			Count
+		};
+	};
+
 	///
 	class Thread
 	{
@@ -37,9 +53,20 @@ namespace bx
 		/// @param[in] _stackSize Stack size, if zero is passed it will use OS default thread stack
 		///   size.
 		/// @param[in] _name Thread name used by debugger.
-		/// @returns True if thread is created, otherwise returns false.
+		/// @param[in] _affinityMask Logical CPUs thread can run on, one bit per CPU, see
+		///   `CpuTopology`. When zero, thread can run on any CPU.
+		/// @param[in] _priority Scheduling priority.
+		/// @returns True if thread is created, otherwise returns false. Failing to set affinity,
+		///   or priority, doesn't fail thread creation.
 		///
-		bool init(ThreadFn _fn, void* _userData = NULL, uint32_t _stackSize = 0, const char* _name = NULL);
+		bool init(
+			  ThreadFn _fn
+			, void* _userData = NULL
+			, uint32_t _stackSize = 0
+			, const char* _name = NULL
+			, uint64_t _affinityMask = 0
+			, ThreadPriority::Enum _priority = ThreadPriority::Normal
+			);
 
 		///
 		void shutdown();
@@ -53,6 +80,20 @@ namespace bx
 		///
 		void setThreadName(const char* _name);
 
+		/// Set logical CPUs thread can run on.
+		///
+		/// @param[in] _mask Affinity mask, one bit per logical CPU.
+		/// @returns True if affinity is set. Not supported on all platforms.
+		///
+		bool setAffinity(uint64_t _mask);
+
+		/// Set thread scheduling priority.
+		///
+		/// @returns True if priority is set. Raising priority above normal might require
+		///   elevated privileges.
+		///
+		bool setPriority(ThreadPriority::Enum _priority);
+
 		///
 		void push(void* _ptr);
 
@@ -94,6 +135,86 @@ namespace bx
 		BX_ALIGN_DECL(16, uint8_t) m_internal[64];
 	};
 
+	/// Per-thread cache statistics.
+	struct ThreadCacheStats
+	{
+		uint32_t tid;        //!< Id of thread owning the cache.
+		uint64_t numHits;    //!< Number of allocations served from thread cache.
+		uint64_t numMisses;  //!< Number of allocations that had to refill thread cache.
+		uint64_t numFlushes; //!< Number of times thread cache was flushed to shared depot.
+	};
+
+	/// Allocator front-end keeping per-thread magazines of small size classes. Magazines are
+	/// refilled from, and flushed to, shared depot in batches, so only one in many small
+	/// allocations takes a lock. Large, and over-aligned allocations are passed to backing
+	/// allocator.
+	///
+	/// @remark Threads that allocate from allocator, and exit before it's destroyed, should call
+	///   `releaseThreadCache` before exiting, otherwise memory in their cache can't be reused
+	///   until allocator is destroyed.
+	///
+	class ThreadCachingAllocator : public AllocatorI
+	{
+		BX_CLASS(ThreadCachingAllocator
+			, NO_DEFAULT_CTOR
+			, NO_COPY
+			);
+
+	public:
+		///
+		ThreadCachingAllocator(AllocatorI* _allocator);
+
+		///
+		virtual ~ThreadCachingAllocator();
+
+		///
+		virtual void* realloc(
+			  void* _ptr
+			, size_t _size
+			, size_t _align
+			, const char* _file
+			, uint32_t _line
+			) override;
+
+		/// Fill per-thread cache statistics.
+		///
+		/// @param[out] _outStats Statistics, one per thread cache.
+		/// @param[in] _max Maximum number of stats to write.
+		/// @returns Number of thread caches.
+		///
+		uint32_t getStats(ThreadCacheStats* _outStats, uint32_t _max);
+
+		/// Return memory cached by calling thread to shared depot, and free its cache. Thread
+		/// gets new cache on next allocation.
+		///
+		void releaseThreadCache();
+
+	private:
+		struct ThreadCache;
+
+		///
+		ThreadCache* getThreadCache();
+
+		///
+		void* alloc(size_t _size, size_t _align, const char* _file, uint32_t _line);
+
+		///
+		void free(void* _ptr, const char* _file, uint32_t _line);
+
+		///
+		void refill(ThreadCache* _cache, uint32_t _sizeClass);
+
+		///
+		void flush(ThreadCache* _cache, uint32_t _sizeClass);
+
+		AllocatorI*  m_allocator;
+		TlsData      m_tls;
+		Mutex        m_lock;
+		ThreadCache* m_cache;
+		void*        m_chunk;
+		void*        m_depot[8];
+	};
+
 } // namespace bx
 
 #endif
@@ -0,0 +1,108 @@
+/*
+ * Copyright 2010-2023 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bx/blob/master/LICENSE
+ */
+
+#ifndef BX_WORK_STEALING_DEQUE_H_HEADER_GUARD
+#define BX_WORK_STEALING_DEQUE_H_HEADER_GUARD
+
+#include "allocator.h"
+#include "cpu.h"
+#include "uint32_t.h"
+
+namespace bx
+{
+	/// Lock-free work-stealing deque (Chase-Lev). Owner thread pushes and pops at the bottom,
+	/// other threads steal from the top. Circular array grows when full.
+	///
+	/// @remark Deque stores pointers, and NULL is returned when there is nothing to pop or
+	///   steal, so NULL can't be pushed.
+	///
+	class WorkStealingDeque
+	{
+		BX_CLASS(WorkStealingDeque
+			, NO_DEFAULT_CTOR
+			, NO_COPY
+			);
+
+	public:
+		/// Capacity is rounded up to power of 2.
+		WorkStealingDeque(AllocatorI* _allocator, uint32_t _capacity = 256);
+
+		///
+		~WorkStealingDeque();
+
+		/// Returns approximate number of items, exact only when called by owner while no thief
+		/// is stealing.
+		uint32_t getNumItems() const;
+
+		///
+		void push(void* _ptr); // owner only
+
+		/// Returns most recently pushed item, or NULL if deque is empty.
+		void* pop(); // owner only
+
+		/// Returns least recently pushed item. Returns NULL if deque is empty, or if other thief
+		/// or owner took the item first.
+		void* steal();
+
+	private:
+		struct Array
+		{
+			Array* m_prev;
+			int64_t m_mask;
+		};
+
+		///
+		Array* allocArray(int64_t _size);
+
+		///
+		void* volatile* getPtrs(Array* _array) const;
+
+		///
+		Array* grow(Array* _array, int64_t _bottom, int64_t _top);
+
+		AllocatorI* m_allocator;
+
+		BX_ALIGN_DECL_CACHE_LINE(volatile int64_t) m_top;
+		BX_ALIGN_DECL_CACHE_LINE(volatile int64_t) m_bottom;
+		Array* volatile m_array;
+	};
+
+	///
+	template<typename Ty>
+	class WorkStealingDequeT
+	{
+		BX_CLASS(WorkStealingDequeT
+			, NO_DEFAULT_CTOR
+			, NO_COPY
+			);
+
+	public:
+		///
+		WorkStealingDequeT(AllocatorI* _allocator, uint32_t _capacity = 256);
+
+		///
+		~WorkStealingDequeT();
+
+		///
+		uint32_t getNumItems() const;
+
+		///
+		void push(Ty* _ptr); // owner only
+
+		///
+		Ty* pop(); // owner only
+
+		///
+		Ty* steal();
+
+	private:
+		WorkStealingDeque m_deque;
+	};
+
+} // namespace bx
+
+#include "inline/workstealingdeque.inl"
+
+#endif // BX_WORK_STEALING_DEQUE_H_HEADER_GUARD
@@ -67,21 +67,26 @@ project "bx"
 			path.join(BX_DIR, "src/bounds.cpp"),
 			path.join(BX_DIR, "src/bx.cpp"),
 			path.join(BX_DIR, "src/commandline.cpp"),
+			path.join(BX_DIR, "src/cputopology.cpp"),
 			path.join(BX_DIR, "src/crtnone.cpp"),
 			path.join(BX_DIR, "src/debug.cpp"),
 			path.join(BX_DIR, "src/dtoa.cpp"),
 			path.join(BX_DIR, "src/easing.cpp"),
+			path.join(BX_DIR, "src/fiber.cpp"),
 			path.join(BX_DIR, "src/file.cpp"),
 			path.join(BX_DIR, "src/filepath.cpp"),
 			path.join(BX_DIR, "src/hash.cpp"),
+			path.join(BX_DIR, "src/jobsystem.cpp"),
 			path.join(BX_DIR, "src/math.cpp"),
 			path.join(BX_DIR, "src/mutex.cpp"),
 			path.join(BX_DIR, "src/os.cpp"),
 			path.join(BX_DIR, "src/process.cpp"),
+			path.join(BX_DIR, "src/rwlock.cpp"),
 			path.join(BX_DIR, "src/semaphore.cpp"),
 			path.join(BX_DIR, "src/settings.cpp"),
 			path.join(BX_DIR, "src/sort.cpp"),
 			path.join(BX_DIR, "src/string.cpp"),
+			path.join(BX_DIR, "src/taskgraph.cpp"),
 			path.join(BX_DIR, "src/thread.cpp"),
 			path.join(BX_DIR, "src/timer.cpp"),
 			path.join(BX_DIR, "src/url.cpp"),
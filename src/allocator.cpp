@@ -4,7 +4,12 @@
  */
 
 #include <bx/allocator.h>
+#include <bx/cpu.h>
+#include <bx/file.h>
+#include <bx/os.h>
+#include <bx/sort.h>
 
+#include <inttypes.h> // PRIu64
 #include <malloc.h>
 
 #ifndef BX_CONFIG_ALLOCATOR_NATURAL_ALIGNMENT
@@ -71,4 +76,1653 @@ namespace bx
 #	endif // BX_
 	}
 
+	struct LinearAllocator::Chunk
+	{
+		uint8_t* getData()
+		{
+			return (uint8_t*)this + sizeof(Chunk);
+		}
+
+		Chunk* next;
+		size_t size;
+		size_t top;
+	};
+
+	LinearAllocator::LinearAllocator(AllocatorI* _allocator, size_t _chunkSize)
+		: m_allocator(_allocator)
+		, m_first(NULL)
+		, m_current(NULL)
+		, m_chunkSize(_chunkSize)
+		, m_last(SIZE_MAX)
+	{
+	}
+
+	LinearAllocator::~LinearAllocator()
+	{
+		for (Chunk* chunk = m_first; NULL != chunk;)
+		{
+			Chunk* next = chunk->next;
+			BX_FREE(m_allocator, chunk);
+			chunk = next;
+		}
+	}
+
+	void* LinearAllocator::realloc(void* _ptr, size_t _size, size_t _align, const char* _file, uint32_t _line)
+	{
+		BX_UNUSED(_file, _line);
+
+		const bool isLast = NULL != _ptr
+			&& SIZE_MAX != m_last
+			&& _ptr == &m_current->getData()[m_last]
+			;
+
+		if (0 == _size)
+		{
+			if (isLast)
+			{
+				m_current->top = m_last;
+				m_last = SIZE_MAX;
+			}
+
+			return NULL;
+		}
+		else if (NULL == _ptr)
+		{
+			return alloc(_size, _align);
+		}
+
+		if (isLast
+		&&  m_last + _size <= m_current->size)
+		{
+			m_current->top = m_last + _size;
+			return _ptr;
+		}
+
+		const size_t size = min(_size, getUsedSizeFrom(_ptr) );
+
+		void* ptr = alloc(_size, _align);
+		if (NULL != ptr)
+		{
+			memCopy(ptr, _ptr, size);
+		}
+
+		return ptr;
+	}
+
+	void LinearAllocator::reset()
+	{
+		m_current = m_first;
+		m_last    = SIZE_MAX;
+
+		if (NULL != m_current)
+		{
+			m_current->top = 0;
+		}
+	}
+
+	LinearAllocator::Marker LinearAllocator::getMarker() const
+	{
+		Marker marker;
+		marker.chunk = m_current;
+		marker.top   = NULL != m_current ? m_current->top : 0;
+		return marker;
+	}
+
+	void LinearAllocator::rewind(const Marker& _marker)
+	{
+		if (NULL == _marker.chunk)
+		{
+			reset();
+			return;
+		}
+
+		m_current      = (Chunk*)_marker.chunk;
+		m_current->top = _marker.top;
+		m_last         = SIZE_MAX;
+	}
+
+	void LinearAllocator::trim()
+	{
+		if (NULL == m_current)
+		{
+			return;
+		}
+
+		for (Chunk* chunk = m_current->next; NULL != chunk;)
+		{
+			Chunk* next = chunk->next;
+			BX_FREE(m_allocator, chunk);
+			chunk = next;
+		}
+
+		m_current->next = NULL;
+	}
+
+	size_t LinearAllocator::getUsedSize() const
+	{
+		size_t used = 0;
+
+		if (NULL != m_current)
+		{
+			for (const Chunk* chunk = m_first; chunk != m_current; chunk = chunk->next)
+			{
+				used += chunk->top;
+			}
+
+			used += m_current->top;
+		}
+
+		return used;
+	}
+
+	void* LinearAllocator::alloc(size_t _size, size_t _align)
+	{
+		const size_t align = max(_align, size_t(BX_CONFIG_ALLOCATOR_NATURAL_ALIGNMENT) );
+
+		Chunk* chunk = m_current;
+
+		for (uint32_t ii = 0; ii < 2 && NULL != chunk; ++ii, chunk = chunk->next)
+		{
+			if (chunk != m_current)
+			{
+				chunk->top = 0;
+			}
+
+			const uintptr_t data   = uintptr_t(chunk->getData() );
+			const size_t    offset = alignUp(data + chunk->top, int32_t(align) ) - data;
+
+			if (offset + _size <= chunk->size)
+			{
+				m_current  = chunk;
+				m_last     = offset;
+				chunk->top = offset + _size;
+				return &chunk->getData()[offset];
+			}
+		}
+
+		const size_t size = max(m_chunkSize, _size + align);
+		chunk = (Chunk*)BX_ALLOC(m_allocator, sizeof(Chunk) + size);
+
+		if (NULL == chunk)
+		{
+			return NULL;
+		}
+
+		chunk->size = size;
+		chunk->top  = 0;
+
+		if (NULL == m_current)
+		{
+			chunk->next = m_first;
+			m_first     = chunk;
+		}
+		else
+		{
+			chunk->next = m_current->next;
+			m_current->next = chunk;
+		}
+
+		const uintptr_t data   = uintptr_t(chunk->getData() );
+		const size_t    offset = alignUp(data, int32_t(align) ) - data;
+
+		m_current  = chunk;
+		m_last     = offset;
+		chunk->top = offset + _size;
+		return &chunk->getData()[offset];
+	}
+
+	size_t LinearAllocator::getUsedSizeFrom(const void* _ptr) const
+	{
+		const uint8_t* ptr = (const uint8_t*)_ptr;
+
+		for (Chunk* chunk = m_first; NULL != chunk; chunk = chunk->next)
+		{
+			const uint8_t* data = chunk->getData();
+
+			if (data <= ptr
+			&&  ptr  <  data + chunk->top)
+			{
+				return size_t(data + chunk->top - ptr);
+			}
+
+			if (chunk == m_current)
+			{
+				break;
+			}
+		}
+
+		return 0;
+	}
+
+	static constexpr size_t kArenaNone = SIZE_MAX;
+
+	VirtualArenaAllocator::VirtualArenaAllocator(size_t _reserveSize, size_t _commitSize, bool _hugePages)
+		: m_data(NULL)
+		, m_reserved(0)
+		, m_committed(0)
+		, m_commitSize(0)
+		, m_top(0)
+		, m_last(kArenaNone)
+	{
+		const size_t pageSize = getPageSize();
+
+		m_reserved   = (_reserveSize + pageSize - 1) & ~(pageSize - 1);
+		m_commitSize = max( (_commitSize + pageSize - 1) & ~(pageSize - 1), pageSize);
+		m_data       = (uint8_t*)virtualReserve(m_reserved, _hugePages);
+
+		BX_WARN(NULL != m_data, "VirtualArenaAllocator: Failed to reserve %zu bytes.", m_reserved);
+
+		if (NULL == m_data)
+		{
+			m_reserved = 0;
+		}
+	}
+
+	VirtualArenaAllocator::~VirtualArenaAllocator()
+	{
+		virtualRelease(m_data, m_reserved);
+	}
+
+	bool VirtualArenaAllocator::commit(size_t _size)
+	{
+		if (_size <= m_committed)
+		{
+			return true;
+		}
+
+		if (_size > m_reserved)
+		{
+			return false;
+		}
+
+		const size_t committed = min( (_size + m_commitSize - 1) / m_commitSize * m_commitSize, m_reserved);
+
+		if (!virtualCommit(m_data + m_committed, committed - m_committed) )
+		{
+			return false;
+		}
+
+		m_committed = committed;
+
+		return true;
+	}
+
+	void* VirtualArenaAllocator::realloc(void* _ptr, size_t _size, size_t _align, const char* _file, uint32_t _line)
+	{
+		BX_UNUSED(_file, _line);
+
+		const size_t offset = NULL == _ptr ? kArenaNone : size_t( (uint8_t*)_ptr - m_data);
+
+		if (0 == _size)
+		{
+			if (offset == m_last)
+			{
+				m_top  = m_last - sizeof(size_t);
+				m_last = kArenaNone;
+			}
+
+			return NULL;
+		}
+
+		if (offset == m_last
+		&&  offset != kArenaNone)
+		{
+			// Most recent allocation is resized in place.
+			if (!commit(offset + _size) )
+			{
+				return NULL;
+			}
+
+			*( (size_t*)_ptr - 1) = _size;
+			m_top = offset + _size;
+
+			return _ptr;
+		}
+
+		const size_t align = max(_align, sizeof(size_t) );
+		const size_t start = (m_top + sizeof(size_t) + align - 1) & ~(align - 1);
+
+		if (start + _size < start
+		||  !commit(start + _size) )
+		{
+			return NULL;
+		}
+
+		uint8_t* ptr = m_data + start;
+		*( (size_t*)ptr - 1) = _size;
+
+		if (NULL != _ptr)
+		{
+			memCopy(ptr, _ptr, min(_size, *( (size_t*)_ptr - 1) ) );
+		}
+
+		m_top  = start + _size;
+		m_last = start;
+
+		return ptr;
+	}
+
+	void VirtualArenaAllocator::reset()
+	{
+		m_top  = 0;
+		m_last = kArenaNone;
+	}
+
+	void VirtualArenaAllocator::trim()
+	{
+		const size_t committed = (m_top + m_commitSize - 1) / m_commitSize * m_commitSize;
+
+		if (committed < m_committed)
+		{
+			virtualDecommit(m_data + committed, m_committed - committed);
+			m_committed = committed;
+		}
+	}
+
+	size_t VirtualArenaAllocator::getUsedSize() const
+	{
+		return m_top;
+	}
+
+	size_t VirtualArenaAllocator::getCommittedSize() const
+	{
+		return m_committed;
+	}
+
+	size_t VirtualArenaAllocator::getReservedSize() const
+	{
+		return m_reserved;
+	}
+
+	static constexpr uint32_t kPoolSlabAlign = 64;
+
+	static uint32_t getPoolStride(uint32_t _blockSize)
+	{
+		return alignUp(max(_blockSize, uint32_t(sizeof(void*) ) ), BX_CONFIG_ALLOCATOR_NATURAL_ALIGNMENT);
+	}
+
+	static uint32_t getPoolBlockAlign(uint32_t _stride)
+	{
+		return min(UINT32_C(1) << uint32_cnttz(_stride), kPoolSlabAlign);
+	}
+
+	struct PoolAllocator::Slab
+	{
+		Slab* next;
+	};
+
+	PoolAllocator::PoolAllocator(AllocatorI* _allocator, uint32_t _blockSize, uint32_t _blocksPerSlab)
+		: m_allocator(_allocator)
+		, m_slab(NULL)
+		, m_free(NULL)
+		, m_top(NULL)
+		, m_end(NULL)
+		, m_blockSize(_blockSize)
+		, m_blockAlign(getPoolBlockAlign(getPoolStride(_blockSize) ) )
+		, m_stride(getPoolStride(_blockSize) )
+		, m_blocksPerSlab(max(_blocksPerSlab, 1) )
+		, m_numBlocks(0)
+	{
+	}
+
+	PoolAllocator::~PoolAllocator()
+	{
+		BX_WARN(0 == m_numBlocks, "PoolAllocator: %d blocks are still allocated.", m_numBlocks);
+
+		for (Slab* slab = m_slab; NULL != slab;)
+		{
+			Slab* next = slab->next;
+			BX_FREE(m_allocator, slab);
+			slab = next;
+		}
+	}
+
+	void* PoolAllocator::realloc(void* _ptr, size_t _size, size_t _align, const char* _file, uint32_t _line)
+	{
+		BX_UNUSED(_file, _line);
+		BX_ASSERT(_size  <= m_blockSize,  "PoolAllocator: Size %d is larger than block size %d.", _size, m_blockSize);
+		BX_ASSERT(_align <= m_blockAlign, "PoolAllocator: Alignment %d is larger than block alignment %d.", _align, m_blockAlign);
+
+		if (0 == _size)
+		{
+			if (NULL != _ptr)
+			{
+				*(void**)_ptr = m_free;
+				m_free = _ptr;
+				--m_numBlocks;
+			}
+
+			return NULL;
+		}
+		else if (NULL != _ptr)
+		{
+			return _size <= m_blockSize ? _ptr : NULL;
+		}
+
+		if (_size  > m_blockSize
+		||  _align > m_blockAlign)
+		{
+			return NULL;
+		}
+
+		if (NULL != m_free)
+		{
+			void* ptr = m_free;
+			m_free = *(void**)ptr;
+			++m_numBlocks;
+			return ptr;
+		}
+
+		if (m_top == m_end)
+		{
+			const uint32_t size = m_stride*m_blocksPerSlab;
+			Slab* slab = (Slab*)BX_ALLOC(m_allocator, sizeof(Slab) + kPoolSlabAlign + size);
+
+			if (NULL == slab)
+			{
+				return NULL;
+			}
+
+			slab->next = m_slab;
+			m_slab = slab;
+
+			m_top = (uint8_t*)alignPtr(slab, sizeof(Slab), kPoolSlabAlign);
+			m_end = m_top + size;
+		}
+
+		void* ptr = m_top;
+		m_top += m_stride;
+		++m_numBlocks;
+		return ptr;
+	}
+
+	uint32_t PoolAllocator::getBlockSize() const
+	{
+		return m_blockSize;
+	}
+
+	uint32_t PoolAllocator::getBlockAlign() const
+	{
+		return m_blockAlign;
+	}
+
+	uint32_t PoolAllocator::getNumBlocks() const
+	{
+		return m_numBlocks;
+	}
+
+	// Free list head packs index of the first free block in low 32-bit, and ABA tag in
+	// high 32-bit, which is incremented on each update.
+	static constexpr uint64_t kPoolHeadTagInc = UINT64_C(1)<<32;
+	static constexpr uint64_t kPoolHeadTagMask = ~(kPoolHeadTagInc-1);
+
+	ConcurrentPoolAllocator::ConcurrentPoolAllocator(AllocatorI* _allocator, uint32_t _blockSize, uint32_t _blocksPerSlab)
+		: m_allocator(_allocator)
+		, m_blockSize(_blockSize)
+		, m_blockAlign(getPoolBlockAlign(getPoolStride(_blockSize) ) )
+		, m_stride(getPoolStride(_blockSize) )
+		, m_blocksPerSlab(max(_blocksPerSlab, 1) )
+		, m_numSlabs(0)
+		, m_numBlocks(0)
+		, m_head(UINT32_MAX)
+	{
+		memSet(m_slab, 0, sizeof(m_slab) );
+	}
+
+	ConcurrentPoolAllocator::~ConcurrentPoolAllocator()
+	{
+		BX_WARN(0 == m_numBlocks, "ConcurrentPoolAllocator: %d blocks are still allocated.", m_numBlocks);
+
+		for (uint32_t ii = 0, num = m_numSlabs; ii < num; ++ii)
+		{
+			BX_FREE(m_allocator, ( (void**)m_slab[ii])[-1]);
+		}
+	}
+
+	void* ConcurrentPoolAllocator::realloc(void* _ptr, size_t _size, size_t _align, const char* _file, uint32_t _line)
+	{
+		BX_UNUSED(_file, _line);
+		BX_ASSERT(_size  <= m_blockSize,  "ConcurrentPoolAllocator: Size %d is larger than block size %d.", _size, m_blockSize);
+		BX_ASSERT(_align <= m_blockAlign, "ConcurrentPoolAllocator: Alignment %d is larger than block alignment %d.", _align, m_blockAlign);
+
+		if (0 == _size)
+		{
+			if (NULL != _ptr)
+			{
+				const uint32_t index = getIndex(_ptr);
+				BX_ASSERT(UINT32_MAX != index, "ConcurrentPoolAllocator: Pointer %p is not allocated from this pool.", _ptr);
+
+				uint64_t oldHead;
+				uint64_t head = atomicLoad(&m_head);
+				do
+				{
+					oldHead = head;
+					atomicStore( (volatile uint32_t*)_ptr, uint32_t(oldHead) );
+					head = atomicCompareAndSwap<uint64_t>(&m_head, oldHead, ( (oldHead & kPoolHeadTagMask) + kPoolHeadTagInc) | index);
+
+				} while (oldHead != head);
+
+				atomicFetchAndSub<int32_t>(&m_numBlocks, 1);
+			}
+
+			return NULL;
+		}
+		else if (NULL != _ptr)
+		{
+			return _size <= m_blockSize ? _ptr : NULL;
+		}
+
+		if (_size  > m_blockSize
+		||  _align > m_blockAlign)
+		{
+			return NULL;
+		}
+
+		for (;;)
+		{
+			const uint64_t head  = atomicLoad(&m_head);
+			const uint32_t index = uint32_t(head);
+
+			if (UINT32_MAX == index)
+			{
+				if (!grow(head) )
+				{
+					return NULL;
+				}
+
+				continue;
+			}
+
+			// Block might be already popped, and written to by other thread, in which case next
+			// is garbage, but compare and swap fails since tag has changed.
+			uint8_t* block = getBlock(index);
+			const uint32_t next = atomicLoad( (const volatile uint32_t*)block);
+
+			if (head == atomicCompareAndSwap<uint64_t>(&m_head, head, ( (head & kPoolHeadTagMask) + kPoolHeadTagInc) | next) )
+			{
+				atomicFetchAndAdd<int32_t>(&m_numBlocks, 1);
+				return block;
+			}
+		}
+	}
+
+	uint32_t ConcurrentPoolAllocator::getBlockSize() const
+	{
+		return m_blockSize;
+	}
+
+	uint32_t ConcurrentPoolAllocator::getBlockAlign() const
+	{
+		return m_blockAlign;
+	}
+
+	uint32_t ConcurrentPoolAllocator::getNumBlocks() const
+	{
+		return uint32_t(atomicLoad(&m_numBlocks) );
+	}
+
+	bool ConcurrentPoolAllocator::grow(uint64_t _head)
+	{
+		MutexScope scope(m_lock);
+
+		if (_head != atomicLoad(&m_head) )
+		{
+			// Other thread already grew pool, or freed block.
+			return true;
+		}
+
+		const uint32_t slab = m_numSlabs;
+
+		if (slab == BX_COUNTOF(m_slab) )
+		{
+			return false;
+		}
+
+		const uint64_t first = uint64_t(m_blocksPerSlab) * ( (UINT64_C(1)<<slab) - 1);
+		const uint64_t num   = uint64_t(m_blocksPerSlab) << slab;
+
+		if (first + num >= UINT32_MAX)
+		{
+			return false;
+		}
+
+		const size_t size = size_t(num*m_stride);
+		void* ptr = BX_ALLOC(m_allocator, sizeof(void*) + kPoolSlabAlign + size);
+
+		if (NULL == ptr)
+		{
+			return false;
+		}
+
+		uint8_t* data = (uint8_t*)alignPtr(ptr, sizeof(void*), kPoolSlabAlign);
+		( (void**)data)[-1] = ptr;
+
+		for (uint32_t ii = 0, last = uint32_t(num-1); ii < last; ++ii)
+		{
+			*(uint32_t*)&data[ii*m_stride] = uint32_t(first + ii + 1);
+		}
+
+		m_slab[slab] = data;
+		atomicStore(&m_numSlabs, slab + 1);
+
+		volatile uint32_t* last = (volatile uint32_t*)&data[(num-1)*m_stride];
+
+		uint64_t oldHead;
+		uint64_t head = atomicLoad(&m_head);
+		do
+		{
+			oldHead = head;
+			atomicStore(last, uint32_t(oldHead) );
+			head = atomicCompareAndSwap<uint64_t>(&m_head, oldHead, ( (oldHead & kPoolHeadTagMask) + kPoolHeadTagInc) | uint32_t(first) );
+
+		} while (oldHead != head);
+
+		return true;
+	}
+
+	uint8_t* ConcurrentPoolAllocator::getBlock(uint32_t _index) const
+	{
+		const uint32_t slab  = 31 - uint32_cntlz(_index/m_blocksPerSlab + 1);
+		const uint32_t first = m_blocksPerSlab * ( (UINT32_C(1)<<slab) - 1);
+		return &m_slab[slab][(_index - first)*m_stride];
+	}
+
+	uint32_t ConcurrentPoolAllocator::getIndex(const void* _ptr) const
+	{
+		const uint8_t* ptr = (const uint8_t*)_ptr;
+
+		for (uint32_t slab = atomicLoad(&m_numSlabs); 0 < slab; --slab)
+		{
+			const uint8_t* data = m_slab[slab-1];
+			const uint32_t num  = m_blocksPerSlab << (slab-1);
+
+			if (data <= ptr
+			&&  ptr  <  data + size_t(num)*m_stride)
+			{
+				const uint32_t first = m_blocksPerSlab * ( (UINT32_C(1)<<(slab-1) ) - 1);
+				return first + uint32_t(size_t(ptr - data)/m_stride);
+			}
+		}
+
+		return UINT32_MAX;
+	}
+
+	// Two-Level Segregated Fit allocator, reference:
+	// http://www.gii.upv.es/tlsf/files/papers/ecrts04_tlsf.pdf
+	//
+	// First level bins are power of two size classes, and each of them is split linearly into
+	// 2^kTlsfSlLog2 second level bins. Bitmaps of non-empty bins are used to find suitable free
+	// block with few bit scans.
+	static constexpr uint32_t kTlsfAlignLog2 = 3;
+	static constexpr size_t   kTlsfAlign     = size_t(1)<<kTlsfAlignLog2;
+	static constexpr uint32_t kTlsfSlLog2    = 5;
+	static constexpr uint32_t kTlsfSlCount   = 1<<kTlsfSlLog2;
+	static constexpr uint32_t kTlsfFlMax     = BX_ARCH_64BIT ? 32 : 30;
+	static constexpr uint32_t kTlsfFlShift   = kTlsfSlLog2 + kTlsfAlignLog2;
+	static constexpr uint32_t kTlsfFlCount   = kTlsfFlMax - kTlsfFlShift + 1;
+	static constexpr size_t   kTlsfSmallSize = size_t(1)<<kTlsfFlShift;
+
+	// Block header. Previous physical block pointer is stored in last word of previous block, and
+	// it's valid only when previous block is free. Free list pointers are stored in block data, and
+	// they are valid only when block is free.
+	struct TlsfBlock
+	{
+		static constexpr size_t kFree     = 1;
+		static constexpr size_t kPrevFree = 2;
+
+		size_t getSize() const
+		{
+			return size & ~(kFree|kPrevFree);
+		}
+
+		void setSize(size_t _size)
+		{
+			size = _size | (size & (kFree|kPrevFree) );
+		}
+
+		bool isFree() const
+		{
+			return 0 != (size & kFree);
+		}
+
+		void setFree(bool _free)
+		{
+			size = _free ? size | kFree : size & ~kFree;
+		}
+
+		bool isPrevFree() const
+		{
+			return 0 != (size & kPrevFree);
+		}
+
+		void setPrevFree(bool _free)
+		{
+			size = _free ? size | kPrevFree : size & ~kPrevFree;
+		}
+
+		void* toPtr();
+
+		TlsfBlock* getNext();
+
+		TlsfBlock* linkNext()
+		{
+			TlsfBlock* next = getNext();
+			next->prevPhys = this;
+			return next;
+		}
+
+		void markAsFree()
+		{
+			TlsfBlock* next = linkNext();
+			next->setPrevFree(true);
+			setFree(true);
+		}
+
+		void markAsUsed()
+		{
+			TlsfBlock* next = getNext();
+			next->setPrevFree(false);
+			setFree(false);
+		}
+
+		TlsfBlock* prevPhys;
+		size_t     size;
+		TlsfBlock* nextFree;
+		TlsfBlock* prevFree;
+	};
+
+	static constexpr size_t kTlsfBlockOverhead = sizeof(size_t);
+	static constexpr size_t kTlsfBlockStart    = sizeof(TlsfBlock*) + sizeof(size_t);
+	static constexpr size_t kTlsfBlockSizeMin  = sizeof(TlsfBlock) - sizeof(TlsfBlock*);
+	static constexpr size_t kTlsfBlockSizeMax  = size_t(1)<<kTlsfFlMax;
+	static constexpr size_t kTlsfPoolOverhead  = 2*kTlsfBlockOverhead;
+
+	static TlsfBlock* tlsfOffsetToBlock(const void* _ptr, ptrdiff_t _offset)
+	{
+		return (TlsfBlock*)( (uintptr_t)_ptr + _offset);
+	}
+
+	static TlsfBlock* tlsfBlockFromPtr(const void* _ptr)
+	{
+		return tlsfOffsetToBlock(_ptr, -ptrdiff_t(kTlsfBlockStart) );
+	}
+
+	inline void* TlsfBlock::toPtr()
+	{
+		return (uint8_t*)this + kTlsfBlockStart;
+	}
+
+	inline TlsfBlock* TlsfBlock::getNext()
+	{
+		return tlsfOffsetToBlock(toPtr(), ptrdiff_t(getSize() - kTlsfBlockOverhead) );
+	}
+
+	static uint32_t tlsfFls(size_t _size)
+	{
+		return 63 - uint32_cntlz(uint64_t(_size) );
+	}
+
+	static void tlsfMappingInsert(size_t _size, uint32_t& _fl, uint32_t& _sl)
+	{
+		if (_size < kTlsfSmallSize)
+		{
+			_fl = 0;
+			_sl = uint32_t(_size / (kTlsfSmallSize / kTlsfSlCount) );
+		}
+		else
+		{
+			const uint32_t fl = tlsfFls(_size);
+			_sl = uint32_t(_size >> (fl - kTlsfSlLog2) ) ^ kTlsfSlCount;
+			_fl = fl - (kTlsfFlShift - 1);
+		}
+	}
+
+	static void tlsfMappingSearch(size_t _size, uint32_t& _fl, uint32_t& _sl)
+	{
+		// Round up to next bin, so that any block found in it is large enough.
+		if (_size >= kTlsfSmallSize)
+		{
+			_size += (size_t(1) << (tlsfFls(_size) - kTlsfSlLog2) ) - 1;
+		}
+
+		tlsfMappingInsert(_size, _fl, _sl);
+	}
+
+	static size_t tlsfAdjustRequestSize(size_t _size, size_t _align)
+	{
+		if (0 == _size)
+		{
+			return 0;
+		}
+
+		const size_t aligned = (_size + _align - 1) & ~(_align - 1);
+
+		return aligned < kTlsfBlockSizeMax
+			? max(aligned, kTlsfBlockSizeMin)
+			: 0
+			;
+	}
+
+	struct TlsfAllocator::Control
+	{
+		void init()
+		{
+			memSet(this, 0, sizeof(Control) );
+		}
+
+		void removeFree(TlsfBlock* _block, uint32_t _fl, uint32_t _sl)
+		{
+			TlsfBlock* prev = _block->prevFree;
+			TlsfBlock* next = _block->nextFree;
+
+			if (NULL != next)
+			{
+				next->prevFree = prev;
+			}
+
+			if (NULL != prev)
+			{
+				prev->nextFree = next;
+			}
+			else
+			{
+				blocks[_fl][_sl] = next;
+
+				if (NULL == next)
+				{
+					slBitmap[_fl] &= ~(UINT32_C(1) << _sl);
+
+					if (0 == slBitmap[_fl])
+					{
+						flBitmap &= ~(UINT32_C(1) << _fl);
+					}
+				}
+			}
+		}
+
+		void insertFree(TlsfBlock* _block, uint32_t _fl, uint32_t _sl)
+		{
+			TlsfBlock* head = blocks[_fl][_sl];
+			_block->nextFree = head;
+			_block->prevFree = NULL;
+
+			if (NULL != head)
+			{
+				head->prevFree = _block;
+			}
+
+			blocks[_fl][_sl] = _block;
+			flBitmap     |= UINT32_C(1) << _fl;
+			slBitmap[_fl] |= UINT32_C(1) << _sl;
+		}
+
+		void removeBlock(TlsfBlock* _block)
+		{
+			uint32_t fl, sl;
+			tlsfMappingInsert(_block->getSize(), fl, sl);
+			removeFree(_block, fl, sl);
+		}
+
+		void insertBlock(TlsfBlock* _block)
+		{
+			uint32_t fl, sl;
+			tlsfMappingInsert(_block->getSize(), fl, sl);
+			insertFree(_block, fl, sl);
+		}
+
+		TlsfBlock* searchSuitable(uint32_t& _fl, uint32_t& _sl) const
+		{
+			uint32_t slMap = slBitmap[_fl] & (UINT32_MAX << _sl);
+
+			if (0 == slMap)
+			{
+				const uint32_t flMap = flBitmap & (UINT32_MAX << (_fl + 1) );
+
+				if (0 == flMap)
+				{
+					return NULL;
+				}
+
+				_fl   = uint32_cnttz(flMap);
+				slMap = slBitmap[_fl];
+			}
+
+			_sl = uint32_cnttz(slMap);
+
+			return blocks[_fl][_sl];
+		}
+
+		TlsfBlock* split(TlsfBlock* _block, size_t _size)
+		{
+			TlsfBlock* remaining = tlsfOffsetToBlock(_block->toPtr(), ptrdiff_t(_size - kTlsfBlockOverhead) );
+			remaining->size = _block->getSize() - (_size + kTlsfBlockOverhead);
+			_block->setSize(_size);
+			remaining->markAsFree();
+
+			return remaining;
+		}
+
+		TlsfBlock* absorb(TlsfBlock* _prev, TlsfBlock* _block)
+		{
+			_prev->size += _block->getSize() + kTlsfBlockOverhead;
+			_prev->linkNext();
+
+			return _prev;
+		}
+
+		TlsfBlock* mergePrev(TlsfBlock* _block)
+		{
+			if (_block->isPrevFree() )
+			{
+				TlsfBlock* prev = _block->prevPhys;
+				removeBlock(prev);
+				_block = absorb(prev, _block);
+			}
+
+			return _block;
+		}
+
+		TlsfBlock* mergeNext(TlsfBlock* _block)
+		{
+			TlsfBlock* next = _block->getNext();
+
+			if (next->isFree() )
+			{
+				removeBlock(next);
+				_block = absorb(_block, next);
+			}
+
+			return _block;
+		}
+
+		void trimFree(TlsfBlock* _block, size_t _size)
+		{
+			if (_block->getSize() >= sizeof(TlsfBlock) + _size)
+			{
+				TlsfBlock* remaining = split(_block, _size);
+				_block->linkNext();
+				remaining->setPrevFree(true);
+				insertBlock(remaining);
+			}
+		}
+
+		void trimUsed(TlsfBlock* _block, size_t _size)
+		{
+			if (_block->getSize() >= sizeof(TlsfBlock) + _size)
+			{
+				TlsfBlock* remaining = split(_block, _size);
+				remaining->setPrevFree(false);
+				remaining = mergeNext(remaining);
+				insertBlock(remaining);
+			}
+		}
+
+		TlsfBlock* trimFreeLeading(TlsfBlock* _block, size_t _size)
+		{
+			TlsfBlock* remaining = _block;
+
+			if (_block->getSize() >= sizeof(TlsfBlock) + _size)
+			{
+				remaining = split(_block, _size - kTlsfBlockOverhead);
+				remaining->setPrevFree(true);
+				_block->linkNext();
+				insertBlock(_block);
+			}
+
+			return remaining;
+		}
+
+		TlsfBlock* locateFree(size_t _size)
+		{
+			uint32_t fl = 0;
+			uint32_t sl = 0;
+
+			if (0 == _size)
+			{
+				return NULL;
+			}
+
+			tlsfMappingSearch(_size, fl, sl);
+
+			if (fl >= kTlsfFlCount)
+			{
+				return NULL;
+			}
+
+			TlsfBlock* block = searchSuitable(fl, sl);
+
+			if (NULL != block)
+			{
+				removeFree(block, fl, sl);
+			}
+
+			return block;
+		}
+
+		void* prepareUsed(TlsfBlock* _block, size_t _size)
+		{
+			trimFree(_block, _size);
+			_block->markAsUsed();
+			usedSize += _block->getSize() + kTlsfBlockOverhead;
+
+			return _block->toPtr();
+		}
+
+		void addPool(void* _data, size_t _size)
+		{
+			const size_t poolSize = min( (_size - kTlsfPoolOverhead) & ~(kTlsfAlign-1), kTlsfBlockSizeMax - kTlsfAlign);
+
+			BX_ASSERT(isAligned(_data, int32_t(kTlsfAlign) ), "TlsfAllocator: Pool memory must be aligned.");
+			BX_ASSERT(_size >= kTlsfPoolOverhead + kTlsfBlockSizeMin, "TlsfAllocator: Pool is too small.");
+
+			// First block starts one word before pool, since its previous physical block pointer is
+			// never used. Pool is terminated with zero sized used block.
+			TlsfBlock* block = tlsfOffsetToBlock(_data, -ptrdiff_t(kTlsfBlockOverhead) );
+			block->size = poolSize | TlsfBlock::kFree;
+			insertBlock(block);
+
+			TlsfBlock* next = block->linkNext();
+			next->size = TlsfBlock::kPrevFree;
+
+			totalSize += poolSize + kTlsfPoolOverhead;
+		}
+
+		void* alloc(size_t _size, size_t _align)
+		{
+			const size_t adjust = tlsfAdjustRequestSize(_size, kTlsfAlign);
+
+			if (_align <= kTlsfAlign)
+			{
+				TlsfBlock* block = locateFree(adjust);
+				return NULL == block ? NULL : prepareUsed(block, adjust);
+			}
+
+			// Request enough to fit aligned pointer, and leave gap that's large enough to be freed
+			// as separate block in front of it.
+			const size_t gapMin = sizeof(TlsfBlock);
+			const size_t sizeWithGap = tlsfAdjustRequestSize(adjust + _align + gapMin, _align);
+
+			TlsfBlock* block = locateFree(0 == adjust ? 0 : sizeWithGap);
+
+			if (NULL == block)
+			{
+				return NULL;
+			}
+
+			uint8_t* ptr = (uint8_t*)block->toPtr();
+			uint8_t* aligned = (uint8_t*)alignPtr(ptr, 0, _align);
+			size_t gap = size_t(aligned - ptr);
+
+			if (0 != gap
+			&&  gap < gapMin)
+			{
+				const size_t gapRemain = gapMin - gap;
+				aligned = (uint8_t*)alignPtr(aligned, max(gapRemain, _align), _align);
+				gap = size_t(aligned - ptr);
+			}
+
+			if (0 != gap)
+			{
+				block = trimFreeLeading(block, gap);
+			}
+
+			return prepareUsed(block, adjust);
+		}
+
+		void free(void* _ptr)
+		{
+			TlsfBlock* block = tlsfBlockFromPtr(_ptr);
+			BX_ASSERT(!block->isFree(), "TlsfAllocator: Block already freed.");
+
+			usedSize -= block->getSize() + kTlsfBlockOverhead;
+
+			block->markAsFree();
+			block = mergePrev(block);
+			block = mergeNext(block);
+			insertBlock(block);
+		}
+
+		void* realloc(void* _ptr, size_t _size, size_t _align)
+		{
+			TlsfBlock* block = tlsfBlockFromPtr(_ptr);
+			TlsfBlock* next  = block->getNext();
+
+			const size_t curSize  = block->getSize();
+			const size_t combined = curSize + next->getSize() + kTlsfBlockOverhead;
+			const size_t adjust   = tlsfAdjustRequestSize(_size, kTlsfAlign);
+
+			if (0 == adjust)
+			{
+				return NULL;
+			}
+
+			if (adjust > curSize
+			&& (!next->isFree() || adjust > combined) )
+			{
+				void* ptr = alloc(_size, _align);
+
+				if (NULL != ptr)
+				{
+					memCopy(ptr, _ptr, min(curSize, _size) );
+					free(_ptr);
+				}
+
+				return ptr;
+			}
+
+			// Resize in place, pointer is already aligned.
+			if (adjust > curSize)
+			{
+				mergeNext(block);
+				block->markAsUsed();
+			}
+
+			trimUsed(block, adjust);
+			usedSize += block->getSize() - curSize;
+
+			return _ptr;
+		}
+
+		size_t getMaxFreeBlockSize() const
+		{
+			if (0 == flBitmap)
+			{
+				return 0;
+			}
+
+			const uint32_t fl = tlsfFls(flBitmap);
+			const uint32_t sl = tlsfFls(slBitmap[fl]);
+
+			size_t result = 0;
+
+			for (const TlsfBlock* block = blocks[fl][sl]; NULL != block; block = block->nextFree)
+			{
+				result = max(result, block->getSize() );
+			}
+
+			return result;
+		}
+
+		void*      pools;
+		size_t     usedSize;
+		size_t     totalSize;
+		uint32_t   flBitmap;
+		uint32_t   slBitmap[kTlsfFlCount];
+		TlsfBlock* blocks[kTlsfFlCount][kTlsfSlCount];
+	};
+
+	TlsfAllocator::TlsfAllocator(void* _data, size_t _size)
+		: m_allocator(NULL)
+		, m_control(NULL)
+		, m_poolSize(0)
+	{
+		uint8_t* data = (uint8_t*)alignPtr(_data, 0, kTlsfAlign);
+		uint8_t* pool = (uint8_t*)alignPtr(data, sizeof(Control), kTlsfAlign);
+		const size_t used = size_t(pool - (uint8_t*)_data);
+
+		BX_ASSERT(_size >= used + kTlsfPoolOverhead + kTlsfBlockSizeMin, "TlsfAllocator: Memory region is too small.");
+
+		m_control = (Control*)data;
+		m_control->init();
+		m_control->addPool(pool, _size - used);
+	}
+
+	TlsfAllocator::TlsfAllocator(AllocatorI* _allocator, size_t _poolSize)
+		: m_allocator(_allocator)
+		, m_control(NULL)
+		, m_poolSize(_poolSize)
+	{
+		m_control = (Control*)BX_ALIGNED_ALLOC(m_allocator, sizeof(Control), kTlsfAlign);
+		m_control->init();
+	}
+
+	TlsfAllocator::~TlsfAllocator()
+	{
+		if (NULL != m_allocator)
+		{
+			for (void* pool = m_control->pools; NULL != pool;)
+			{
+				void* next = *(void**)pool;
+				BX_ALIGNED_FREE(m_allocator, pool, kTlsfAlign);
+				pool = next;
+			}
+
+			BX_ALIGNED_FREE(m_allocator, m_control, kTlsfAlign);
+		}
+	}
+
+	bool TlsfAllocator::grow(size_t _size, size_t _align)
+	{
+		if (NULL == m_allocator)
+		{
+			return false;
+		}
+
+		// Pool starts with pointer to next pool, and must fit requested block with worst case
+		// alignment gap, and rounding up to next second level bin.
+		const size_t header = alignUp(sizeof(void*), int32_t(kTlsfAlign) );
+		const size_t request = _size + (_align > kTlsfAlign ? _align + sizeof(TlsfBlock) : 0);
+		const size_t size = max(
+			  m_poolSize
+			, header + kTlsfPoolOverhead + request + (request >> kTlsfSlLog2) + kTlsfSmallSize
+			);
+
+		uint8_t* pool = (uint8_t*)BX_ALIGNED_ALLOC(m_allocator, size, kTlsfAlign);
+
+		if (NULL == pool)
+		{
+			return false;
+		}
+
+		*(void**)pool = m_control->pools;
+		m_control->pools = pool;
+		m_control->addPool(pool + header, size - header);
+
+		return true;
+	}
+
+	void* TlsfAllocator::realloc(void* _ptr, size_t _size, size_t _align, const char* _file, uint32_t _line)
+	{
+		BX_UNUSED(_file, _line);
+
+		if (0 == _size)
+		{
+			if (NULL != _ptr)
+			{
+				m_control->free(_ptr);
+			}
+
+			return NULL;
+		}
+
+		const size_t align = max(_align, kTlsfAlign);
+
+		if (NULL == _ptr)
+		{
+			void* ptr = m_control->alloc(_size, align);
+
+			if (NULL == ptr
+			&&  grow(_size, align) )
+			{
+				ptr = m_control->alloc(_size, align);
+			}
+
+			return ptr;
+		}
+
+		void* ptr = m_control->realloc(_ptr, _size, align);
+
+		if (NULL == ptr
+		&&  grow(_size, align) )
+		{
+			ptr = m_control->realloc(_ptr, _size, align);
+		}
+
+		return ptr;
+	}
+
+	size_t TlsfAllocator::getUsedSize() const
+	{
+		return m_control->usedSize;
+	}
+
+	size_t TlsfAllocator::getTotalSize() const
+	{
+		return m_control->totalSize;
+	}
+
+	size_t TlsfAllocator::getMaxFreeBlockSize() const
+	{
+		return m_control->getMaxFreeBlockSize();
+	}
+
+	struct ProfilingAllocator::Site
+	{
+		volatile uint64_t key;
+		const char*       file;
+		uint32_t          line;
+		volatile uint32_t ready;
+
+		volatile uint64_t numAllocs;
+		volatile uint64_t numFrees;
+		volatile uint64_t liveSize;
+		volatile uint64_t peakSize;
+		volatile uint64_t totalSize;
+		volatile uint64_t histogram[AllocationSiteStats::kNumBuckets];
+	};
+
+	struct ProfilingHeader
+	{
+		uint64_t size;
+		uint32_t site;
+		uint32_t offset;
+	};
+
+	static constexpr uint32_t kProfilingHeaderSize = 16;
+	BX_STATIC_ASSERT(sizeof(ProfilingHeader) <= kProfilingHeaderSize);
+
+	static uint64_t getSiteKey(const char* _file, uint32_t _line)
+	{
+		uint64_t key = uint64_t(uintptr_t(_file) ) ^ (uint64_t(_line) << 48);
+		key ^= key >> 33;
+		key *= UINT64_C(0xff51afd7ed558ccd);
+		key ^= key >> 33;
+		key *= UINT64_C(0xc4ceb9fe1a85ec53);
+		key ^= key >> 33;
+
+		return key | 1;
+	}
+
+	static uint32_t getSizeBucket(size_t _size)
+	{
+		const uint32_t numBuckets = AllocationSiteStats::kNumBuckets;
+
+		if (_size <= 16)
+		{
+			return 0;
+		}
+
+		const uint32_t bucket = 64 - uint32_cntlz(uint64_t(_size - 1) ) - 4;
+		return min(bucket, numBuckets-1);
+	}
+
+	ProfilingAllocator::ProfilingAllocator(AllocatorI* _allocator, uint32_t _maxSites)
+		: m_allocator(_allocator)
+		, m_maxSites(uint32_nextpow2(max(_maxSites, 16) ) )
+		, m_numSites(0)
+	{
+		const size_t size = (m_maxSites+1)*sizeof(Site);
+		m_site = (Site*)BX_ALIGNED_ALLOC(m_allocator, size, 64);
+		memSet(m_site, 0, size);
+
+		Site& overflow = m_site[m_maxSites];
+		overflow.file  = "(overflow)";
+		overflow.ready = 1;
+	}
+
+	ProfilingAllocator::~ProfilingAllocator()
+	{
+		BX_ALIGNED_FREE(m_allocator, m_site, 64);
+	}
+
+	ProfilingAllocator::Site* ProfilingAllocator::findSite(const char* _file, uint32_t _line)
+	{
+		const uint64_t key  = getSiteKey(_file, _line);
+		const uint32_t mask = m_maxSites-1;
+
+		for (uint32_t ii = 0, idx = uint32_t(key>>32) & mask; ii < m_maxSites; ++ii, idx = (idx+1) & mask)
+		{
+			Site& site = m_site[idx];
+
+			uint64_t siteKey = atomicLoad(&site.key);
+
+			if (0 == siteKey)
+			{
+				siteKey = atomicCompareAndSwap<uint64_t>(&site.key, 0, key);
+
+				if (0 == siteKey)
+				{
+					site.file = _file;
+					site.line = _line;
+					atomicStore<uint32_t>(&site.ready, 1);
+					atomicFetchAndAdd<uint32_t>(&m_numSites, 1);
+					return &site;
+				}
+			}
+
+			if (key == siteKey)
+			{
+				while (0 == atomicLoad(&site.ready) )
+				{
+				}
+
+				if (site.file == _file
+				&&  site.line == _line)
+				{
+					return &site;
+				}
+			}
+		}
+
+		return &m_site[m_maxSites];
+	}
+
+	void* ProfilingAllocator::realloc(void* _ptr, size_t _size, size_t _align, const char* _file, uint32_t _line)
+	{
+		const uint32_t offset = uint32_t(max<size_t>(_align, kProfilingHeaderSize) );
+
+		if (NULL != _ptr)
+		{
+			uint8_t* ptr = (uint8_t*)_ptr;
+			const ProfilingHeader* header = (const ProfilingHeader*)(ptr - sizeof(ProfilingHeader) );
+			Site& site = m_site[header->site];
+			const uint64_t size = header->size;
+
+			if (0 == _size)
+			{
+				atomicFetchAndSub<uint64_t>(&site.liveSize, size);
+				atomicFetchAndAdd<uint64_t>(&site.numFrees, 1);
+				m_allocator->realloc(ptr - header->offset, 0, _align, _file, _line);
+				return NULL;
+			}
+
+			BX_ASSERT(offset == header->offset, "ProfilingAllocator: Reallocating with different alignment.");
+
+			ptr = (uint8_t*)m_allocator->realloc(ptr - header->offset, _size + offset, _align, _file, _line);
+
+			if (NULL == ptr)
+			{
+				return NULL;
+			}
+
+			// Reallocation is recorded as free at old site, and allocation at new one.
+			atomicFetchAndSub<uint64_t>(&site.liveSize, size);
+			atomicFetchAndAdd<uint64_t>(&site.numFrees, 1);
+
+			return record(ptr, offset, _size, _file, _line);
+		}
+
+		uint8_t* ptr = (uint8_t*)m_allocator->realloc(NULL, _size + offset, _align, _file, _line);
+
+		if (NULL == ptr)
+		{
+			return NULL;
+		}
+
+		return record(ptr, offset, _size, _file, _line);
+	}
+
+	void* ProfilingAllocator::record(void* _ptr, uint32_t _offset, size_t _size, const char* _file, uint32_t _line)
+	{
+		uint8_t* ptr = (uint8_t*)_ptr;
+		const uint32_t offset = _offset;
+
+		Site* site = findSite(_file, _line);
+		const uint32_t siteIdx = uint32_t(site - m_site);
+
+		ProfilingHeader* header = (ProfilingHeader*)(ptr + offset - sizeof(ProfilingHeader) );
+		header->size   = _size;
+		header->site   = siteIdx;
+		header->offset = offset;
+
+		atomicFetchAndAdd<uint64_t>(&site->numAllocs, 1);
+		atomicFetchAndAdd<uint64_t>(&site->totalSize, _size);
+		atomicFetchAndAdd<uint64_t>(&site->histogram[getSizeBucket(_size)], 1);
+
+		const uint64_t liveSize = atomicAddAndFetch<uint64_t>(&site->liveSize, _size);
+
+		for (uint64_t peakSize = atomicLoad(&site->peakSize); peakSize < liveSize;)
+		{
+			peakSize = atomicCompareAndSwap<uint64_t>(&site->peakSize, peakSize, liveSize);
+		}
+
+		return ptr + offset;
+	}
+
+	uint32_t ProfilingAllocator::getNumSites() const
+	{
+		const Site& overflow = m_site[m_maxSites];
+		return atomicLoad(&m_numSites) + (0 != atomicLoad(&overflow.numAllocs) );
+	}
+
+	template<ProfilingAllocator::SortBy::Enum SortByT>
+	static int32_t compareSiteStats(const void* _lhs, const void* _rhs)
+	{
+		const AllocationSiteStats& lhs = *(const AllocationSiteStats*)_lhs;
+		const AllocationSiteStats& rhs = *(const AllocationSiteStats*)_rhs;
+
+		uint64_t lhsValue, rhsValue;
+
+		switch (SortByT)
+		{
+		case ProfilingAllocator::SortBy::LiveSize:  lhsValue = lhs.liveSize;  rhsValue = rhs.liveSize;  break;
+		case ProfilingAllocator::SortBy::TotalSize: lhsValue = lhs.totalSize; rhsValue = rhs.totalSize; break;
+		case ProfilingAllocator::SortBy::NumAllocs: lhsValue = lhs.numAllocs; rhsValue = rhs.numAllocs; break;
+		default:                                    lhsValue = lhs.peakSize;  rhsValue = rhs.peakSize;  break;
+		}
+
+		return lhsValue < rhsValue ? 1 : lhsValue > rhsValue ? -1 : 0;
+	}
+
+	static const ComparisonFn s_compareSiteStats[] =
+	{
+		compareSiteStats<ProfilingAllocator::SortBy::PeakSize>,
+		compareSiteStats<ProfilingAllocator::SortBy::LiveSize>,
+		compareSiteStats<ProfilingAllocator::SortBy::TotalSize>,
+		compareSiteStats<ProfilingAllocator::SortBy::NumAllocs>,
+	};
+	BX_STATIC_ASSERT(BX_COUNTOF(s_compareSiteStats) == ProfilingAllocator::SortBy::Count);
+
+	uint32_t ProfilingAllocator::getStats(AllocationSiteStats* _stats, uint32_t _max, SortBy::Enum _sortBy) const
+	{
+		const uint32_t maxSites = getNumSites();
+		const uint32_t numOut   = min(_max, maxSites);
+
+		if (0 == numOut)
+		{
+			return 0;
+		}
+
+		// Sort all sites into temporary storage, and copy top ones out.
+		AllocationSiteStats* stats = _max >= maxSites
+			? _stats
+			: (AllocationSiteStats*)BX_ALLOC(m_allocator, maxSites*sizeof(AllocationSiteStats) )
+			;
+
+		uint32_t num = 0;
+
+		for (uint32_t ii = 0; ii <= m_maxSites && num < maxSites; ++ii)
+		{
+			const Site& site = m_site[ii];
+
+			if (0 == atomicLoad(&site.ready)
+			||  0 == atomicLoad(&site.numAllocs) )
+			{
+				continue;
+			}
+
+			AllocationSiteStats& out = stats[num++];
+			out.file      = site.file;
+			out.line      = site.line;
+			out.numAllocs = atomicLoad(&site.numAllocs);
+			out.numFrees  = atomicLoad(&site.numFrees);
+			out.liveSize  = atomicLoad(&site.liveSize);
+			out.peakSize  = atomicLoad(&site.peakSize);
+			out.totalSize = atomicLoad(&site.totalSize);
+
+			for (uint32_t jj = 0; jj < AllocationSiteStats::kNumBuckets; ++jj)
+			{
+				out.histogram[jj] = atomicLoad(&site.histogram[jj]);
+			}
+		}
+
+		quickSort(stats, num, sizeof(AllocationSiteStats), s_compareSiteStats[_sortBy]);
+
+		num = min(num, numOut);
+
+		if (stats != _stats)
+		{
+			memCopy(_stats, stats, num*sizeof(AllocationSiteStats) );
+			BX_FREE(m_allocator, stats);
+		}
+
+		return num;
+	}
+
+	void ProfilingAllocator::writeReport(WriterI* _writer, SortBy::Enum _sortBy, Error* _err) const
+	{
+		ErrorIgnore errIgnore;
+		Error* err = NULL == _err ? &errIgnore : _err;
+
+		const uint32_t maxSites = getNumSites();
+		AllocationSiteStats* stats = (AllocationSiteStats*)BX_ALLOC(m_allocator, max(maxSites, 1)*sizeof(AllocationSiteStats) );
+		const uint32_t num = getStats(stats, maxSites, _sortBy);
+
+		write(_writer, err
+			, "%12s %12s %14s %14s %14s  %s\n"
+			, "Allocs"
+			, "Frees"
+			, "Live"
+			, "Peak"
+			, "Total"
+			, "Site"
+			);
+
+		for (uint32_t ii = 0; ii < num && err->isOk(); ++ii)
+		{
+			const AllocationSiteStats& site = stats[ii];
+
+			write(_writer, err
+				, "%12" PRIu64 " %12" PRIu64 " %14" PRIu64 " %14" PRIu64 " %14" PRIu64 "  %s:%d\n"
+				, site.numAllocs
+				, site.numFrees
+				, site.liveSize
+				, site.peakSize
+				, site.totalSize
+				, NULL == site.file ? "(unknown)" : site.file
+				, site.line
+				);
+
+			write(_writer, err, "%12s", "");
+
+			for (uint32_t jj = 0; jj < AllocationSiteStats::kNumBuckets; ++jj)
+			{
+				if (0 != site.histogram[jj])
+				{
+					const uint32_t size = 16<<jj;
+
+					write(_writer, err
+						, " %s%d%s:%" PRIu64
+						, jj == AllocationSiteStats::kNumBuckets-1 ? ">" : "<="
+						, jj == AllocationSiteStats::kNumBuckets-1 ? size>>11 : size < 1024 ? size : size>>10
+						, size < 1024 ? "B" : "K"
+						, site.histogram[jj]
+						);
+				}
+			}
+
+			write(_writer, err, "\n");
+		}
+
+		BX_FREE(m_allocator, stats);
+	}
+
+	bool ProfilingAllocator::writeReport(const FilePath& _filePath, SortBy::Enum _sortBy, Error* _err) const
+	{
+		ErrorIgnore errIgnore;
+		Error* err = NULL == _err ? &errIgnore : _err;
+
+		FileWriter writer;
+
+		if (!open(&writer, _filePath, false, err) )
+		{
+			return false;
+		}
+
+		writeReport(&writer, _sortBy, err);
+		close(&writer);
+
+		return err->isOk();
+	}
+
 } // namespace bx
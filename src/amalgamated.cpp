@@ -7,21 +7,26 @@
 #include "bounds.cpp"
 #include "bx.cpp"
 #include "commandline.cpp"
+#include "cputopology.cpp"
 #include "crtnone.cpp"
 #include "debug.cpp"
 #include "dtoa.cpp"
 #include "easing.cpp"
+#include "fiber.cpp"
 #include "file.cpp"
 #include "filepath.cpp"
 #include "hash.cpp"
+#include "jobsystem.cpp"
 #include "math.cpp"
 #include "mutex.cpp"
 #include "os.cpp"
 #include "process.cpp"
+#include "rwlock.cpp"
 #include "semaphore.cpp"
 #include "settings.cpp"
 #include "sort.cpp"
 #include "string.cpp"
+#include "taskgraph.cpp"
 #include "thread.cpp"
 #include "timer.cpp"
 #include "url.cpp"
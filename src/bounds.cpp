@@ -6,9 +6,13 @@
 #include <bx/rng.h>
 #include <bx/math.h>
 #include <bx/bounds.h>
+#include <bx/jobsystem.h>
 
 namespace bx
 {
+	// Minimum number of vertices processed by single job.
+	static constexpr uint32_t kBoundsGrainSize = 16<<10;
+
 	Vec3 getCenter(const Aabb& _aabb)
 	{
 		return mul(add(_aabb.min, _aabb.max), 0.5f);
@@ -126,16 +130,16 @@ namespace bx
 		memCopy(_obb.mtx, result, sizeof(result) );
 	}
 
-	void toAabb(Aabb& _outAabb, const void* _vertices, uint32_t _numVertices, uint32_t _stride)
+	static Aabb toAabbRange(const void* _vertices, uint32_t _begin, uint32_t _end, uint32_t _stride)
 	{
 		Vec3 mn(init::None);
 		Vec3 mx(init::None);
-		uint8_t* vertex = (uint8_t*)_vertices;
+		uint8_t* vertex = (uint8_t*)_vertices + size_t(_begin)*_stride;
 
 		mn = mx = load<Vec3>(vertex);
 		vertex += _stride;
 
-		for (uint32_t ii = 1; ii < _numVertices; ++ii)
+		for (uint32_t ii = _begin+1; ii < _end; ++ii)
 		{
 			const Vec3 pos = load<Vec3>(vertex);
 			vertex += _stride;
@@ -144,8 +148,40 @@ namespace bx
 			mx = max(pos, mx);
 		}
 
-		_outAabb.min = mn;
-		_outAabb.max = mx;
+		Aabb aabb;
+		aabb.min = mn;
+		aabb.max = mx;
+		return aabb;
+	}
+
+	void toAabb(Aabb& _outAabb, const void* _vertices, uint32_t _numVertices, uint32_t _stride, JobSystem* _jobSystem)
+	{
+#if BX_CONFIG_SUPPORTS_THREADING
+		if (NULL != _jobSystem
+		&&  kBoundsGrainSize < _numVertices)
+		{
+			const Aabb first = toAabbRange(_vertices, 0, 1, _stride);
+
+			_outAabb = parallelReduce(_jobSystem, 0, _numVertices, kBoundsGrainSize, first
+				, [&](uint32_t _begin, uint32_t _end)
+				{
+					return toAabbRange(_vertices, _begin, _end, _stride);
+				}
+				, [](const Aabb& _a, const Aabb& _b)
+				{
+					Aabb aabb;
+					aabb.min = min(_a.min, _b.min);
+					aabb.max = max(_a.max, _b.max);
+					return aabb;
+				});
+
+			return;
+		}
+#else
+		BX_UNUSED(_jobSystem);
+#endif // BX_CONFIG_SUPPORTS_THREADING
+
+		_outAabb = toAabbRange(_vertices, 0, _numVertices, _stride);
 	}
 
 	void toAabb(Aabb& _outAabb, const float* _mtx, const void* _vertices, uint32_t _numVertices, uint32_t _stride)
@@ -254,26 +290,53 @@ namespace bx
 		memCopy(&_outObb, &best, sizeof(Obb) );
 	}
 
-	void calcMaxBoundingSphere(Sphere& _sphere, const void* _vertices, uint32_t _numVertices, uint32_t _stride)
+	static float calcMaxDistSq(const Vec3& _center, const void* _vertices, uint32_t _begin, uint32_t _end, uint32_t _stride)
 	{
-		Aabb aabb;
-		toAabb(aabb, _vertices, _numVertices, _stride);
-
-		Vec3 center = getCenter(aabb);
-
 		float maxDistSq = 0.0f;
-		uint8_t* vertex = (uint8_t*)_vertices;
+		uint8_t* vertex = (uint8_t*)_vertices + size_t(_begin)*_stride;
 
-		for (uint32_t ii = 0; ii < _numVertices; ++ii)
+		for (uint32_t ii = _begin; ii < _end; ++ii)
 		{
 			const Vec3& pos = load<Vec3>(vertex);
 			vertex += _stride;
 
-			const Vec3 tmp = sub(pos, center);
+			const Vec3 tmp = sub(pos, _center);
 			const float distSq = dot(tmp, tmp);
 			maxDistSq = max(distSq, maxDistSq);
 		}
 
+		return maxDistSq;
+	}
+
+	void calcMaxBoundingSphere(Sphere& _sphere, const void* _vertices, uint32_t _numVertices, uint32_t _stride, JobSystem* _jobSystem)
+	{
+		Aabb aabb;
+		toAabb(aabb, _vertices, _numVertices, _stride, _jobSystem);
+
+		const Vec3 center = getCenter(aabb);
+
+		float maxDistSq;
+
+#if BX_CONFIG_SUPPORTS_THREADING
+		if (NULL != _jobSystem
+		&&  kBoundsGrainSize < _numVertices)
+		{
+			maxDistSq = parallelReduce(_jobSystem, 0, _numVertices, kBoundsGrainSize, 0.0f
+				, [&](uint32_t _begin, uint32_t _end)
+				{
+					return calcMaxDistSq(center, _vertices, _begin, _end, _stride);
+				}
+				, [](float _a, float _b)
+				{
+					return max(_a, _b);
+				});
+		}
+		else
+#endif // BX_CONFIG_SUPPORTS_THREADING
+		{
+			maxDistSq = calcMaxDistSq(center, _vertices, 0, _numVertices, _stride);
+		}
+
 		_sphere.center = center;
 		_sphere.radius = sqrt(maxDistSq);
 	}
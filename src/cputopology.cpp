@@ -0,0 +1,336 @@
+/*
+ * Copyright 2010-2023 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bx/blob/master/LICENSE
+ */
+
+#include <bx/cputopology.h>
+#include <bx/os.h>
+#include <bx/string.h>
+
+#if !BX_CRT_NONE          \
+	&& (0                 \
+	||  BX_PLATFORM_LINUX \
+	||  BX_PLATFORM_RPI   \
+	)
+#	define BX_CPU_TOPOLOGY_SYSFS 1
+#	include <stdio.h> // fopen
+#else
+#	define BX_CPU_TOPOLOGY_SYSFS 0
+#endif // BX_PLATFORM_*
+
+namespace bx
+{
+#if BX_CPU_TOPOLOGY_SYSFS
+	// Returns dense id of key, adding key to keys when it's not found.
+	static uint16_t remapId(uint32_t* _keys, uint32_t& _num, uint32_t _key)
+	{
+		for (uint32_t ii = 0; ii < _num; ++ii)
+		{
+			if (_key == _keys[ii])
+			{
+				return uint16_t(ii);
+			}
+		}
+
+		_keys[_num] = _key;
+		return uint16_t(_num++);
+	}
+
+	static bool readSysFile(uint32_t* _out, const char* _format, ...)
+	{
+		char path[256];
+
+		va_list argList;
+		va_start(argList, _format);
+		vsnprintf(path, sizeof(path), _format, argList);
+		va_end(argList);
+
+		FILE* file = fopen(path, "r");
+		if (NULL == file)
+		{
+			return false;
+		}
+
+		// Files with CPU lists (0-3,8-11) and sizes (512K) start with number too.
+		char suffix = '\0';
+		const int items = fscanf(file, "%u%c", _out, &suffix);
+		fclose(file);
+
+		if (1 > items)
+		{
+			return false;
+		}
+
+		if ('K' == suffix)
+		{
+			*_out *= 1<<10;
+		}
+		else if ('M' == suffix)
+		{
+			*_out *= 1<<20;
+		}
+
+		return true;
+	}
+
+	static bool readSysFileType(char* _out, int32_t _max, const char* _path)
+	{
+		FILE* file = fopen(_path, "r");
+		if (NULL == file)
+		{
+			return false;
+		}
+
+		const char* line = fgets(_out, _max, file);
+		fclose(file);
+
+		return NULL != line;
+	}
+#endif // BX_CPU_TOPOLOGY_SYSFS
+
+	CpuTopology::CpuTopology()
+		: m_numCpus(0)
+		, m_numCores(0)
+		, m_numPackages(0)
+		, m_numNumaNodes(0)
+		, m_numL2(0)
+		, m_numL3(0)
+		, m_l2Size(0)
+		, m_l3Size(0)
+	{
+#if BX_CPU_TOPOLOGY_SYSFS
+		uint32_t coreKeys[kMaxCpus];
+		uint32_t packageKeys[kMaxCpus];
+		uint32_t numaNodeKeys[kMaxCpus];
+		uint32_t l2Keys[kMaxCpus];
+		uint32_t l3Keys[kMaxCpus];
+
+		for (uint32_t id = 0; id < kMaxCpus; ++id)
+		{
+			uint32_t coreId = 0;
+
+			// Offline CPUs don't have topology.
+			if (!readSysFile(&coreId, "/sys/devices/system/cpu/cpu%u/topology/core_id", id) )
+			{
+				continue;
+			}
+
+			uint32_t packageId = 0;
+			readSysFile(&packageId, "/sys/devices/system/cpu/cpu%u/topology/physical_package_id", id);
+
+			uint32_t numaNodeId = 0;
+			for (uint32_t node = 0; node < kMaxCpus; ++node)
+			{
+				uint32_t first;
+				if (readSysFile(&first, "/sys/devices/system/cpu/cpu%u/node%u/cpulist", id, node) )
+				{
+					numaNodeId = node;
+					break;
+				}
+			}
+
+			// Cache is identified by first CPU sharing it.
+			uint32_t l2Id = id;
+			uint32_t l3Id = UINT32_MAX;
+
+			for (uint32_t index = 0; index < 8; ++index)
+			{
+				uint32_t level;
+				if (!readSysFile(&level, "/sys/devices/system/cpu/cpu%u/cache/index%u/level", id, index) )
+				{
+					break;
+				}
+
+				char path[256];
+				snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/cache/index%u/type", id, index);
+
+				char type[32];
+				if (!readSysFileType(type, sizeof(type), path)
+				||  0 == strCmp(type, "Instruction", 11) )
+				{
+					continue;
+				}
+
+				uint32_t first = id;
+				readSysFile(&first, "/sys/devices/system/cpu/cpu%u/cache/index%u/shared_cpu_list", id, index);
+
+				uint32_t size = 0;
+				readSysFile(&size, "/sys/devices/system/cpu/cpu%u/cache/index%u/size", id, index);
+
+				if (2 == level)
+				{
+					l2Id     = first;
+					m_l2Size = size;
+				}
+				else if (3 == level)
+				{
+					l3Id     = first;
+					m_l3Size = size;
+				}
+			}
+
+			CpuInfo& cpu = m_cpu[m_numCpus];
+			cpu.id       = uint16_t(id);
+			cpu.core     = remapId(coreKeys,     m_numCores,     packageId<<16 | coreId);
+			cpu.package  = remapId(packageKeys,  m_numPackages,  packageId);
+			cpu.numaNode = remapId(numaNodeKeys, m_numNumaNodes, numaNodeId);
+			cpu.l2       = remapId(l2Keys,       m_numL2,        l2Id);
+			cpu.l3       = remapId(l3Keys,       m_numL3,        l3Id);
+			++m_numCpus;
+		}
+#endif // BX_CPU_TOPOLOGY_SYSFS
+
+		if (0 == m_numCpus)
+		{
+			init(bx::getNumCpus() );
+		}
+	}
+
+	CpuTopology::CpuTopology(uint32_t _numCpus)
+		: m_numCpus(0)
+		, m_numCores(0)
+		, m_numPackages(0)
+		, m_numNumaNodes(0)
+		, m_numL2(0)
+		, m_numL3(0)
+		, m_l2Size(0)
+		, m_l3Size(0)
+	{
+		init(_numCpus);
+	}
+
+	void CpuTopology::init(uint32_t _numCpus)
+	{
+		m_numCpus      = min(_numCpus, uint32_t(kMaxCpus) );
+		m_numCores     = m_numCpus;
+		m_numPackages  = 0 < m_numCpus;
+		m_numNumaNodes = 0 < m_numCpus;
+		m_numL2        = m_numCpus;
+		m_numL3        = 0 < m_numCpus;
+
+		for (uint32_t ii = 0; ii < m_numCpus; ++ii)
+		{
+			CpuInfo& cpu = m_cpu[ii];
+			cpu.id       = uint16_t(ii);
+			cpu.core     = uint16_t(ii);
+			cpu.package  = 0;
+			cpu.numaNode = 0;
+			cpu.l2       = uint16_t(ii);
+			cpu.l3       = 0;
+		}
+	}
+
+	uint32_t CpuTopology::getNumCpus() const
+	{
+		return m_numCpus;
+	}
+
+	uint32_t CpuTopology::getNumCores() const
+	{
+		return m_numCores;
+	}
+
+	uint32_t CpuTopology::getNumPackages() const
+	{
+		return m_numPackages;
+	}
+
+	uint32_t CpuTopology::getNumNumaNodes() const
+	{
+		return m_numNumaNodes;
+	}
+
+	uint32_t CpuTopology::getNumL2() const
+	{
+		return m_numL2;
+	}
+
+	uint32_t CpuTopology::getNumL3() const
+	{
+		return m_numL3;
+	}
+
+	uint32_t CpuTopology::getL2Size() const
+	{
+		return m_l2Size;
+	}
+
+	uint32_t CpuTopology::getL3Size() const
+	{
+		return m_l3Size;
+	}
+
+	const CpuInfo& CpuTopology::getCpu(uint32_t _cpu) const
+	{
+		BX_ASSERT(_cpu < m_numCpus, "CpuTopology: Invalid CPU %d.", _cpu);
+		return m_cpu[_cpu];
+	}
+
+	uint64_t CpuTopology::getMask() const
+	{
+		uint64_t mask = 0;
+
+		for (uint32_t ii = 0; ii < m_numCpus; ++ii)
+		{
+			mask |= UINT64_C(1) << m_cpu[ii].id;
+		}
+
+		return mask;
+	}
+
+	uint64_t CpuTopology::getCoreMask(uint32_t _core) const
+	{
+		return getMask(&CpuInfo::core, _core);
+	}
+
+	uint64_t CpuTopology::getL2Mask(uint32_t _l2) const
+	{
+		return getMask(&CpuInfo::l2, _l2);
+	}
+
+	uint64_t CpuTopology::getL3Mask(uint32_t _l3) const
+	{
+		return getMask(&CpuInfo::l3, _l3);
+	}
+
+	uint64_t CpuTopology::getNumaNodeMask(uint32_t _numaNode) const
+	{
+		return getMask(&CpuInfo::numaNode, _numaNode);
+	}
+
+	uint64_t CpuTopology::getPhysicalCoreMask() const
+	{
+		uint64_t mask = 0;
+		uint64_t done = 0;
+
+		for (uint32_t ii = 0; ii < m_numCpus; ++ii)
+		{
+			const CpuInfo& cpu = m_cpu[ii];
+			const uint64_t core = UINT64_C(1) << cpu.core;
+
+			if (0 == (done & core) )
+			{
+				done |= core;
+				mask |= UINT64_C(1) << cpu.id;
+			}
+		}
+
+		return mask;
+	}
+
+	uint64_t CpuTopology::getMask(uint16_t CpuInfo::* _member, uint32_t _id) const
+	{
+		uint64_t mask = 0;
+
+		for (uint32_t ii = 0; ii < m_numCpus; ++ii)
+		{
+			if (_id == m_cpu[ii].*_member)
+			{
+				mask |= UINT64_C(1) << m_cpu[ii].id;
+			}
+		}
+
+		return mask;
+	}
+
+} // namespace bx
@@ -0,0 +1,97 @@
+/*
+ * Copyright 2010-2023 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bx/blob/master/LICENSE
+ */
+
+#include <bx/fiber.h>
+#include <bx/os.h>
+
+#if BX_CONFIG_SUPPORTS_FIBERS
+
+#include <ucontext.h> // getcontext, makecontext, swapcontext
+
+namespace bx
+{
+	Fiber::Fiber(AllocatorI* _allocator)
+		: m_allocator(_allocator)
+		, m_context(NULL)
+		, m_stack(NULL)
+		, m_stackSize(0)
+		, m_fn(NULL)
+		, m_userData(NULL)
+	{
+		m_context = BX_NEW(m_allocator, ucontext_t);
+	}
+
+	Fiber::~Fiber()
+	{
+		if (NULL != m_stack)
+		{
+			virtualRelease(m_stack, m_stackSize);
+		}
+
+		BX_DELETE(m_allocator, (ucontext_t*)m_context);
+	}
+
+	bool Fiber::init(FiberFn _fn, void* _userData, uint32_t _stackSize)
+	{
+		BX_ASSERT(NULL == m_stack, "Fiber: Already initialized.");
+
+		const size_t pageSize  = getPageSize();
+		const size_t stackSize = (size_t(_stackSize) + pageSize - 1) & ~(pageSize - 1);
+
+		// Lowest page is guard page, stack grows down towards it.
+		m_stackSize = stackSize + pageSize;
+		m_stack     = virtualReserve(m_stackSize);
+
+		if (NULL == m_stack)
+		{
+			return false;
+		}
+
+		uint8_t* stack = (uint8_t*)m_stack + pageSize;
+
+		if (!virtualCommit(stack, stackSize) )
+		{
+			virtualRelease(m_stack, m_stackSize);
+			m_stack = NULL;
+			return false;
+		}
+
+		m_fn       = _fn;
+		m_userData = _userData;
+
+		ucontext_t* context = (ucontext_t*)m_context;
+		getcontext(context);
+		context->uc_stack.ss_sp   = stack;
+		context->uc_stack.ss_size = stackSize;
+		context->uc_link          = NULL;
+
+		// makecontext passes only int arguments, pointer is split in two.
+		const uint64_t ptr = uint64_t(uintptr_t(this) );
+		makecontext(context, (void (*)() )entry, 2, uint32_t(ptr>>32), uint32_t(ptr) );
+
+		return true;
+	}
+
+	void Fiber::initFromThread()
+	{
+		getcontext( (ucontext_t*)m_context);
+	}
+
+	void Fiber::switchTo(Fiber* _from, Fiber* _to)
+	{
+		swapcontext( (ucontext_t*)_from->m_context, (ucontext_t*)_to->m_context);
+	}
+
+	void Fiber::entry(uint32_t _hi, uint32_t _lo)
+	{
+		Fiber* fiber = (Fiber*)uintptr_t( (uint64_t(_hi)<<32) | _lo);
+		fiber->m_fn(fiber->m_userData);
+
+		BX_ASSERT(false, "Fiber: Fiber function must not return.");
+	}
+
+} // namespace bx
+
+#endif // BX_CONFIG_SUPPORTS_FIBERS
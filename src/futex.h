@@ -0,0 +1,55 @@
+/*
+ * Copyright 2010-2023 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bx/blob/master/LICENSE
+ */
+
+#ifndef BX_FUTEX_H_HEADER_GUARD
+#define BX_FUTEX_H_HEADER_GUARD
+
+#include <bx/bx.h>
+
+#if BX_CONFIG_SUPPORTS_FUTEX
+
+#include <errno.h>
+#include <linux/futex.h> // FUTEX_WAIT_PRIVATE, FUTEX_WAKE_PRIVATE
+#include <sys/syscall.h> // SYS_futex
+#include <time.h>        // timespec
+#include <unistd.h>      // syscall
+
+namespace bx
+{
+	/// Sleep while value at `_futex` is equal to `_expected`, until woken up, or until timeout
+	/// expires. Wake ups can be spurious, caller must check value again.
+	///
+	/// @returns False if timeout expired.
+	///
+	inline bool futexWait(volatile uint32_t* _futex, uint32_t _expected, int32_t _msecs = -1)
+	{
+		timespec  ts;
+		timespec* timeout = NULL;
+
+		if (0 <= _msecs)
+		{
+			ts.tv_sec  = _msecs/1000;
+			ts.tv_nsec = (_msecs%1000)*1000000;
+			timeout = &ts;
+		}
+
+		const long result = ::syscall(SYS_futex, _futex, FUTEX_WAIT_PRIVATE, _expected, timeout, NULL, 0);
+
+		return 0 == result
+			|| ETIMEDOUT != errno
+			;
+	}
+
+	/// Wake up to `_count` threads sleeping on `_futex`.
+	inline void futexWake(volatile uint32_t* _futex, uint32_t _count)
+	{
+		::syscall(SYS_futex, _futex, FUTEX_WAKE_PRIVATE, int32_t(min<uint32_t>(_count, INT32_MAX) ), NULL, NULL, 0);
+	}
+
+} // namespace bx
+
+#endif // BX_CONFIG_SUPPORTS_FUTEX
+
+#endif // BX_FUTEX_H_HEADER_GUARD
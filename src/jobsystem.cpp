@@ -0,0 +1,660 @@
+/*
+ * Copyright 2010-2023 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bx/blob/master/LICENSE
+ */
+
+#include <bx/fiber.h>
+#include <bx/jobsystem.h>
+#include <bx/os.h>
+#include <bx/workstealingdeque.h>
+
+#if BX_CONFIG_SUPPORTS_THREADING
+
+namespace bx
+{
+	// Number of attempts to find job before idle worker goes to sleep.
+	static constexpr uint32_t kJobSpinCount = 64;
+
+	struct JobSystem::Job
+	{
+		JobFn       fn;
+		void*       userData;
+		JobCounter* counter;
+	};
+
+#if BX_CONFIG_SUPPORTS_FIBERS
+	struct JobSystem::JobFiber
+	{
+		JobFiber(AllocatorI* _allocator)
+			: fiber(_allocator)
+			, system(NULL)
+			, worker(NULL)
+			, job(NULL)
+			, counter(NULL)
+		{
+		}
+
+		Fiber             fiber;
+		JobSystem*        system;
+		Worker*           worker;  // Worker fiber is running on, suspended fiber resumes on it.
+		Job*              job;     // Job to execute when switching to fiber.
+		const JobCounter* counter; // Counter suspended fiber is waiting on.
+	};
+#endif // BX_CONFIG_SUPPORTS_FIBERS
+
+	struct JobSystem::Worker
+	{
+		Worker(AllocatorI* _allocator)
+			: deque(_allocator)
+#if BX_CONFIG_SUPPORTS_FIBERS
+			, fiber(_allocator)
+#endif // BX_CONFIG_SUPPORTS_FIBERS
+			, system(NULL)
+			, current(NULL)
+			, waiting(NULL)
+			, numWaiting(0)
+			, sleeping(0)
+			, index(0)
+			, next(0)
+		{
+		}
+
+		Thread            thread;
+		WorkStealingDeque deque;
+		Semaphore         sem;   // Sleeping worker waits on it.
+#if BX_CONFIG_SUPPORTS_FIBERS
+		Fiber             fiber; // Worker thread context.
+#endif // BX_CONFIG_SUPPORTS_FIBERS
+		JobSystem*        system;
+		JobFiber*         current;
+		JobFiber**        waiting;
+		volatile int32_t  numWaiting; // Written only by worker, read by threads finishing counters.
+		volatile int32_t  sleeping;   // Cleared by thread that posts semaphore.
+		uint32_t          index;
+		uint32_t          next;
+	};
+
+	JobCounter::JobCounter()
+		: m_value(0)
+	{
+	}
+
+	bool JobCounter::isDone() const
+	{
+		return 0 == atomicLoad(&m_value);
+	}
+
+	JobSystem::JobSystem(
+		  AllocatorI* _allocator
+		, uint32_t _numWorkers
+		, uint32_t _maxJobs
+		, uint32_t _numFibers
+		, uint32_t _fiberStackSize
+		)
+		: m_allocator(_allocator)
+		, m_jobs(NULL)
+		, m_workers(NULL)
+		, m_numWorkers(0 == _numWorkers ? getNumCpus() : _numWorkers)
+		, m_fibers(NULL)
+		, m_numFibers(0)
+		, m_free(_allocator, _maxJobs)
+		, m_freeFibers(_allocator, max(_numFibers, 1) )
+		, m_queue(_allocator, _maxJobs)
+		, m_numSleeping(0)
+		, m_numSuspended(0)
+		, m_exit(0)
+	{
+		const uint32_t maxJobs = m_free.getCapacity();
+
+		m_jobs = (Job*)BX_ALLOC(m_allocator, maxJobs*sizeof(Job) );
+
+		for (uint32_t ii = 0; ii < maxJobs; ++ii)
+		{
+			m_free.tryPush(&m_jobs[ii]);
+		}
+
+#if BX_CONFIG_SUPPORTS_FIBERS
+		if (0 != _numFibers)
+		{
+			m_numFibers = _numFibers;
+			m_fibers    = (JobFiber*)BX_ALLOC(m_allocator, m_numFibers*sizeof(JobFiber) );
+
+			for (uint32_t ii = 0; ii < m_numFibers; ++ii)
+			{
+				JobFiber* fiber = BX_PLACEMENT_NEW(&m_fibers[ii], JobFiber)(m_allocator);
+				fiber->system = this;
+
+				// Fiber without stack is never used, jobs run on worker thread instead.
+				if (fiber->fiber.init(fiberFn, fiber, _fiberStackSize) )
+				{
+					m_freeFibers.tryPush(fiber);
+				}
+			}
+		}
+#else
+		BX_UNUSED(_numFibers, _fiberStackSize);
+#endif // BX_CONFIG_SUPPORTS_FIBERS
+
+		m_workers = (Worker*)BX_ALIGNED_ALLOC(m_allocator, m_numWorkers*sizeof(Worker), BX_ALIGNOF(Worker) );
+
+		for (uint32_t ii = 0; ii < m_numWorkers; ++ii)
+		{
+			Worker* worker = BX_PLACEMENT_NEW(&m_workers[ii], Worker)(m_allocator);
+			worker->system = this;
+			worker->index  = ii;
+			worker->next   = ii+1;
+
+			if (0 != m_numFibers)
+			{
+				worker->waiting = (JobFiber**)BX_ALLOC(m_allocator, m_numFibers*sizeof(JobFiber*) );
+			}
+		}
+
+		for (uint32_t ii = 0; ii < m_numWorkers; ++ii)
+		{
+			m_workers[ii].thread.init(workerFn, &m_workers[ii], 0, "bx::JobSystem");
+		}
+	}
+
+	JobSystem::~JobSystem()
+	{
+		atomicStore<int32_t>(&m_exit, 1);
+
+		for (uint32_t ii = 0; ii < m_numWorkers; ++ii)
+		{
+			m_workers[ii].sem.post();
+		}
+
+		for (uint32_t ii = 0; ii < m_numWorkers; ++ii)
+		{
+			m_workers[ii].thread.shutdown();
+		}
+
+		for (uint32_t ii = 0; ii < m_numWorkers; ++ii)
+		{
+			BX_FREE(m_allocator, m_workers[ii].waiting);
+			m_workers[ii].~Worker();
+		}
+
+#if BX_CONFIG_SUPPORTS_FIBERS
+		// Fibers still suspended at this point are waiting on jobs that never started.
+		for (uint32_t ii = 0; ii < m_numFibers; ++ii)
+		{
+			m_fibers[ii].~JobFiber();
+		}
+
+		BX_FREE(m_allocator, m_fibers);
+#endif // BX_CONFIG_SUPPORTS_FIBERS
+
+		BX_ALIGNED_FREE(m_allocator, m_workers, BX_ALIGNOF(Worker) );
+		BX_FREE(m_allocator, m_jobs);
+	}
+
+	uint32_t JobSystem::getNumWorkers() const
+	{
+		return m_numWorkers;
+	}
+
+	uint32_t JobSystem::getNumFibers() const
+	{
+		return m_numFibers;
+	}
+
+	void JobSystem::add(JobFn _fn, void* _userData, JobCounter* _counter)
+	{
+		Job* job = allocJob();
+		job->fn       = _fn;
+		job->userData = _userData;
+		job->counter  = _counter;
+
+		if (NULL != _counter)
+		{
+			atomicFetchAndAdd<int32_t>(&_counter->m_value, 1);
+		}
+
+		Worker* worker = (Worker*)m_tls.get();
+
+		if (NULL != worker
+		&&  this == worker->system)
+		{
+			worker->deque.push(job);
+		}
+		else
+		{
+			// Queue can't be full, it has room for all jobs.
+			const bool ok = m_queue.tryPush(job);
+			BX_ASSERT(ok, "JobSystem: Job queue is full."); BX_UNUSED(ok);
+		}
+
+		wake();
+	}
+
+	void JobSystem::wait(const JobCounter* _counter, bool _runJobs)
+	{
+		Worker* worker = (Worker*)m_tls.get();
+
+		if (NULL != worker
+		&&  this != worker->system)
+		{
+			worker = NULL;
+		}
+
+#if BX_CONFIG_SUPPORTS_FIBERS
+		if (NULL != worker
+		&&  NULL != worker->current)
+		{
+			// Suspend fiber, worker resumes it once counter is done.
+			JobFiber* fiber = worker->current;
+
+			while (!_counter->isDone() )
+			{
+				fiber->counter = _counter;
+				Fiber::switchTo(&fiber->fiber, &worker->fiber);
+			}
+
+			fiber->counter = NULL;
+			return;
+		}
+#endif // BX_CONFIG_SUPPORTS_FIBERS
+
+		while (!_counter->isDone() )
+		{
+			// Job runs directly on worker thread when all fibers are in use. Fibers suspended on
+			// this worker can't be resumed anywhere else, and counter might depend on them.
+			if (NULL != worker)
+			{
+				resume(worker);
+			}
+
+			if (!_runJobs
+			||  !runOne() )
+			{
+				yield();
+			}
+		}
+	}
+
+	bool JobSystem::runOne()
+	{
+		Worker* worker = (Worker*)m_tls.get();
+
+		if (NULL != worker
+		&&  this != worker->system)
+		{
+			worker = NULL;
+		}
+
+		Job* job = findJob(worker);
+
+		if (NULL != job)
+		{
+			execute(job);
+			return true;
+		}
+
+		return false;
+	}
+
+	int32_t JobSystem::workerFn(Thread* _thread, void* _userData)
+	{
+		BX_UNUSED(_thread);
+
+		Worker*    worker = (Worker*)_userData;
+		JobSystem* system = worker->system;
+		system->m_tls.set(worker);
+
+#if BX_CONFIG_SUPPORTS_FIBERS
+		worker->fiber.initFromThread();
+#endif // BX_CONFIG_SUPPORTS_FIBERS
+
+		while (0 == atomicLoad(&system->m_exit) )
+		{
+			Job* job = NULL;
+
+			for (uint32_t ii = 0; ii < kJobSpinCount && NULL == job; ++ii)
+			{
+				// Suspended fibers are resumed before new jobs are started.
+				system->resume(worker);
+
+				job = system->findJob(worker);
+
+				if (NULL == job
+				&&  kJobSpinCount/2 < ii)
+				{
+					yield();
+				}
+			}
+
+			if (NULL == job)
+			{
+				// Announce sleep before last check, so that job added, or counter finished,
+				// after the check sees sleeping worker, and posts its semaphore.
+				atomicStore<int32_t>(&worker->sleeping, 1);
+				atomicFetchAndAdd<int32_t>(&system->m_numSleeping, 1);
+
+				job = system->findJob(worker);
+
+				if (NULL == job
+				&&  !system->isResumable(worker)
+				&&  0 == atomicLoad(&system->m_exit) )
+				{
+					worker->sem.wait();
+				}
+				else if (1 != atomicCompareAndSwap<int32_t>(&worker->sleeping, 1, 0) )
+				{
+					// Semaphore was posted after worker decided not to sleep, consume it.
+					worker->sem.wait();
+				}
+
+				atomicFetchAndSub<int32_t>(&system->m_numSleeping, 1);
+			}
+
+			if (NULL != job)
+			{
+				system->run(worker, job);
+			}
+		}
+
+		system->m_tls.set(NULL);
+
+		return kExitSuccess;
+	}
+
+	JobSystem::Job* JobSystem::allocJob()
+	{
+		Job* job = (Job*)m_free.tryPop();
+
+		while (NULL == job)
+		{
+			// All jobs are in flight, help finishing them.
+			if (!runOne() )
+			{
+				yield();
+			}
+
+			job = (Job*)m_free.tryPop();
+		}
+
+		return job;
+	}
+
+	JobSystem::Job* JobSystem::findJob(Worker* _worker)
+	{
+		Job* job = NULL;
+
+		if (NULL != _worker)
+		{
+			job = (Job*)_worker->deque.pop();
+
+			if (NULL != job)
+			{
+				return job;
+			}
+		}
+
+		job = (Job*)m_queue.tryPop();
+
+		if (NULL != job)
+		{
+			return job;
+		}
+
+		// Steal from other workers, starting from different victim each time, to spread
+		// stealing across workers.
+		uint32_t start = 0;
+
+		if (NULL != _worker)
+		{
+			start = _worker->next;
+			_worker->next = _worker->next+1;
+		}
+
+		for (uint32_t ii = 0; ii < m_numWorkers; ++ii)
+		{
+			Worker& victim = m_workers[(start+ii) % m_numWorkers];
+
+			if (&victim != _worker)
+			{
+				job = (Job*)victim.deque.steal();
+
+				if (NULL != job)
+				{
+					return job;
+				}
+			}
+		}
+
+		return NULL;
+	}
+
+	void JobSystem::execute(Job* _job)
+	{
+		const JobFn fn       = _job->fn;
+		void*       userData = _job->userData;
+		JobCounter* counter  = _job->counter;
+
+		m_free.tryPush(_job);
+
+		fn(userData);
+
+		if (NULL != counter
+		&&  1 == atomicFetchAndSub<int32_t>(&counter->m_value, 1)
+		&&  0 <  atomicLoad(&m_numSuspended) )
+		{
+			// Fibers waiting on counter can be resumed only by worker they were suspended on.
+			for (uint32_t ii = 0; ii < m_numWorkers; ++ii)
+			{
+				if (0 < atomicLoad(&m_workers[ii].numWaiting) )
+				{
+					wake(&m_workers[ii]);
+				}
+			}
+		}
+	}
+
+	void JobSystem::wake()
+	{
+		memoryBarrier();
+
+		if (0 < atomicLoad(&m_numSleeping) )
+		{
+			for (uint32_t ii = 0; ii < m_numWorkers; ++ii)
+			{
+				if (wake(&m_workers[ii]) )
+				{
+					break;
+				}
+			}
+		}
+	}
+
+	bool JobSystem::wake(Worker* _worker)
+	{
+		if (1 == atomicCompareAndSwap<int32_t>(&_worker->sleeping, 1, 0) )
+		{
+			_worker->sem.post();
+			return true;
+		}
+
+		return false;
+	}
+
+	void JobSystem::run(Worker* _worker, Job* _job)
+	{
+#if BX_CONFIG_SUPPORTS_FIBERS
+		JobFiber* fiber = (JobFiber*)m_freeFibers.tryPop();
+
+		if (NULL != fiber)
+		{
+			fiber->job = _job;
+			switchTo(_worker, fiber);
+			return;
+		}
+#else
+		BX_UNUSED(_worker);
+#endif // BX_CONFIG_SUPPORTS_FIBERS
+
+		execute(_job);
+	}
+
+	void JobSystem::resume(Worker* _worker)
+	{
+#if BX_CONFIG_SUPPORTS_FIBERS
+		for (int32_t ii = 0; ii < _worker->numWaiting;)
+		{
+			JobFiber* fiber = _worker->waiting[ii];
+
+			if (fiber->counter->isDone() )
+			{
+				atomicFetchAndSub<int32_t>(&_worker->numWaiting, 1);
+				atomicFetchAndSub<int32_t>(&m_numSuspended, 1);
+				_worker->waiting[ii] = _worker->waiting[_worker->numWaiting];
+
+				switchTo(_worker, fiber);
+			}
+			else
+			{
+				++ii;
+			}
+		}
+#else
+		BX_UNUSED(_worker);
+#endif // BX_CONFIG_SUPPORTS_FIBERS
+	}
+
+	bool JobSystem::isResumable(const Worker* _worker) const
+	{
+#if BX_CONFIG_SUPPORTS_FIBERS
+		for (int32_t ii = 0; ii < _worker->numWaiting; ++ii)
+		{
+			if (_worker->waiting[ii]->counter->isDone() )
+			{
+				return true;
+			}
+		}
+#else
+		BX_UNUSED(_worker);
+#endif // BX_CONFIG_SUPPORTS_FIBERS
+
+		return false;
+	}
+
+#if BX_CONFIG_SUPPORTS_FIBERS
+	void JobSystem::fiberFn(void* _userData)
+	{
+		JobFiber* fiber = (JobFiber*)_userData;
+
+		for (;;)
+		{
+			fiber->system->execute(fiber->job);
+			fiber->job = NULL;
+
+			Fiber::switchTo(&fiber->fiber, &fiber->worker->fiber);
+		}
+	}
+
+	void JobSystem::switchTo(Worker* _worker, JobFiber* _fiber)
+	{
+		_fiber->worker   = _worker;
+		_worker->current = _fiber;
+
+		Fiber::switchTo(&_worker->fiber, &_fiber->fiber);
+
+		_worker->current = NULL;
+
+		if (NULL == _fiber->counter)
+		{
+			m_freeFibers.tryPush(_fiber);
+		}
+		else
+		{
+			// Suspended fiber is announced before worker checks counters for the last time
+			// before sleeping, so that thread finishing counter sees it, and wakes worker.
+			_worker->waiting[_worker->numWaiting] = _fiber;
+			atomicFetchAndAdd<int32_t>(&m_numSuspended, 1);
+			atomicFetchAndAdd<int32_t>(&_worker->numWaiting, 1);
+		}
+	}
+#endif // BX_CONFIG_SUPPORTS_FIBERS
+
+	// Number of chunks per thread, more chunks balance uneven work better, fewer chunks have less
+	// scheduling overhead.
+	static constexpr uint32_t kParallelChunksPerThread = 4;
+
+	struct ParallelForJob
+	{
+		ParallelForFn fn;
+		void*         userData;
+		uint32_t      begin;
+		uint32_t      end;
+	};
+
+	static void parallelForJob(void* _userData)
+	{
+		const ParallelForJob& job = *(const ParallelForJob*)_userData;
+		job.fn(job.begin, job.end, job.userData);
+	}
+
+	uint32_t calcParallelChunkSize(const JobSystem* _jobSystem, uint32_t _num, uint32_t _grainSize)
+	{
+		const uint32_t grainSize = max(_grainSize, 1);
+
+		if (NULL == _jobSystem)
+		{
+			return max(_num, grainSize);
+		}
+
+		// Workers plus calling thread.
+		const uint32_t numThreads = _jobSystem->getNumWorkers() + 1;
+		const uint32_t numChunks  = min(numThreads*kParallelChunksPerThread, kParallelMaxChunks);
+
+		return max( (_num + numChunks - 1) / numChunks, grainSize);
+	}
+
+	void parallelFor(
+		  JobSystem* _jobSystem
+		, uint32_t _begin
+		, uint32_t _end
+		, uint32_t _grainSize
+		, ParallelForFn _fn
+		, void* _userData
+		)
+	{
+		if (_begin >= _end)
+		{
+			return;
+		}
+
+		const uint32_t num       = _end - _begin;
+		const uint32_t chunkSize = calcParallelChunkSize(_jobSystem, num, _grainSize);
+		const uint32_t numChunks = (num + chunkSize - 1) / chunkSize;
+
+		if (1 == numChunks)
+		{
+			_fn(_begin, _end, _userData);
+			return;
+		}
+
+		ParallelForJob job[kParallelMaxChunks];
+		JobCounter counter;
+
+		for (uint32_t ii = 1; ii < numChunks; ++ii)
+		{
+			const uint32_t begin = _begin + ii*chunkSize;
+
+			job[ii].fn       = _fn;
+			job[ii].userData = _userData;
+			job[ii].begin    = begin;
+			job[ii].end      = begin + min(chunkSize, _end - begin);
+
+			_jobSystem->add(parallelForJob, &job[ii], &counter);
+		}
+
+		_fn(_begin, _begin + chunkSize, _userData);
+
+		_jobSystem->wait(&counter);
+	}
+
+} // namespace bx
+
+#endif // BX_CONFIG_SUPPORTS_THREADING
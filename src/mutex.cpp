@@ -10,6 +10,10 @@
 #if BX_CRT_NONE
 #	include <bx/cpu.h>
 #	include "crt0.h"
+#elif BX_CONFIG_SUPPORTS_FUTEX
+#	include <bx/cpu.h>
+#	include <pthread.h>
+#	include "futex.h"
 #elif  BX_PLATFORM_ANDROID \
 	|| BX_PLATFORM_BSD     \
 	|| BX_PLATFORM_HAIKU   \
@@ -32,7 +36,7 @@
 
 namespace bx
 {
-#if BX_CRT_NONE
+#if BX_CRT_NONE || BX_CONFIG_SUPPORTS_FUTEX
 	struct State
 	{
 		enum Enum
@@ -42,7 +46,9 @@ namespace bx
 			Contested,
 		};
 	};
+#endif // BX_CRT_NONE || BX_CONFIG_SUPPORTS_FUTEX
 
+#if BX_CRT_NONE
 	Mutex::Mutex()
 	{
 		BX_STATIC_ASSERT(sizeof(int32_t) <= sizeof(m_internal) );
@@ -80,6 +86,107 @@ namespace bx
 		}
 	}
 
+#elif BX_CONFIG_SUPPORTS_FUTEX
+	// Maximum number of spins before thread is parked on futex.
+	static constexpr int32_t kMutexMaxSpinCount = 100;
+
+	struct MutexInternal
+	{
+		volatile uint32_t  m_state;
+		volatile uintptr_t m_owner;
+		uint32_t           m_count;     // Recursion depth.
+		int32_t            m_spinCount; // Running average of spins needed to acquire lock.
+	};
+
+	Mutex::Mutex()
+	{
+		BX_STATIC_ASSERT(sizeof(MutexInternal) <= sizeof(m_internal) );
+
+		MutexInternal* mi = (MutexInternal*)m_internal;
+		mi->m_state     = State::Unlocked;
+		mi->m_owner     = 0;
+		mi->m_count     = 0;
+		mi->m_spinCount = 0;
+	}
+
+	Mutex::~Mutex()
+	{
+	}
+
+	void Mutex::lock()
+	{
+		MutexInternal* mi = (MutexInternal*)m_internal;
+
+		// Mutex is recursive, same as pthread based implementation. Only owner can observe its
+		// own id in owner field.
+		const uintptr_t self = uintptr_t(pthread_self() );
+
+		if (self == atomicLoad(&mi->m_owner) )
+		{
+			++mi->m_count;
+			return;
+		}
+
+		uint32_t state = atomicCompareAndSwap<uint32_t>(&mi->m_state, State::Unlocked, State::Locked);
+
+		if (State::Unlocked != state)
+		{
+			// Spin before parking, since lock is usually held briefly. Number of spins adapts
+			// to how long it took to acquire lock recently, same as glibc adaptive mutex.
+			const int32_t maxSpinCount = min(mi->m_spinCount*2 + 10, kMutexMaxSpinCount);
+
+			int32_t spinCount = 0;
+			for (; spinCount < maxSpinCount && State::Unlocked != state; ++spinCount)
+			{
+				spinPause();
+
+				if (State::Unlocked == atomicLoad(&mi->m_state) )
+				{
+					state = atomicCompareAndSwap<uint32_t>(&mi->m_state, State::Unlocked, State::Locked);
+				}
+			}
+
+			mi->m_spinCount += (spinCount - mi->m_spinCount)/8;
+
+			// Park, state stays contested while there might be sleeping threads.
+			while (State::Unlocked != state)
+			{
+				if (State::Contested == state
+				||  State::Unlocked  != atomicCompareAndSwap<uint32_t>(&mi->m_state, State::Locked, State::Contested) )
+				{
+					futexWait(&mi->m_state, State::Contested);
+				}
+
+				state = atomicCompareAndSwap<uint32_t>(&mi->m_state, State::Unlocked, State::Contested);
+			}
+		}
+
+		atomicStore(&mi->m_owner, self);
+		mi->m_count = 1;
+	}
+
+	void Mutex::unlock()
+	{
+		MutexInternal* mi = (MutexInternal*)m_internal;
+
+		BX_ASSERT(uintptr_t(pthread_self() ) == mi->m_owner, "Mutex: Unlocked by thread that doesn't own it.");
+
+		--mi->m_count;
+
+		if (0 != mi->m_count)
+		{
+			return;
+		}
+
+		atomicStore<uintptr_t>(&mi->m_owner, 0);
+
+		if (State::Locked != atomicFetchAndSub<uint32_t>(&mi->m_state, 1) )
+		{
+			atomicStore<uint32_t>(&mi->m_state, State::Unlocked);
+			futexWake(&mi->m_state, 1);
+		}
+	}
+
 #else
 
 #	if BX_PLATFORM_WINDOWS \
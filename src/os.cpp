@@ -30,7 +30,7 @@
 	|| BX_PLATFORM_OSX        \
 	|| BX_PLATFORM_PS4        \
 	|| BX_PLATFORM_RPI
-#	include <sched.h> // sched_yield
+#	include <sched.h> // sched_yield, sched_getaffinity
 #	if BX_PLATFORM_BSD       \
 	|| BX_PLATFORM_HAIKU     \
 	|| BX_PLATFORM_IOS       \
@@ -44,6 +44,10 @@
 #		include <dlfcn.h> // dlopen, dlclose, dlsym
 #	endif // !BX_PLATFORM_PS4
 
+#	if !BX_PLATFORM_PS4
+#		include <sys/mman.h> // mmap, mprotect, madvise, munmap
+#	endif // !BX_PLATFORM_PS4
+
 #	if BX_PLATFORM_ANDROID
 #		include <malloc.h> // mallinfo
 #	elif   BX_PLATFORM_LINUX     \
@@ -64,6 +68,24 @@
 #	endif // BX_PLATFORM_ANDROID
 #endif // BX_PLATFORM_
 
+#if BX_PLATFORM_WINDOWS
+#	define BX_OS_VIRTUAL_MEMORY 1
+#elif !BX_CRT_NONE          \
+	&& (0                   \
+	||  BX_PLATFORM_ANDROID \
+	||  BX_PLATFORM_BSD     \
+	||  BX_PLATFORM_HAIKU   \
+	||  BX_PLATFORM_HURD    \
+	||  BX_PLATFORM_IOS     \
+	||  BX_PLATFORM_LINUX   \
+	||  BX_PLATFORM_OSX     \
+	||  BX_PLATFORM_RPI     \
+	)
+#	define BX_OS_VIRTUAL_MEMORY 1
+#else
+#	define BX_OS_VIRTUAL_MEMORY 0
+#endif // BX_PLATFORM_*
+
 namespace bx
 {
 	void sleep(uint32_t _ms)
@@ -173,6 +195,171 @@ namespace bx
 #endif // BX_PLATFORM_*
 	}
 
+	uint32_t getNumCpus()
+	{
+#if BX_PLATFORM_WINDOWS
+		SYSTEM_INFO si;
+		::GetSystemInfo(&si);
+		return max<uint32_t>(si.dwNumberOfProcessors, 1);
+#elif !BX_CRT_NONE          \
+	&& (0                   \
+	||  BX_PLATFORM_ANDROID \
+	||  BX_PLATFORM_BSD     \
+	||  BX_PLATFORM_IOS     \
+	||  BX_PLATFORM_LINUX   \
+	||  BX_PLATFORM_OSX     \
+	||  BX_PLATFORM_RPI     \
+	)
+#	if BX_PLATFORM_LINUX \
+	|| BX_PLATFORM_RPI
+		// Process might be restricted to subset of online CPUs by affinity mask or cpuset.
+		cpu_set_t cpuSet;
+		if (0 == ::sched_getaffinity(0, sizeof(cpuSet), &cpuSet) )
+		{
+			const int32_t numCpus = CPU_COUNT(&cpuSet);
+
+			if (0 < numCpus)
+			{
+				return uint32_t(numCpus);
+			}
+		}
+#	endif // BX_PLATFORM_LINUX || BX_PLATFORM_RPI
+
+		const long numCpus = ::sysconf(_SC_NPROCESSORS_ONLN);
+		return 0 < numCpus ? uint32_t(numCpus) : 1;
+#else
+		return 1;
+#endif // BX_PLATFORM_*
+	}
+
+	size_t getPageSize()
+	{
+#if BX_PLATFORM_WINDOWS
+		SYSTEM_INFO si;
+		::GetSystemInfo(&si);
+		return size_t(si.dwPageSize);
+#elif BX_OS_VIRTUAL_MEMORY
+		return size_t(::sysconf(_SC_PAGESIZE) );
+#else
+		return 4<<10;
+#endif // BX_PLATFORM_*
+	}
+
+	void* virtualReserve(size_t _size, bool _hugePages)
+	{
+		const size_t pageSize = getPageSize();
+		const size_t size = (_size + pageSize - 1) & ~(pageSize - 1);
+
+#if BX_PLATFORM_WINDOWS
+		BX_UNUSED(_hugePages);
+		return ::VirtualAlloc(NULL, size, MEM_RESERVE, PAGE_NOACCESS);
+#elif BX_OS_VIRTUAL_MEMORY
+		void* ptr = ::mmap(NULL, size, PROT_NONE, MAP_PRIVATE|MAP_ANONYMOUS|MAP_NORESERVE, -1, 0);
+
+		if (MAP_FAILED == ptr)
+		{
+			return NULL;
+		}
+
+#	if defined(MADV_HUGEPAGE)
+		if (_hugePages)
+		{
+			::madvise(ptr, size, MADV_HUGEPAGE);
+		}
+#	else
+		BX_UNUSED(_hugePages);
+#	endif // defined(MADV_HUGEPAGE)
+
+		return ptr;
+#else
+		BX_UNUSED(size, _hugePages);
+		return NULL;
+#endif // BX_PLATFORM_*
+	}
+
+	bool virtualCommit(void* _ptr, size_t _size)
+	{
+#if BX_PLATFORM_WINDOWS
+		return NULL != ::VirtualAlloc(_ptr, _size, MEM_COMMIT, PAGE_READWRITE);
+#elif BX_OS_VIRTUAL_MEMORY
+		return 0 == ::mprotect(_ptr, _size, PROT_READ|PROT_WRITE);
+#else
+		BX_UNUSED(_ptr, _size);
+		return false;
+#endif // BX_PLATFORM_*
+	}
+
+	void virtualDecommit(void* _ptr, size_t _size)
+	{
+#if BX_PLATFORM_WINDOWS
+		::VirtualFree(_ptr, _size, MEM_DECOMMIT);
+#elif BX_OS_VIRTUAL_MEMORY
+#	if BX_PLATFORM_LINUX || BX_PLATFORM_ANDROID || BX_PLATFORM_RPI
+		// Drop pages in place, mapping over range would create new mapping without huge page
+		// hint applied by `virtualReserve`.
+		::madvise(_ptr, _size, MADV_DONTNEED);
+		::mprotect(_ptr, _size, PROT_NONE);
+#	else
+		// Mapping over range drops its pages, and releases commit charge. MADV_DONTNEED is only
+		// a hint on these platforms.
+		::mmap(_ptr, _size, PROT_NONE, MAP_FIXED|MAP_PRIVATE|MAP_ANONYMOUS|MAP_NORESERVE, -1, 0);
+#	endif // BX_PLATFORM_LINUX || BX_PLATFORM_ANDROID || BX_PLATFORM_RPI
+#else
+		BX_UNUSED(_ptr, _size);
+#endif // BX_PLATFORM_*
+	}
+
+	bool virtualProtect(void* _ptr, size_t _size, PageProtect::Enum _protect)
+	{
+#if BX_PLATFORM_WINDOWS
+		static const DWORD s_protect[] =
+		{
+			PAGE_NOACCESS,
+			PAGE_READONLY,
+			PAGE_READWRITE,
+			PAGE_EXECUTE_READ,
+			PAGE_EXECUTE_READWRITE,
+		};
+		BX_STATIC_ASSERT(BX_COUNTOF(s_protect) == PageProtect::Count);
+
+		DWORD oldProtect;
+		return !!::VirtualProtect(_ptr, _size, s_protect[_protect], &oldProtect);
+#elif BX_OS_VIRTUAL_MEMORY
+		static const int s_protect[] =
+		{
+			PROT_NONE,
+			PROT_READ,
+			PROT_READ|PROT_WRITE,
+			PROT_READ|PROT_EXEC,
+			PROT_READ|PROT_WRITE|PROT_EXEC,
+		};
+		BX_STATIC_ASSERT(BX_COUNTOF(s_protect) == PageProtect::Count);
+
+		return 0 == ::mprotect(_ptr, _size, s_protect[_protect]);
+#else
+		BX_UNUSED(_ptr, _size, _protect);
+		return false;
+#endif // BX_PLATFORM_*
+	}
+
+	void virtualRelease(void* _ptr, size_t _size)
+	{
+		if (NULL == _ptr)
+		{
+			return;
+		}
+
+#if BX_PLATFORM_WINDOWS
+		BX_UNUSED(_size);
+		::VirtualFree(_ptr, 0, MEM_RELEASE);
+#elif BX_OS_VIRTUAL_MEMORY
+		const size_t pageSize = getPageSize();
+		::munmap(_ptr, (_size + pageSize - 1) & ~(pageSize - 1) );
+#else
+		BX_UNUSED(_size);
+#endif // BX_PLATFORM_*
+	}
+
 	void* dlopen(const FilePath& _filePath)
 	{
 #if BX_PLATFORM_WINDOWS
@@ -0,0 +1,304 @@
+/*
+ * Copyright 2010-2023 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bx/blob/master/LICENSE
+ */
+
+#include <bx/mutex.h>
+#include <bx/rwlock.h>
+
+#if BX_CONFIG_SUPPORTS_THREADING
+
+#if BX_CONFIG_SUPPORTS_FUTEX
+#	include "futex.h"
+#elif BX_CRT_NONE
+#elif  BX_PLATFORM_WINDOWS \
+	|| BX_PLATFORM_WINRT   \
+	|| BX_PLATFORM_XBOXONE
+#	ifndef WIN32_LEAN_AND_MEAN
+#		define WIN32_LEAN_AND_MEAN
+#	endif // WIN32_LEAN_AND_MEAN
+#	include <windows.h>
+#elif BX_PLATFORM_POSIX
+#	include <pthread.h>
+#endif // BX_PLATFORM_
+
+namespace bx
+{
+#if BX_CONFIG_SUPPORTS_FUTEX
+	// Lock state is number of readers, and writer bits.
+	static constexpr uint32_t kRwLockWriter        = UINT32_C(1)<<31;
+	static constexpr uint32_t kRwLockWriterWaiting = UINT32_C(1)<<30;
+	static constexpr uint32_t kRwLockReaderMask    = kRwLockWriterWaiting-1;
+
+	// Number of spins before thread is parked on futex.
+	static constexpr uint32_t kRwLockSpinCount = 64;
+
+	struct RwLockInternal
+	{
+		volatile uint32_t m_state;
+		volatile uint32_t m_numWriters; // Writers waiting for lock.
+		volatile uint32_t m_numWaiters; // Threads parked on futex.
+	};
+
+	static void rwLockWait(RwLockInternal* _ri, uint32_t _state, uint32_t _spin)
+	{
+		if (_spin < kRwLockSpinCount)
+		{
+			spinPause();
+			return;
+		}
+
+		atomicFetchAndAdd<uint32_t>(&_ri->m_numWaiters, 1);
+		futexWait(&_ri->m_state, _state);
+		atomicFetchAndSub<uint32_t>(&_ri->m_numWaiters, 1);
+	}
+
+	static void rwLockWake(RwLockInternal* _ri)
+	{
+		// State change must be visible before waiters are checked, parked thread announces
+		// itself before futex checks state.
+		memoryBarrier();
+
+		if (0 < atomicLoad(&_ri->m_numWaiters) )
+		{
+			futexWake(&_ri->m_state, UINT32_MAX);
+		}
+	}
+
+	RwLock::RwLock()
+	{
+		BX_STATIC_ASSERT(sizeof(RwLockInternal) <= sizeof(m_internal) );
+
+		RwLockInternal* ri = (RwLockInternal*)m_internal;
+		ri->m_state      = 0;
+		ri->m_numWriters = 0;
+		ri->m_numWaiters = 0;
+	}
+
+	RwLock::~RwLock()
+	{
+	}
+
+	void RwLock::readLock()
+	{
+		RwLockInternal* ri = (RwLockInternal*)m_internal;
+
+		for (uint32_t spin = 0;; ++spin)
+		{
+			const uint32_t state = atomicLoad(&ri->m_state);
+
+			// Readers wait while writer is active, or waiting.
+			if (0 == (state & (kRwLockWriter | kRwLockWriterWaiting) ) )
+			{
+				if (state == atomicCompareAndSwap<uint32_t>(&ri->m_state, state, state+1) )
+				{
+					return;
+				}
+			}
+			else
+			{
+				rwLockWait(ri, state, spin);
+			}
+		}
+	}
+
+	void RwLock::readUnlock()
+	{
+		RwLockInternal* ri = (RwLockInternal*)m_internal;
+
+		const uint32_t state = atomicFetchAndSub<uint32_t>(&ri->m_state, 1) - 1;
+		BX_ASSERT(kRwLockReaderMask != (state & kRwLockReaderMask), "RwLock: readUnlock without readLock.");
+
+		// Last reader wakes waiting writer.
+		if (kRwLockWriterWaiting == state)
+		{
+			rwLockWake(ri);
+		}
+	}
+
+	void RwLock::writeLock()
+	{
+		RwLockInternal* ri = (RwLockInternal*)m_internal;
+
+		if (0 == atomicCompareAndSwap<uint32_t>(&ri->m_state, 0, kRwLockWriter) )
+		{
+			return;
+		}
+
+		atomicFetchAndAdd<uint32_t>(&ri->m_numWriters, 1);
+
+		for (uint32_t spin = 0;; ++spin)
+		{
+			const uint32_t state = atomicLoad(&ri->m_state);
+
+			if (0 == (state & (kRwLockWriter | kRwLockReaderMask) ) )
+			{
+				if (state == atomicCompareAndSwap<uint32_t>(&ri->m_state, state, kRwLockWriter) )
+				{
+					break;
+				}
+			}
+			else if (0 == (state & kRwLockWriterWaiting) )
+			{
+				// Stop new readers, before waiting for active ones to finish.
+				atomicCompareAndSwap<uint32_t>(&ri->m_state, state, state | kRwLockWriterWaiting);
+			}
+			else
+			{
+				rwLockWait(ri, state, spin);
+			}
+		}
+
+		atomicFetchAndSub<uint32_t>(&ri->m_numWriters, 1);
+	}
+
+	void RwLock::writeUnlock()
+	{
+		RwLockInternal* ri = (RwLockInternal*)m_internal;
+		BX_ASSERT(kRwLockWriter == (ri->m_state & kRwLockWriter), "RwLock: writeUnlock without writeLock.");
+
+		// Keep readers out while other writers are waiting.
+		const uint32_t state = 0 < atomicLoad(&ri->m_numWriters)
+			? kRwLockWriterWaiting
+			: 0
+			;
+
+		atomicStore(&ri->m_state, state);
+		rwLockWake(ri);
+	}
+
+#elif BX_CRT_NONE
+	// Without OS reader-writer lock, readers are exclusive too.
+	RwLock::RwLock()
+	{
+		BX_STATIC_ASSERT(sizeof(Mutex) <= sizeof(m_internal) );
+		BX_PLACEMENT_NEW(m_internal, Mutex);
+	}
+
+	RwLock::~RwLock()
+	{
+		( (Mutex*)m_internal)->~Mutex();
+	}
+
+	void RwLock::readLock()
+	{
+		( (Mutex*)m_internal)->lock();
+	}
+
+	void RwLock::readUnlock()
+	{
+		( (Mutex*)m_internal)->unlock();
+	}
+
+	void RwLock::writeLock()
+	{
+		( (Mutex*)m_internal)->lock();
+	}
+
+	void RwLock::writeUnlock()
+	{
+		( (Mutex*)m_internal)->unlock();
+	}
+
+#elif  BX_PLATFORM_WINDOWS \
+	|| BX_PLATFORM_WINRT   \
+	|| BX_PLATFORM_XBOXONE
+	RwLock::RwLock()
+	{
+		BX_STATIC_ASSERT(sizeof(SRWLOCK) <= sizeof(m_internal) );
+		InitializeSRWLock( (SRWLOCK*)m_internal);
+	}
+
+	RwLock::~RwLock()
+	{
+	}
+
+	void RwLock::readLock()
+	{
+		AcquireSRWLockShared( (SRWLOCK*)m_internal);
+	}
+
+	void RwLock::readUnlock()
+	{
+		ReleaseSRWLockShared( (SRWLOCK*)m_internal);
+	}
+
+	void RwLock::writeLock()
+	{
+		AcquireSRWLockExclusive( (SRWLOCK*)m_internal);
+	}
+
+	void RwLock::writeUnlock()
+	{
+		ReleaseSRWLockExclusive( (SRWLOCK*)m_internal);
+	}
+
+#elif BX_PLATFORM_POSIX
+	RwLock::RwLock()
+	{
+		BX_STATIC_ASSERT(sizeof(pthread_rwlock_t) <= sizeof(m_internal) );
+
+		int result = pthread_rwlock_init( (pthread_rwlock_t*)m_internal, NULL);
+		BX_ASSERT(0 == result, "pthread_rwlock_init %d", result); BX_UNUSED(result);
+	}
+
+	RwLock::~RwLock()
+	{
+		int result = pthread_rwlock_destroy( (pthread_rwlock_t*)m_internal);
+		BX_ASSERT(0 == result, "pthread_rwlock_destroy %d", result); BX_UNUSED(result);
+	}
+
+	void RwLock::readLock()
+	{
+		pthread_rwlock_rdlock( (pthread_rwlock_t*)m_internal);
+	}
+
+	void RwLock::readUnlock()
+	{
+		pthread_rwlock_unlock( (pthread_rwlock_t*)m_internal);
+	}
+
+	void RwLock::writeLock()
+	{
+		pthread_rwlock_wrlock( (pthread_rwlock_t*)m_internal);
+	}
+
+	void RwLock::writeUnlock()
+	{
+		pthread_rwlock_unlock( (pthread_rwlock_t*)m_internal);
+	}
+#endif // BX_PLATFORM_
+
+} // namespace bx
+
+#else
+
+namespace bx
+{
+	RwLock::RwLock()
+	{
+	}
+
+	RwLock::~RwLock()
+	{
+	}
+
+	void RwLock::readLock()
+	{
+	}
+
+	void RwLock::readUnlock()
+	{
+	}
+
+	void RwLock::writeLock()
+	{
+	}
+
+	void RwLock::writeUnlock()
+	{
+	}
+
+} // namespace bx
+
+#endif // BX_CONFIG_SUPPORTS_THREADING
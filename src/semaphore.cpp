@@ -11,6 +11,10 @@
 #elif  BX_PLATFORM_OSX \
 	|| BX_PLATFORM_IOS
 #	include <dispatch/dispatch.h>
+#elif BX_CONFIG_SUPPORTS_FUTEX
+#	include <bx/cpu.h>
+#	include <bx/timer.h>
+#	include "futex.h"
 #elif BX_PLATFORM_POSIX
 #	include <errno.h>
 #	include <pthread.h>
@@ -38,6 +42,9 @@ namespace bx
 #elif  BX_PLATFORM_OSX \
 	|| BX_PLATFORM_IOS
 		dispatch_semaphore_t m_handle;
+#elif BX_CONFIG_SUPPORTS_FUTEX
+		volatile uint32_t m_count;
+		volatile uint32_t m_numWaiters;
 #elif BX_PLATFORM_POSIX
 		pthread_mutex_t m_mutex;
 		pthread_cond_t m_cond;
@@ -108,6 +115,108 @@ namespace bx
 		return !dispatch_semaphore_wait(si->m_handle, dt);
 	}
 
+#elif BX_CONFIG_SUPPORTS_FUTEX
+	// Number of spins before thread is parked on futex.
+	static constexpr uint32_t kSemaphoreSpinCount = 64;
+
+	static bool tryDecrement(SemaphoreInternal* _si)
+	{
+		uint32_t count = atomicLoad(&_si->m_count);
+
+		while (0 < count)
+		{
+			const uint32_t prev = atomicCompareAndSwap<uint32_t>(&_si->m_count, count, count-1);
+
+			if (prev == count)
+			{
+				return true;
+			}
+
+			count = prev;
+		}
+
+		return false;
+	}
+
+	Semaphore::Semaphore()
+	{
+		BX_STATIC_ASSERT(sizeof(SemaphoreInternal) <= sizeof(m_internal) );
+
+		SemaphoreInternal* si = (SemaphoreInternal*)m_internal;
+		si->m_count      = 0;
+		si->m_numWaiters = 0;
+	}
+
+	Semaphore::~Semaphore()
+	{
+	}
+
+	void Semaphore::post(uint32_t _count)
+	{
+		SemaphoreInternal* si = (SemaphoreInternal*)m_internal;
+
+		atomicFetchAndAdd<uint32_t>(&si->m_count, _count);
+
+		// Waiter announces itself before last check of count, so either waiter sees new count,
+		// or post sees waiter. Without waiters post doesn't make syscall.
+		if (0 < atomicLoad(&si->m_numWaiters) )
+		{
+			futexWake(&si->m_count, _count);
+		}
+	}
+
+	bool Semaphore::wait(int32_t _msecs)
+	{
+		SemaphoreInternal* si = (SemaphoreInternal*)m_internal;
+
+		// Fast path doesn't make syscall when count is positive.
+		if (tryDecrement(si) )
+		{
+			return true;
+		}
+
+		for (uint32_t ii = 0; ii < kSemaphoreSpinCount; ++ii)
+		{
+			spinPause();
+
+			if (tryDecrement(si) )
+			{
+				return true;
+			}
+		}
+
+		const int64_t freq     = getHPFrequency();
+		const int64_t deadline = getHPCounter() + int64_t(_msecs)*freq/1000;
+
+		atomicFetchAndAdd<uint32_t>(&si->m_numWaiters, 1);
+
+		bool ok = tryDecrement(si);
+
+		while (!ok)
+		{
+			int32_t msecs = -1;
+
+			if (0 <= _msecs)
+			{
+				const int64_t remaining = deadline - getHPCounter();
+
+				if (0 >= remaining)
+				{
+					break;
+				}
+
+				msecs = int32_t(max<int64_t>(remaining*1000/freq, 1) );
+			}
+
+			futexWait(&si->m_count, 0, msecs);
+			ok = tryDecrement(si);
+		}
+
+		atomicFetchAndSub<uint32_t>(&si->m_numWaiters, 1);
+
+		return ok;
+	}
+
 #elif BX_PLATFORM_POSIX
 
 	uint64_t toNs(const timespec& _ts)
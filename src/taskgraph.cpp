@@ -0,0 +1,350 @@
+/*
+ * Copyright 2010-2023 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bx/blob/master/LICENSE
+ */
+
+#include <bx/sort.h>
+#include <bx/taskgraph.h>
+
+#if BX_CONFIG_SUPPORTS_THREADING
+
+namespace bx
+{
+	struct TaskGraph::Task
+	{
+		JobFn            fn;
+		void*            userData;
+		TaskGraph*       graph;
+		uint32_t         cost;
+		uint32_t         priority;
+		uint32_t         firstSuccessor;
+		uint16_t         numSuccessors;
+		uint16_t         numPredecessors;
+		volatile int32_t pending;
+	};
+
+	struct TaskGraph::Edge
+	{
+		uint16_t from;
+		uint16_t to;
+	};
+
+	TaskGraph::TaskGraph(AllocatorI* _allocator, uint32_t _maxTasks, uint32_t _maxEdges)
+		: m_allocator(_allocator)
+		, m_jobSystem(NULL)
+		, m_tasks(NULL)
+		, m_edges(NULL)
+		, m_successors(NULL)
+		, m_roots(NULL)
+		, m_order(NULL)
+		, m_maxTasks(min<uint32_t>(_maxTasks, kInvalidHandle) )
+		, m_maxEdges(_maxEdges)
+		, m_numTasks(0)
+		, m_numRoots(0)
+		, m_numOrdered(0)
+		, m_numEdges(0)
+		, m_dirty(false)
+	{
+		m_tasks      = (Task*    )BX_ALLOC(m_allocator, m_maxTasks*sizeof(Task) );
+		m_edges      = (Edge*    )BX_ALLOC(m_allocator, m_maxEdges*sizeof(Edge) );
+		m_successors = (uint16_t*)BX_ALLOC(m_allocator, m_maxEdges*sizeof(uint16_t) );
+		m_roots      = (uint16_t*)BX_ALLOC(m_allocator, m_maxTasks*sizeof(uint16_t) );
+		m_order      = (uint16_t*)BX_ALLOC(m_allocator, m_maxTasks*sizeof(uint16_t) );
+	}
+
+	TaskGraph::~TaskGraph()
+	{
+		BX_FREE(m_allocator, m_order);
+		BX_FREE(m_allocator, m_roots);
+		BX_FREE(m_allocator, m_successors);
+		BX_FREE(m_allocator, m_edges);
+		BX_FREE(m_allocator, m_tasks);
+	}
+
+	uint16_t TaskGraph::add(JobFn _fn, void* _userData, uint32_t _cost)
+	{
+		if (m_numTasks == m_maxTasks)
+		{
+			return kInvalidHandle;
+		}
+
+		const uint16_t index = m_numTasks;
+		++m_numTasks;
+
+		Task& task = m_tasks[index];
+		task.fn              = _fn;
+		task.userData        = _userData;
+		task.graph           = this;
+		task.cost            = _cost;
+		task.priority        = _cost;
+		task.firstSuccessor  = 0;
+		task.numSuccessors   = 0;
+		task.numPredecessors = 0;
+		task.pending         = 0;
+
+		m_dirty = true;
+
+		return index;
+	}
+
+	bool TaskGraph::addEdge(uint16_t _from, uint16_t _to)
+	{
+		BX_ASSERT(_from < m_numTasks && _to < m_numTasks && _from != _to
+			, "TaskGraph: Invalid edge %d -> %d."
+			, _from
+			, _to
+			);
+
+		if (m_numEdges == m_maxEdges)
+		{
+			return false;
+		}
+
+		Edge& edge = m_edges[m_numEdges];
+		edge.from = _from;
+		edge.to   = _to;
+		++m_numEdges;
+
+		m_dirty = true;
+
+		return true;
+	}
+
+	void TaskGraph::reset()
+	{
+		m_numTasks   = 0;
+		m_numRoots   = 0;
+		m_numOrdered = 0;
+		m_numEdges   = 0;
+		m_dirty      = false;
+	}
+
+	uint16_t TaskGraph::getNumTasks() const
+	{
+		return m_numTasks;
+	}
+
+	uint32_t TaskGraph::getPriority(uint16_t _task)
+	{
+		BX_ASSERT(_task < m_numTasks, "TaskGraph: Invalid task %d.", _task);
+
+		if (m_dirty)
+		{
+			compile();
+		}
+
+		return m_tasks[_task].priority;
+	}
+
+	void TaskGraph::compile()
+	{
+		const uint32_t numTasks = m_numTasks;
+
+		// Successor lists are stored contiguously, in edge order first.
+		for (uint32_t ii = 0; ii < numTasks; ++ii)
+		{
+			Task& task = m_tasks[ii];
+			task.priority        = task.cost;
+			task.numSuccessors   = 0;
+			task.numPredecessors = 0;
+		}
+
+		for (uint32_t ii = 0; ii < m_numEdges; ++ii)
+		{
+			const Edge& edge = m_edges[ii];
+			++m_tasks[edge.from].numSuccessors;
+			++m_tasks[edge.to].numPredecessors;
+		}
+
+		uint32_t first = 0;
+		for (uint32_t ii = 0; ii < numTasks; ++ii)
+		{
+			Task& task = m_tasks[ii];
+			task.firstSuccessor = first;
+			task.pending        = 0;
+			first += task.numSuccessors;
+		}
+
+		for (uint32_t ii = 0; ii < m_numEdges; ++ii)
+		{
+			const Edge& edge = m_edges[ii];
+			Task& from = m_tasks[edge.from];
+			m_successors[from.firstSuccessor + from.pending] = edge.to;
+			++from.pending;
+		}
+
+		// Topological order (Kahn's algorithm), m_order is used as queue.
+		uint32_t numOrdered = 0;
+		for (uint32_t ii = 0; ii < numTasks; ++ii)
+		{
+			Task& task = m_tasks[ii];
+			task.pending = task.numPredecessors;
+
+			if (0 == task.numPredecessors)
+			{
+				m_order[numOrdered++] = uint16_t(ii);
+			}
+		}
+
+		for (uint32_t ii = 0; ii < numOrdered; ++ii)
+		{
+			const Task& task = m_tasks[m_order[ii] ];
+
+			for (uint32_t jj = 0; jj < task.numSuccessors; ++jj)
+			{
+				const uint16_t successor = m_successors[task.firstSuccessor + jj];
+
+				if (0 == --m_tasks[successor].pending)
+				{
+					m_order[numOrdered++] = successor;
+				}
+			}
+		}
+
+		// Tasks on cycle, and tasks after them, never become ready and are not ordered.
+		m_numOrdered = uint16_t(numOrdered);
+
+		// Priority is cost of the longest path to the end of graph, computed in reverse
+		// topological order so that successor priorities are known.
+		for (uint32_t ii = numOrdered; 0 < ii; --ii)
+		{
+			Task& task = m_tasks[m_order[ii-1] ];
+
+			uint32_t priority = 0;
+			for (uint32_t jj = 0; jj < task.numSuccessors; ++jj)
+			{
+				priority = max(priority, m_tasks[m_successors[task.firstSuccessor + jj] ].priority);
+			}
+
+			task.priority = task.cost + priority;
+		}
+
+		// Sort successors and roots by descending priority. Sort key is priority in high bits,
+		// and task index in low bits.
+		uint64_t* keys = (uint64_t*)BX_ALLOC(m_allocator, max(numTasks, m_numEdges)*sizeof(uint64_t) );
+
+		for (uint32_t ii = 0; ii < numTasks; ++ii)
+		{
+			Task& task = m_tasks[ii];
+			uint16_t* successors = &m_successors[task.firstSuccessor];
+
+			for (uint32_t jj = 0; jj < task.numSuccessors; ++jj)
+			{
+				keys[jj] = uint64_t(m_tasks[successors[jj] ].priority)<<32 | successors[jj];
+			}
+
+			quickSort(keys, task.numSuccessors, compareDescending<uint64_t>);
+
+			for (uint32_t jj = 0; jj < task.numSuccessors; ++jj)
+			{
+				successors[jj] = uint16_t(keys[jj]);
+			}
+		}
+
+		uint32_t numRoots = 0;
+		for (uint32_t ii = 0; ii < numTasks; ++ii)
+		{
+			if (0 == m_tasks[ii].numPredecessors)
+			{
+				keys[numRoots++] = uint64_t(m_tasks[ii].priority)<<32 | ii;
+			}
+		}
+
+		quickSort(keys, numRoots, compareDescending<uint64_t>);
+
+		for (uint32_t ii = 0; ii < numRoots; ++ii)
+		{
+			m_roots[ii] = uint16_t(keys[ii]);
+		}
+
+		m_numRoots = uint16_t(numRoots);
+
+		BX_FREE(m_allocator, keys);
+
+		m_dirty = false;
+	}
+
+	bool TaskGraph::run(JobSystem* _jobSystem)
+	{
+		if (m_dirty)
+		{
+			compile();
+		}
+
+		if (m_numOrdered != m_numTasks)
+		{
+			return false;
+		}
+
+		if (NULL == _jobSystem)
+		{
+			for (uint32_t ii = 0; ii < m_numOrdered; ++ii)
+			{
+				const Task& task = m_tasks[m_order[ii] ];
+				task.fn(task.userData);
+			}
+
+			return true;
+		}
+
+		// Reset predecessor counts, adding job publishes them to workers.
+		for (uint32_t ii = 0; ii < m_numTasks; ++ii)
+		{
+			Task& task = m_tasks[ii];
+			task.pending = task.numPredecessors;
+		}
+
+		m_jobSystem = _jobSystem;
+
+		for (uint32_t ii = 0; ii < m_numRoots; ++ii)
+		{
+			m_jobSystem->add(taskFn, &m_tasks[m_roots[ii] ], &m_counter);
+		}
+
+		m_jobSystem->wait(&m_counter);
+		m_jobSystem = NULL;
+
+		return true;
+	}
+
+	void TaskGraph::taskFn(void* _userData)
+	{
+		Task* task = (Task*)_userData;
+		task->graph->execute(task);
+	}
+
+	void TaskGraph::execute(Task* _task)
+	{
+		Task* task = _task;
+
+		while (NULL != task)
+		{
+			task->fn(task->userData);
+
+			// Successors are in descending priority order, highest priority ready successor
+			// continues on this thread, others are added to job system. They are added in
+			// ascending priority order, since worker pops jobs from its deque in LIFO order.
+			Task* next = NULL;
+
+			for (uint32_t ii = task->numSuccessors; 0 < ii; --ii)
+			{
+				Task* successor = &m_tasks[m_successors[task->firstSuccessor + ii - 1] ];
+
+				if (1 == atomicFetchAndSub<int32_t>(&successor->pending, 1) )
+				{
+					if (NULL != next)
+					{
+						m_jobSystem->add(taskFn, next, &m_counter);
+					}
+
+					next = successor;
+				}
+			}
+
+			task = next;
+		}
+	}
+
+} // namespace bx
+
+#endif // BX_CONFIG_SUPPORTS_THREADING
@@ -30,6 +30,12 @@
 #	if BX_PLATFORM_LINUX && (BX_CRT_GLIBC < 21200)
 #		include <sys/prctl.h>
 #	endif // BX_PLATFORM_
+#	if  BX_PLATFORM_ANDROID \
+	||  BX_PLATFORM_LINUX   \
+	||  BX_PLATFORM_RPI
+#		include <sched.h>        // cpu_set_t
+#		include <sys/resource.h> // setpriority
+#	endif // BX_PLATFORM_
 #elif  BX_PLATFORM_WINDOWS \
 	|| BX_PLATFORM_WINRT   \
 	|| BX_PLATFORM_XBOXONE \
@@ -64,6 +70,7 @@ namespace bx
 #elif BX_PLATFORM_POSIX
 		static void* threadFunc(void* _arg);
 		pthread_t m_handle;
+		uint32_t  m_tid;
 #endif // BX_PLATFORM_
 	};
 
@@ -117,6 +124,7 @@ namespace bx
 		ti->m_threadId = UINT32_MAX;
 #elif BX_PLATFORM_POSIX
 		ti->m_handle = 0;
+		ti->m_tid    = 0;
 #endif // BX_PLATFORM_
 	}
 
@@ -128,7 +136,14 @@ namespace bx
 		}
 	}
 
-	bool Thread::init(ThreadFn _fn, void* _userData, uint32_t _stackSize, const char* _name)
+	bool Thread::init(
+		  ThreadFn _fn
+		, void* _userData
+		, uint32_t _stackSize
+		, const char* _name
+		, uint64_t _affinityMask
+		, ThreadPriority::Enum _priority
+		)
 	{
 		BX_ASSERT(!m_running, "Already running!");
 
@@ -199,6 +214,18 @@ namespace bx
 			setThreadName(_name);
 		}
 
+		if (0 != _affinityMask)
+		{
+			const bool ok = setAffinity(_affinityMask);
+			BX_WARN(ok, "setAffinity failed!"); BX_UNUSED(ok);
+		}
+
+		if (ThreadPriority::Normal != _priority)
+		{
+			const bool ok = setPriority(_priority);
+			BX_WARN(ok, "setPriority failed!"); BX_UNUSED(ok);
+		}
+
 		return true;
 	}
 
@@ -306,6 +333,93 @@ namespace bx
 #endif // BX_PLATFORM_
 	}
 
+	bool Thread::setAffinity(uint64_t _mask)
+	{
+		ThreadInternal* ti = (ThreadInternal*)m_internal;
+		BX_UNUSED(ti, _mask);
+#if BX_CRT_NONE
+		return false;
+#elif BX_PLATFORM_WINDOWS
+		return 0 != ::SetThreadAffinityMask(ti->m_handle, DWORD_PTR(_mask) );
+#elif  BX_PLATFORM_ANDROID \
+	|| BX_PLATFORM_LINUX   \
+	|| BX_PLATFORM_RPI
+		cpu_set_t cpuSet;
+		CPU_ZERO(&cpuSet);
+
+		for (uint32_t ii = 0; ii < 64; ++ii)
+		{
+			if (0 != (_mask & (UINT64_C(1) << ii) ) )
+			{
+				CPU_SET(ii, &cpuSet);
+			}
+		}
+
+		return 0 == ::sched_setaffinity(pid_t(ti->m_tid), sizeof(cpuSet), &cpuSet);
+#else
+		return false;
+#endif // BX_PLATFORM_
+	}
+
+	bool Thread::setPriority(ThreadPriority::Enum _priority)
+	{
+		BX_ASSERT(_priority < ThreadPriority::Count, "Invalid priority %d.", _priority);
+
+		ThreadInternal* ti = (ThreadInternal*)m_internal;
+		BX_UNUSED(ti, _priority);
+#if BX_CRT_NONE
+		return false;
+#elif BX_PLATFORM_WINDOWS
+		static const int s_priority[] =
+		{
+			THREAD_PRIORITY_IDLE,
+			THREAD_PRIORITY_LOWEST,
+			THREAD_PRIORITY_BELOW_NORMAL,
+			THREAD_PRIORITY_NORMAL,
+			THREAD_PRIORITY_ABOVE_NORMAL,
+			THREAD_PRIORITY_HIGHEST,
+		};
+		BX_STATIC_ASSERT(BX_COUNTOF(s_priority) == ThreadPriority::Count);
+
+		return 0 != ::SetThreadPriority(ti->m_handle, s_priority[_priority]);
+#elif  BX_PLATFORM_ANDROID \
+	|| BX_PLATFORM_LINUX   \
+	|| BX_PLATFORM_RPI
+		// Threads with default scheduling policy all have static priority zero, and on Linux
+		// nice value is per thread, so it's used instead.
+		static const int s_nice[] =
+		{
+			19,
+			10,
+			5,
+			0,
+			-5,
+			-10,
+		};
+		BX_STATIC_ASSERT(BX_COUNTOF(s_nice) == ThreadPriority::Count);
+
+		return 0 == ::setpriority(PRIO_PROCESS, id_t(ti->m_tid), s_nice[_priority]);
+#elif  BX_PLATFORM_BSD \
+	|| BX_PLATFORM_IOS \
+	|| BX_PLATFORM_OSX
+		int policy;
+		sched_param param;
+
+		if (0 != pthread_getschedparam(ti->m_handle, &policy, &param) )
+		{
+			return false;
+		}
+
+		const int minPriority = sched_get_priority_min(policy);
+		const int maxPriority = sched_get_priority_max(policy);
+		param.sched_priority = minPriority + (maxPriority - minPriority)*_priority/(ThreadPriority::Count-1);
+
+		return 0 == pthread_setschedparam(ti->m_handle, policy, &param);
+#else
+		return false;
+#endif // BX_PLATFORM_
+	}
+
 	void Thread::push(void* _ptr)
 	{
 		m_queue.push(_ptr);
@@ -319,10 +433,13 @@ namespace bx
 
 	int32_t Thread::entry()
 	{
-#if BX_PLATFORM_WINDOWS
 		ThreadInternal* ti = (ThreadInternal*)m_internal;
+		BX_UNUSED(ti);
+#if BX_PLATFORM_WINDOWS
 		ti->m_threadId = ::GetCurrentThreadId();
-#endif // BX_PLATFORM_WINDOWS
+#elif BX_PLATFORM_POSIX && !BX_CRT_NONE
+		ti->m_tid = getTid();
+#endif // BX_PLATFORM_
 
 		m_sem.post();
 		int32_t result = m_fn(this, m_userData);
@@ -427,6 +544,343 @@ namespace bx
 	}
 #endif // BX_PLATFORM_*
 
+	// Size classes are powers of two from 16 up to 2048 bytes. Each block is preceded by header,
+	// which keeps size class, so that free can find magazine block belongs to.
+	static constexpr uint32_t kTcaNumSizeClasses = 8;
+	static constexpr uint32_t kTcaMinSizeShift   = 4;
+	static constexpr uint32_t kTcaMagazineSize   = 64;
+	static constexpr uint32_t kTcaBatchSize      = kTcaMagazineSize/2;
+	static constexpr uint32_t kTcaAlign          = 16;
+	static constexpr uint32_t kTcaLarge          = UINT32_MAX;
+
+	struct TcaHeader
+	{
+		uint32_t sizeClass;
+		uint32_t offset;
+		uint64_t size;
+	};
+
+	BX_STATIC_ASSERT(sizeof(TcaHeader) == kTcaAlign);
+
+	struct TcaChunk
+	{
+		TcaChunk* next;
+		uint64_t  padding;
+	};
+
+	BX_STATIC_ASSERT(sizeof(TcaChunk) % kTcaAlign == 0);
+
+	inline uint32_t getSizeClass(size_t _size)
+	{
+		const uint32_t size = uint32_t(max(_size, size_t(1) ) - 1);
+		return uint32_max(32 - uint32_cntlz(size), kTcaMinSizeShift) - kTcaMinSizeShift;
+	}
+
+	inline uint32_t getSizeClassSize(uint32_t _sizeClass)
+	{
+		return UINT32_C(1) << (_sizeClass + kTcaMinSizeShift);
+	}
+
+	inline TcaHeader* getTcaHeader(void* _ptr)
+	{
+		return (TcaHeader*)_ptr - 1;
+	}
+
+	struct ThreadCachingAllocator::ThreadCache
+	{
+		ThreadCache* next;
+		uint32_t tid;
+
+		// Written only by owning thread, read by `getStats` from other threads.
+		volatile uint64_t numHits;
+		volatile uint64_t numMisses;
+		volatile uint64_t numFlushes;
+
+		uint32_t num[kTcaNumSizeClasses];
+		void*    magazine[kTcaNumSizeClasses][kTcaMagazineSize];
+	};
+
+	ThreadCachingAllocator::ThreadCachingAllocator(AllocatorI* _allocator)
+		: m_allocator(_allocator)
+		, m_cache(NULL)
+		, m_chunk(NULL)
+	{
+		BX_STATIC_ASSERT(BX_COUNTOF(m_depot) == kTcaNumSizeClasses);
+		memSet(m_depot, 0, sizeof(m_depot) );
+	}
+
+	ThreadCachingAllocator::~ThreadCachingAllocator()
+	{
+		for (ThreadCache* cache = m_cache; NULL != cache;)
+		{
+			ThreadCache* next = cache->next;
+			BX_FREE(m_allocator, cache);
+			cache = next;
+		}
+
+		for (TcaChunk* chunk = (TcaChunk*)m_chunk; NULL != chunk;)
+		{
+			TcaChunk* next = chunk->next;
+			BX_ALIGNED_FREE(m_allocator, chunk, kTcaAlign);
+			chunk = next;
+		}
+	}
+
+	void* ThreadCachingAllocator::realloc(void* _ptr, size_t _size, size_t _align, const char* _file, uint32_t _line)
+	{
+		if (0 == _size)
+		{
+			if (NULL != _ptr)
+			{
+				free(_ptr, _file, _line);
+			}
+
+			return NULL;
+		}
+		else if (NULL == _ptr)
+		{
+			return alloc(_size, _align, _file, _line);
+		}
+
+		const TcaHeader* header = getTcaHeader(_ptr);
+		const size_t oldSize = kTcaLarge == header->sizeClass
+			? size_t(header->size)
+			: getSizeClassSize(header->sizeClass)
+			;
+
+		if (kTcaLarge != header->sizeClass
+		&&  _align <= kTcaAlign
+		&&  getSizeClass(_size) == header->sizeClass)
+		{
+			return _ptr;
+		}
+
+		void* ptr = alloc(_size, _align, _file, _line);
+		if (NULL != ptr)
+		{
+			memCopy(ptr, _ptr, min(oldSize, _size) );
+			free(_ptr, _file, _line);
+		}
+
+		return ptr;
+	}
+
+	uint32_t ThreadCachingAllocator::getStats(ThreadCacheStats* _outStats, uint32_t _max)
+	{
+		MutexScope scope(m_lock);
+
+		uint32_t num = 0;
+		for (const ThreadCache* cache = m_cache; NULL != cache; cache = cache->next, ++num)
+		{
+			if (NULL != _outStats
+			&&  num < _max)
+			{
+				ThreadCacheStats& stats = _outStats[num];
+				stats.tid        = cache->tid;
+				stats.numHits    = atomicLoad(&cache->numHits);
+				stats.numMisses  = atomicLoad(&cache->numMisses);
+				stats.numFlushes = atomicLoad(&cache->numFlushes);
+			}
+		}
+
+		return num;
+	}
+
+	void ThreadCachingAllocator::releaseThreadCache()
+	{
+		ThreadCache* cache = (ThreadCache*)m_tls.get();
+
+		if (NULL == cache)
+		{
+			return;
+		}
+
+		m_tls.set(NULL);
+
+		{
+			MutexScope scope(m_lock);
+
+			for (uint32_t sizeClass = 0; sizeClass < kTcaNumSizeClasses; ++sizeClass)
+			{
+				void** magazine = cache->magazine[sizeClass];
+
+				for (uint32_t ii = 0, num = cache->num[sizeClass]; ii < num; ++ii)
+				{
+					*(void**)magazine[ii] = m_depot[sizeClass];
+					m_depot[sizeClass] = magazine[ii];
+				}
+			}
+
+			ThreadCache** link = &m_cache;
+			for (; cache != *link; link = &(*link)->next)
+			{
+			}
+
+			*link = cache->next;
+		}
+
+		BX_FREE(m_allocator, cache);
+	}
+
+	ThreadCachingAllocator::ThreadCache* ThreadCachingAllocator::getThreadCache()
+	{
+		ThreadCache* cache = (ThreadCache*)m_tls.get();
+
+		if (BX_UNLIKELY(NULL == cache) )
+		{
+			cache = (ThreadCache*)BX_ALLOC(m_allocator, sizeof(ThreadCache) );
+			memSet(cache, 0, sizeof(ThreadCache) );
+			cache->tid = getTid();
+
+			{
+				MutexScope scope(m_lock);
+				cache->next = m_cache;
+				m_cache = cache;
+			}
+
+			m_tls.set(cache);
+		}
+
+		return cache;
+	}
+
+	void* ThreadCachingAllocator::alloc(size_t _size, size_t _align, const char* _file, uint32_t _line)
+	{
+		const uint32_t sizeClass = getSizeClass(_size);
+
+		if (sizeClass >= kTcaNumSizeClasses
+		||  _align    >  kTcaAlign)
+		{
+			const size_t align = max(_align, size_t(kTcaAlign) );
+			uint8_t* ptr = (uint8_t*)alignedAlloc(m_allocator, _size + align, align, _file, _line);
+
+			if (NULL == ptr)
+			{
+				return NULL;
+			}
+
+			ptr += align;
+
+			TcaHeader* header = getTcaHeader(ptr);
+			header->sizeClass = kTcaLarge;
+			header->offset    = uint32_t(align);
+			header->size      = _size;
+			return ptr;
+		}
+
+		ThreadCache* cache = getThreadCache();
+
+		if (0 == cache->num[sizeClass])
+		{
+			atomicStore<uint64_t>(&cache->numMisses, cache->numMisses + 1);
+			refill(cache, sizeClass);
+
+			if (0 == cache->num[sizeClass])
+			{
+				return NULL;
+			}
+		}
+		else
+		{
+			atomicStore<uint64_t>(&cache->numHits, cache->numHits + 1);
+		}
+
+		return cache->magazine[sizeClass][--cache->num[sizeClass] ];
+	}
+
+	void ThreadCachingAllocator::free(void* _ptr, const char* _file, uint32_t _line)
+	{
+		TcaHeader* header = getTcaHeader(_ptr);
+
+		if (kTcaLarge == header->sizeClass)
+		{
+			alignedFree(m_allocator, (uint8_t*)_ptr - header->offset, header->offset, _file, _line);
+			return;
+		}
+
+		const uint32_t sizeClass = header->sizeClass;
+		ThreadCache* cache = getThreadCache();
+
+		if (kTcaMagazineSize == cache->num[sizeClass])
+		{
+			atomicStore<uint64_t>(&cache->numFlushes, cache->numFlushes + 1);
+			flush(cache, sizeClass);
+		}
+
+		cache->magazine[sizeClass][cache->num[sizeClass]++] = _ptr;
+	}
+
+	void ThreadCachingAllocator::refill(ThreadCache* _cache, uint32_t _sizeClass)
+	{
+		void** magazine = _cache->magazine[_sizeClass];
+		uint32_t num = 0;
+
+		{
+			MutexScope scope(m_lock);
+
+			void* ptr = m_depot[_sizeClass];
+			for (; NULL != ptr && num < kTcaBatchSize; ++num)
+			{
+				magazine[num] = ptr;
+				ptr = *(void**)ptr;
+			}
+
+			m_depot[_sizeClass] = ptr;
+		}
+
+		if (0 < num)
+		{
+			_cache->num[_sizeClass] = num;
+			return;
+		}
+
+		const uint32_t stride = kTcaAlign + getSizeClassSize(_sizeClass);
+		TcaChunk* chunk = (TcaChunk*)BX_ALIGNED_ALLOC(m_allocator, sizeof(TcaChunk) + stride*kTcaBatchSize, kTcaAlign);
+
+		if (NULL == chunk)
+		{
+			return;
+		}
+
+		{
+			MutexScope scope(m_lock);
+			chunk->next = (TcaChunk*)m_chunk;
+			m_chunk = chunk;
+		}
+
+		uint8_t* data = (uint8_t*)(chunk + 1);
+
+		for (; num < kTcaBatchSize; ++num)
+		{
+			uint8_t* ptr = &data[num*stride + kTcaAlign];
+
+			TcaHeader* header = getTcaHeader(ptr);
+			header->sizeClass = _sizeClass;
+			header->offset    = 0;
+			header->size      = 0;
+
+			magazine[num] = ptr;
+		}
+
+		_cache->num[_sizeClass] = num;
+	}
+
+	void ThreadCachingAllocator::flush(ThreadCache* _cache, uint32_t _sizeClass)
+	{
+		void** magazine = &_cache->magazine[_sizeClass][kTcaMagazineSize - kTcaBatchSize];
+
+		for (uint32_t ii = 0; ii < kTcaBatchSize-1; ++ii)
+		{
+			*(void**)magazine[ii] = magazine[ii+1];
+		}
+
+		_cache->num[_sizeClass] -= kTcaBatchSize;
+
+		MutexScope scope(m_lock);
+		*(void**)magazine[kTcaBatchSize-1] = m_depot[_sizeClass];
+		m_depot[_sizeClass] = magazine[0];
+	}
+
 } // namespace bx
 
 #endif // BX_CONFIG_SUPPORTS_THREADING
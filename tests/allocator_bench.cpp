@@ -0,0 +1,143 @@
+/*
+ * Copyright 2010-2023 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bx/blob/master/LICENSE
+ */
+
+#include <bx/allocator.h>
+#include <bx/file.h>
+#include <bx/rng.h>
+#include <bx/thread.h>
+#include <bx/timer.h>
+
+static const uint32_t kNumAllocs     = 16<<10;
+static const uint32_t kNumIterations = 64;
+
+static void allocFree(const char* _name, bx::AllocatorI* _allocator, bx::LinearAllocator* _linear)
+{
+	bx::WriterI* writer = bx::getStdOut();
+	bx::Error err;
+
+	void** ptrs = (void**)alloca(kNumAllocs*sizeof(void*) );
+
+	bx::RngMwc rng;
+
+	int64_t elapsed = -bx::getHPCounter();
+
+	for (uint32_t ii = 0; ii < kNumIterations; ++ii)
+	{
+		for (uint32_t jj = 0; jj < kNumAllocs; ++jj)
+		{
+			const size_t size = 16 + rng.gen()%240;
+			ptrs[jj] = BX_ALLOC(_allocator, size);
+		}
+
+		for (uint32_t jj = 0; jj < kNumAllocs; ++jj)
+		{
+			BX_FREE(_allocator, ptrs[jj]);
+		}
+
+		if (NULL != _linear)
+		{
+			_linear->reset();
+		}
+	}
+
+	elapsed += bx::getHPCounter();
+
+	bx::write(writer, &err, "%-24s: %15f\n", _name, double(elapsed) );
+}
+
+static void allocLatency(const char* _name, bx::AllocatorI* _allocator, bx::TlsfAllocator* _tlsf)
+{
+	bx::WriterI* writer = bx::getStdOut();
+	bx::Error err;
+
+	const uint32_t kNumSlots = 4<<10;
+	const uint32_t kNumOps   = 256<<10;
+
+	void** ptrs = (void**)alloca(kNumSlots*sizeof(void*) );
+	bx::memSet(ptrs, 0, kNumSlots*sizeof(void*) );
+
+	bx::RngMwc rng;
+
+	int64_t total = 0;
+	int64_t worst = 0;
+
+	for (uint32_t ii = 0; ii < kNumOps; ++ii)
+	{
+		void*& ptr = ptrs[rng.gen() % kNumSlots];
+		const size_t size = 16 + rng.gen() % (16<<10);
+
+		int64_t elapsed = -bx::getHPCounter();
+
+		if (NULL != ptr)
+		{
+			BX_FREE(_allocator, ptr);
+		}
+
+		ptr = BX_ALLOC(_allocator, size);
+
+		elapsed += bx::getHPCounter();
+
+		total += elapsed;
+		worst  = bx::max(worst, elapsed);
+	}
+
+	bx::write(writer, &err, "%-24s: %15f avg %15f max", _name, double(total)/double(kNumOps), double(worst) );
+
+	if (NULL != _tlsf)
+	{
+		// External fragmentation, how much of free memory is not usable for largest allocation.
+		const size_t freeSize = _tlsf->getTotalSize() - _tlsf->getUsedSize();
+		const double fragmentation = 1.0 - double(_tlsf->getMaxFreeBlockSize() )/double(freeSize);
+
+		bx::write(writer, &err, ", used %.1f%%, fragmentation %.1f%%"
+			, 100.0*double(_tlsf->getUsedSize() )/double(_tlsf->getTotalSize() )
+			, 100.0*fragmentation
+			);
+	}
+
+	bx::write(writer, &err, "\n");
+
+	for (uint32_t ii = 0; ii < kNumSlots; ++ii)
+	{
+		if (NULL != ptrs[ii])
+		{
+			BX_FREE(_allocator, ptrs[ii]);
+		}
+	}
+}
+
+void allocator_bench()
+{
+	bx::WriterI* writer = bx::getStdOut();
+	bx::Error err;
+	bx::write(writer, &err, "Allocator bench\n\n");
+
+	bx::DefaultAllocator defaultAllocator;
+	allocFree("DefaultAllocator", &defaultAllocator, NULL);
+
+	bx::LinearAllocator linearAllocator(&defaultAllocator, 1<<20);
+	allocFree("LinearAllocator", &linearAllocator, &linearAllocator);
+
+	bx::PoolAllocatorT<256, 1<<10> poolAllocator(&defaultAllocator);
+	allocFree("PoolAllocator", &poolAllocator, NULL);
+
+	bx::ConcurrentPoolAllocatorT<256, 1<<10> concurrentPoolAllocator(&defaultAllocator);
+	allocFree("ConcurrentPoolAllocator", &concurrentPoolAllocator, NULL);
+
+	bx::TlsfAllocator tlsfAllocator(&defaultAllocator, 16<<20);
+	allocFree("TlsfAllocator", &tlsfAllocator, NULL);
+
+#if BX_CONFIG_SUPPORTS_THREADING
+	bx::ThreadCachingAllocator threadCachingAllocator(&defaultAllocator);
+	allocFree("ThreadCachingAllocator", &threadCachingAllocator, NULL);
+#endif // BX_CONFIG_SUPPORTS_THREADING
+
+	bx::write(writer, &err, "\nAllocator latency\n\n");
+
+	allocLatency("DefaultAllocator", &defaultAllocator, NULL);
+	allocLatency("TlsfAllocator", &tlsfAllocator, &tlsfAllocator);
+
+	bx::write(writer, &err, "\n");
+}
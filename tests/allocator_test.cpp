@@ -6,6 +6,10 @@
 #include "test.h"
 
 #include <bx/allocator.h>
+#include <bx/readerwriter.h>
+#include <bx/rng.h>
+#include <bx/spscqueue.h>
+#include <bx/thread.h>
 
 struct MockNonFreeingAllocator : public bx::AllocatorI
 {
@@ -76,3 +80,398 @@ TEST_CASE("Allocator", "")
 	REQUIRE(testAlignment(1,   bx::alignedAlloc(&mnfa, 1, 1  ) ) );
 	REQUIRE(testAlignment(128, bx::alignedAlloc(&mnfa, 1, 128) ) );
 }
+
+TEST_CASE("LinearAllocator", "")
+{
+	bx::DefaultAllocator allocator;
+	bx::LinearAllocator linear(&allocator, 1024);
+
+	REQUIRE(0 == linear.getUsedSize() );
+
+	void* ptr0 = BX_ALLOC(&linear, 100);
+	REQUIRE(ptr0 != NULL);
+	REQUIRE(testAlignment(8, ptr0) );
+
+	for (uint32_t align = 1; align <= 256; align <<= 1)
+	{
+		REQUIRE(testAlignment(align, BX_ALIGNED_ALLOC(&linear, 3, align) ) );
+	}
+
+	// Resizing last allocation grows in place.
+	void* ptr1 = BX_ALLOC(&linear, 16);
+	bx::memSet(ptr1, 0xaa, 16);
+	REQUIRE(ptr1 == BX_REALLOC(&linear, ptr1, 64) );
+
+	// Resizing older allocation copies content.
+	bx::memSet(ptr0, 0x55, 100);
+	uint8_t* ptr2 = (uint8_t*)BX_REALLOC(&linear, ptr0, 200);
+	REQUIRE(ptr2 != ptr0);
+	REQUIRE(0x55 == ptr2[0]);
+	REQUIRE(0x55 == ptr2[99]);
+
+	// Allocation bigger than chunk size.
+	void* ptr3 = BX_ALLOC(&linear, 4096);
+	REQUIRE(ptr3 != NULL);
+
+	{
+		bx::LinearAllocatorScope scope(linear);
+		const size_t used = linear.getUsedSize();
+
+		{
+			bx::LinearAllocatorScope nested(linear);
+			BX_ALLOC(&linear, 512);
+			BX_ALLOC(&linear, 2048);
+			REQUIRE(used < linear.getUsedSize() );
+		}
+
+		REQUIRE(used == linear.getUsedSize() );
+		BX_ALLOC(&linear, 64);
+	}
+
+	linear.reset();
+	REQUIRE(0 == linear.getUsedSize() );
+
+	// Chunks are reused after reset.
+	void* ptr4 = BX_ALLOC(&linear, 100);
+	REQUIRE(ptr4 == ptr0);
+
+	BX_FREE(&linear, ptr4);
+	REQUIRE(0 == linear.getUsedSize() );
+
+	linear.trim();
+}
+
+TEST_CASE("VirtualArenaAllocator", "")
+{
+	bx::VirtualArenaAllocator arena(64<<20, 64<<10);
+	REQUIRE( (64<<20) == arena.getReservedSize() );
+	REQUIRE(0 == arena.getCommittedSize() );
+
+	uint8_t* ptr0 = (uint8_t*)BX_ALLOC(&arena, 100);
+	REQUIRE(ptr0 != NULL);
+	REQUIRE( (64<<10) == arena.getCommittedSize() );
+
+	// Last allocation grows in place.
+	uint8_t* buffer = (uint8_t*)BX_ALIGNED_ALLOC(&arena, 1<<10, 64);
+	REQUIRE(bx::isAligned(buffer, 64) );
+
+	for (uint32_t size = 2<<10; size <= 8<<20; size *= 2)
+	{
+		bx::memSet(buffer, 0xfe, size/2);
+		REQUIRE(buffer == BX_ALIGNED_REALLOC(&arena, buffer, size, 64) );
+		REQUIRE(0xfe == buffer[size/2-1]);
+	}
+
+	REQUIRE( (8<<20) < arena.getCommittedSize() );
+
+	// Not last allocation is copied.
+	uint8_t* ptr1 = (uint8_t*)BX_REALLOC(&arena, ptr0, 200);
+	REQUIRE(ptr1 != ptr0);
+	REQUIRE(ptr1 > buffer);
+
+	REQUIRE(NULL == BX_ALLOC(&arena, 64<<20) );
+
+	arena.reset();
+	REQUIRE(0 == arena.getUsedSize() );
+
+	arena.trim();
+	REQUIRE(0 == arena.getCommittedSize() );
+
+	uint8_t* ptr2 = (uint8_t*)BX_ALLOC(&arena, 100);
+	REQUIRE(ptr2 == ptr0);
+	BX_FREE(&arena, ptr2);
+	REQUIRE(0 == arena.getUsedSize() );
+}
+
+TEST_CASE("PoolAllocator", "")
+{
+	bx::DefaultAllocator allocator;
+	bx::PoolAllocatorT<24, 4> pool(&allocator);
+
+	REQUIRE(24 == pool.getBlockSize() );
+	REQUIRE(8  == pool.getBlockAlign() );
+
+	void* ptr[10];
+	for (uint32_t ii = 0; ii < BX_COUNTOF(ptr); ++ii)
+	{
+		ptr[ii] = BX_ALLOC(&pool, 24);
+		REQUIRE(testAlignment(8, ptr[ii]) );
+		bx::memSet(ptr[ii], uint8_t(ii), 24);
+	}
+
+	REQUIRE(10 == pool.getNumBlocks() );
+
+	for (uint32_t ii = 0; ii < BX_COUNTOF(ptr); ++ii)
+	{
+		REQUIRE(uint8_t(ii) == ( (uint8_t*)ptr[ii])[23]);
+	}
+
+	REQUIRE(ptr[3] == BX_REALLOC(&pool, ptr[3], 16) );
+
+	BX_FREE(&pool, ptr[7]);
+	BX_FREE(&pool, ptr[3]);
+	REQUIRE(8 == pool.getNumBlocks() );
+
+	REQUIRE(ptr[3] == BX_ALLOC(&pool, 24) );
+	REQUIRE(ptr[7] == BX_ALLOC(&pool, 24) );
+
+	for (uint32_t ii = 0; ii < BX_COUNTOF(ptr); ++ii)
+	{
+		BX_FREE(&pool, ptr[ii]);
+	}
+
+	REQUIRE(0 == pool.getNumBlocks() );
+
+	bx::PoolAllocator nodePool(&allocator, 2*sizeof(void*) );
+	bx::SpScUnboundedQueue queue(&nodePool);
+
+	for (uintptr_t ii = 1; ii < 1000; ++ii)
+	{
+		queue.push(reinterpret_cast<void*>(ii) );
+		REQUIRE(ii == reinterpret_cast<uintptr_t>(queue.pop() ) );
+	}
+
+	REQUIRE(3 >= nodePool.getNumBlocks() );
+}
+
+#if BX_CONFIG_SUPPORTS_THREADING
+static int32_t concurrentPoolThread(bx::Thread* _self, void* _userData)
+{
+	BX_UNUSED(_self);
+	bx::AllocatorI* allocator = (bx::AllocatorI*)_userData;
+
+	uint32_t* ptr[64];
+
+	for (uint32_t ii = 0; ii < 1000; ++ii)
+	{
+		for (uint32_t jj = 0; jj < BX_COUNTOF(ptr); ++jj)
+		{
+			ptr[jj] = (uint32_t*)BX_ALLOC(allocator, 16);
+			ptr[jj][1] = jj;
+		}
+
+		for (uint32_t jj = 0; jj < BX_COUNTOF(ptr); ++jj)
+		{
+			if (jj != ptr[jj][1])
+			{
+				return bx::kExitFailure;
+			}
+
+			BX_FREE(allocator, ptr[jj]);
+		}
+	}
+
+	return bx::kExitSuccess;
+}
+
+TEST_CASE("ConcurrentPoolAllocator", "")
+{
+	bx::DefaultAllocator allocator;
+	bx::ConcurrentPoolAllocatorT<16, 8> pool(&allocator);
+
+	REQUIRE(16 == pool.getBlockSize() );
+	REQUIRE(16 == pool.getBlockAlign() );
+
+	void* ptr0 = BX_ALLOC(&pool, 16);
+	void* ptr1 = BX_ALLOC(&pool, 16);
+	REQUIRE(ptr0 != ptr1);
+	REQUIRE(2 == pool.getNumBlocks() );
+
+	BX_FREE(&pool, ptr0);
+	BX_FREE(&pool, ptr1);
+	REQUIRE(0 == pool.getNumBlocks() );
+
+	bx::Thread thread[4];
+
+	for (uint32_t ii = 0; ii < BX_COUNTOF(thread); ++ii)
+	{
+		thread[ii].init(concurrentPoolThread, &pool);
+	}
+
+	for (uint32_t ii = 0; ii < BX_COUNTOF(thread); ++ii)
+	{
+		thread[ii].shutdown();
+		REQUIRE(bx::kExitSuccess == thread[ii].getExitCode() );
+	}
+
+	REQUIRE(0 == pool.getNumBlocks() );
+}
+#endif // BX_CONFIG_SUPPORTS_THREADING
+
+static void tlsfStress(bx::TlsfAllocator& _tlsf, uint32_t _numIterations)
+{
+	struct Alloc
+	{
+		uint8_t* ptr;
+		uint32_t size;
+		uint32_t align;
+	};
+
+	Alloc allocs[64];
+	bx::memSet(allocs, 0, sizeof(allocs) );
+
+	bx::RngMwc rng;
+
+	for (uint32_t ii = 0; ii < _numIterations; ++ii)
+	{
+		Alloc& alloc = allocs[rng.gen() % BX_COUNTOF(allocs)];
+
+		if (NULL != alloc.ptr)
+		{
+			uint32_t jj = 0;
+			for (; jj < alloc.size && uint8_t(alloc.size) == alloc.ptr[jj]; ++jj) {}
+			REQUIRE(jj == alloc.size);
+		}
+
+		const uint32_t size  = 1 + rng.gen() % 3000;
+		const uint32_t align = 0 == rng.gen() % 4 ? 1 << (3 + rng.gen() % 6) : 0;
+
+		if (NULL != alloc.ptr
+		&&  0 == rng.gen() % 3)
+		{
+			uint8_t* ptr = (uint8_t*)bx::realloc(&_tlsf, alloc.ptr, size, alloc.align);
+
+			if (NULL == ptr)
+			{
+				continue;
+			}
+
+			const uint32_t num = bx::min(size, alloc.size);
+			uint32_t jj = 0;
+			for (; jj < num && uint8_t(alloc.size) == ptr[jj]; ++jj) {}
+			REQUIRE(jj == num);
+
+			alloc.ptr  = ptr;
+			alloc.size = size;
+		}
+		else
+		{
+			bx::free(&_tlsf, alloc.ptr, alloc.align);
+
+			alloc.ptr   = (uint8_t*)bx::alloc(&_tlsf, size, align);
+			alloc.size  = size;
+			alloc.align = align;
+
+			if (NULL == alloc.ptr)
+			{
+				continue;
+			}
+		}
+
+		REQUIRE(bx::isAligned(alloc.ptr, bx::max(alloc.align, 8) ) );
+		bx::memSet(alloc.ptr, uint8_t(alloc.size), alloc.size);
+	}
+
+	for (uint32_t ii = 0; ii < BX_COUNTOF(allocs); ++ii)
+	{
+		if (NULL != allocs[ii].ptr)
+		{
+			bx::free(&_tlsf, allocs[ii].ptr, allocs[ii].align);
+		}
+	}
+
+	REQUIRE(0 == _tlsf.getUsedSize() );
+}
+
+TEST_CASE("TlsfAllocator", "")
+{
+	static uint8_t s_memory[64<<10];
+
+	{
+		bx::TlsfAllocator tlsf(s_memory, sizeof(s_memory) );
+
+		const size_t maxFree = tlsf.getMaxFreeBlockSize();
+		REQUIRE(0       <  maxFree);
+		REQUIRE(maxFree <= tlsf.getTotalSize() );
+
+		void* ptr0 = BX_ALLOC(&tlsf, 100);
+		void* ptr1 = BX_ALIGNED_ALLOC(&tlsf, 100, 256);
+		REQUIRE(ptr0 != NULL);
+		REQUIRE(bx::isAligned(ptr1, 256) );
+		REQUIRE(0 < tlsf.getUsedSize() );
+
+		REQUIRE(NULL == BX_ALLOC(&tlsf, sizeof(s_memory) ) );
+
+		BX_FREE(&tlsf, ptr0);
+		BX_ALIGNED_FREE(&tlsf, ptr1, 256);
+		REQUIRE(0       == tlsf.getUsedSize() );
+		REQUIRE(maxFree == tlsf.getMaxFreeBlockSize() );
+
+		tlsfStress(tlsf, 10000);
+		REQUIRE(maxFree == tlsf.getMaxFreeBlockSize() );
+	}
+
+	{
+		bx::DefaultAllocator allocator;
+		bx::TlsfAllocator tlsf(&allocator, 16<<10);
+		REQUIRE(0 == tlsf.getTotalSize() );
+
+		void* ptr = BX_ALLOC(&tlsf, 1<<20);
+		REQUIRE(ptr != NULL);
+		REQUIRE( (1<<20) < tlsf.getTotalSize() );
+		BX_FREE(&tlsf, ptr);
+
+		tlsfStress(tlsf, 10000);
+	}
+}
+
+TEST_CASE("ProfilingAllocator", "")
+{
+	bx::DefaultAllocator allocator;
+	bx::ProfilingAllocator profiler(&allocator, 16);
+
+	static const char* s_file = "allocator_test.cpp";
+
+	void* ptr[4];
+
+	for (uint32_t ii = 0; ii < BX_COUNTOF(ptr); ++ii)
+	{
+		ptr[ii] = bx::alloc(&profiler, 100, 0, s_file, 1);
+		REQUIRE(ptr[ii] != NULL);
+		REQUIRE(bx::isAligned(ptr[ii], 8) );
+	}
+
+	void* aligned = bx::alloc(&profiler, 4000, 64, s_file, 2);
+	REQUIRE(bx::isAligned(aligned, 64) );
+	bx::memSet(aligned, 0xfe, 4000);
+
+	REQUIRE(2 == profiler.getNumSites() );
+
+	bx::free(&profiler, ptr[0], 0, s_file, 3);
+	bx::free(&profiler, ptr[1], 0, s_file, 3);
+
+	bx::AllocationSiteStats stats[4];
+	REQUIRE(2 == profiler.getStats(stats, BX_COUNTOF(stats) ) );
+
+	REQUIRE(2    == stats[0].line);
+	REQUIRE(4000 == stats[0].peakSize);
+	REQUIRE(1    == stats[0].histogram[8]);
+
+	REQUIRE(1   == stats[1].line);
+	REQUIRE(4   == stats[1].numAllocs);
+	REQUIRE(2   == stats[1].numFrees);
+	REQUIRE(200 == stats[1].liveSize);
+	REQUIRE(400 == stats[1].peakSize);
+	REQUIRE(4   == stats[1].histogram[3]);
+
+	REQUIRE(1 == profiler.getStats(stats, 1, bx::ProfilingAllocator::SortBy::NumAllocs) );
+	REQUIRE(1 == stats[0].line);
+
+	aligned = bx::realloc(&profiler, aligned, 8000, 64, s_file, 4);
+	REQUIRE(bx::isAligned(aligned, 64) );
+	REQUIRE(0xfe == ( (uint8_t*)aligned)[3999]);
+
+	REQUIRE(3 == profiler.getStats(stats, BX_COUNTOF(stats), bx::ProfilingAllocator::SortBy::LiveSize) );
+	REQUIRE(4    == stats[0].line);
+	REQUIRE(8000 == stats[0].liveSize);
+	REQUIRE(2    == stats[2].line);
+	REQUIRE(0    == stats[2].liveSize);
+
+	bx::SizerWriter writer;
+	profiler.writeReport(&writer);
+	REQUIRE(0 < writer.seek(0, bx::Whence::Current) );
+
+	bx::free(&profiler, ptr[2], 0, s_file, 5);
+	bx::free(&profiler, ptr[3], 0, s_file, 5);
+	bx::free(&profiler, aligned, 64, s_file, 5);
+}
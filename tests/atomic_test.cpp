@@ -43,4 +43,10 @@ TEST_CASE("atomic", "")
 	REQUIRE(fetched == 1389);
 	REQUIRE(test == 1337);
 
+	bx::atomicStore(&test, 1389u);
+	REQUIRE(bx::atomicLoad(&test) == 1389);
+
+	uint64_t test64 = 0;
+	bx::atomicStore(&test64, UINT64_C(0x1337000013890000) );
+	REQUIRE(bx::atomicLoad(&test64) == UINT64_C(0x1337000013890000) );
 }
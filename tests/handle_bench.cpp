@@ -6,6 +6,8 @@
 #include <bx/timer.h>
 #include <bx/handlealloc.h>
 #include <bx/maputil.h>
+#include <bx/math.h>
+#include <bx/rng.h>
 
 #include <tinystl/allocator.h>
 #include <tinystl/unordered_map.h>
@@ -15,6 +17,110 @@
 #include <stdio.h>
 #include <assert.h>
 
+static constexpr uint16_t kCacheSize    = 1<<10;
+static constexpr uint32_t kCacheKeys    = 8<<10;
+static constexpr uint32_t kCacheFrame   = 4<<10;
+static constexpr uint32_t kCacheLookups = 1<<20;
+
+inline uint16_t cacheVictim(bx::HandleAllocLruT<kCacheSize>& _cache)
+{
+	return _cache.getBack();
+}
+
+inline uint16_t cacheVictim(bx::HandleAllocClockT<kCacheSize>& _cache)
+{
+	return _cache.getVictim();
+}
+
+struct CacheTouch
+{
+	enum Enum
+	{
+		Immediate, //!< Touch on every hit.
+		BatchLoop, //!< Collect hits, and touch them one by one once per frame.
+		Batch,     //!< Collect hits, and touch them with single batch touch once per frame.
+	};
+};
+
+// Simulates cache with skewed key distribution.
+template<typename CacheT>
+static void cacheBench(bx::AllocatorI* _allocator, const char* _name, const uint32_t* _keys, CacheTouch::Enum _touch)
+{
+	CacheT*   cache       = BX_NEW(_allocator, CacheT);
+	uint16_t* keyToHandle = (uint16_t*)BX_ALLOC(_allocator, kCacheKeys*sizeof(uint16_t) );
+	uint32_t  handleToKey[kCacheSize];
+	uint16_t  touched[kCacheFrame];
+	uint32_t  numTouched = 0;
+	uint32_t  numHits    = 0;
+
+	for (uint32_t ii = 0; ii < kCacheKeys; ++ii)
+	{
+		keyToHandle[ii] = bx::kInvalidHandle;
+	}
+
+	int64_t elapsed = -bx::getHPCounter();
+
+	for (uint32_t ii = 0; ii < kCacheLookups; ++ii)
+	{
+		const uint32_t key    = _keys[ii];
+		const uint16_t handle = keyToHandle[key];
+
+		if (bx::kInvalidHandle != handle)
+		{
+			++numHits;
+
+			if (CacheTouch::Immediate != _touch)
+			{
+				touched[numTouched++] = handle;
+			}
+			else
+			{
+				cache->touch(handle);
+			}
+		}
+		else
+		{
+			if (cache->getNumHandles() == kCacheSize)
+			{
+				const uint16_t victim = cacheVictim(*cache);
+				keyToHandle[handleToKey[victim] ] = bx::kInvalidHandle;
+				cache->free(victim);
+			}
+
+			const uint16_t newHandle = cache->alloc();
+			keyToHandle[key] = newHandle;
+			handleToKey[newHandle] = key;
+		}
+
+		if (CacheTouch::Immediate != _touch
+		&&  0 == (ii+1) % kCacheFrame)
+		{
+			if (CacheTouch::Batch == _touch)
+			{
+				cache->touch(touched, numTouched);
+			}
+			else
+			{
+				for (uint32_t jj = 0; jj < numTouched; ++jj)
+				{
+					if (cache->isValid(touched[jj]) )
+					{
+						cache->touch(touched[jj]);
+					}
+				}
+			}
+
+			numTouched = 0;
+		}
+	}
+
+	elapsed += bx::getHPCounter();
+	printf("%14s: %15f (hit rate %.2f%%)\n", _name, double(elapsed), 100.0*numHits/kCacheLookups);
+
+	BX_FREE(_allocator, keyToHandle);
+	BX_DELETE(_allocator, cache);
+}
+
 int main()
 {
 	const uint32_t numElements   = 4<<10;
@@ -103,11 +209,129 @@ int main()
 		printf("HandleHashMap: %15f\n", double(elapsed) );
 	}
 
+	///
+	{
+		bx::DefaultAllocator allocator;
+
+		int64_t elapsed = -bx::getHPCounter();
+
+		for (uint32_t ii = 0; ii < numIterations; ++ii)
+		{
+			typedef bx::GrowableHandleHashMapT<uint64_t> HandleHashMap;
+			HandleHashMap map(&allocator);
+			for (uint32_t jj = 0; jj < numElements; ++jj)
+			{
+				bool ok = map.insert(jj, uint16_t(jj) );
+				assert(ok); BX_UNUSED(ok);
+			}
+
+			for (uint32_t jj = 0; jj < numElements; ++jj)
+			{
+				bool ok = map.removeByKey(uint64_t(jj) );
+				assert(ok); BX_UNUSED(ok);
+			}
+
+			assert(map.getNumElements() == 0);
+		}
+
+		elapsed += bx::getHPCounter();
+		printf("  GrowableHHM: %15f\n", double(elapsed) );
+	}
+
+	///
+	{
+		bx::DefaultAllocator allocator;
+
+		const uint32_t numHandles = 1<<20;
+
+		// 16-bit allocator can't hold 1M handles, it cycles through smaller set of handles to do
+		// the same number of operations.
+		{
+			bx::HandleAlloc* handleAlloc = bx::createHandleAlloc(&allocator, UINT16_MAX);
+
+			int64_t elapsed = -bx::getHPCounter();
+
+			for (uint32_t ii = 0; ii < numHandles/UINT16_MAX; ++ii)
+			{
+				for (uint32_t jj = 0; jj < UINT16_MAX; ++jj)
+				{
+					uint16_t handle = handleAlloc->alloc();
+					assert(handleAlloc->isValid(handle) ); BX_UNUSED(handle);
+				}
+
+				for (uint32_t jj = 0; jj < UINT16_MAX; ++jj)
+				{
+					handleAlloc->free(handleAlloc->getHandleAt(0) );
+				}
+			}
+
+			elapsed += bx::getHPCounter();
+			printf("  HandleAlloc: %15f\n", double(elapsed) );
+
+			bx::destroyHandleAlloc(&allocator, handleAlloc);
+		}
+
+		{
+			bx::HandleAlloc32* handleAlloc = bx::createHandleAlloc32(&allocator, numHandles);
+
+			int64_t elapsed = -bx::getHPCounter();
+
+			for (uint32_t jj = 0; jj < numHandles; ++jj)
+			{
+				uint32_t handle = handleAlloc->alloc();
+				assert(handleAlloc->isValid(handle) ); BX_UNUSED(handle);
+			}
+
+			for (uint32_t jj = 0; jj < numHandles; ++jj)
+			{
+				handleAlloc->free(handleAlloc->getHandleAt(0) );
+			}
+
+			elapsed += bx::getHPCounter();
+			printf("HandleAlloc32: %15f\n", double(elapsed) );
+
+			bx::destroyHandleAlloc32(&allocator, handleAlloc);
+		}
+	}
+
+	///
+	{
+		bx::DefaultAllocator allocator;
+
+		// Skewed key distribution, small number of keys is accessed most of the time.
+		uint32_t* keys = (uint32_t*)BX_ALLOC(&allocator, kCacheLookups*sizeof(uint32_t) );
+
+		bx::RngMwc rng;
+		for (uint32_t ii = 0; ii < kCacheLookups; ++ii)
+		{
+			const float rnd = bx::frnd(&rng);
+			const float sq  = rnd*rnd;
+			keys[ii] = bx::min(uint32_t(sq*sq*sq*kCacheKeys), kCacheKeys-1);
+		}
+
+		cacheBench<bx::HandleAllocLruT<kCacheSize>   >(&allocator, "LRU", keys, CacheTouch::Immediate);
+		cacheBench<bx::HandleAllocLruT<kCacheSize>   >(&allocator, "LRU batch loop", keys, CacheTouch::BatchLoop);
+		cacheBench<bx::HandleAllocLruT<kCacheSize>   >(&allocator, "LRU batch", keys, CacheTouch::Batch);
+		cacheBench<bx::HandleAllocClockT<kCacheSize> >(&allocator, "CLOCK", keys, CacheTouch::Immediate);
+		cacheBench<bx::HandleAllocClockT<kCacheSize> >(&allocator, "CLOCK batch", keys, CacheTouch::Batch);
+
+		BX_FREE(&allocator, keys);
+	}
+
 	extern void simd_bench();
 	simd_bench();
 
 	extern void math_bench();
 	math_bench();
 
+	extern void allocator_bench();
+	allocator_bench();
+
+	extern void queue_bench();
+	queue_bench();
+
+	extern void thread_bench();
+	thread_bench();
+
 	return bx::kExitSuccess;
 }
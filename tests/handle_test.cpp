@@ -6,6 +6,49 @@
 #include "test.h"
 #include <bx/handlealloc.h>
 #include <bx/hash.h>
+#include <bx/rng.h>
+#include <bx/thread.h>
+
+TEST_CASE("HandleAlloc32", "")
+{
+	bx::DefaultAllocator allocator;
+	bx::HandleAlloc32* handleAlloc = bx::createHandleAlloc32(&allocator, 100000);
+
+	uint32_t handle[4];
+
+	for (uint32_t ii = 0; ii < BX_COUNTOF(handle); ++ii)
+	{
+		handle[ii] = handleAlloc->alloc();
+		REQUIRE(handleAlloc->isValid(handle[ii]) );
+		REQUIRE(0 == bx::HandleAlloc32::getGeneration(handle[ii]) );
+	}
+
+	REQUIRE(4 == handleAlloc->getNumHandles() );
+	REQUIRE(!handleAlloc->isValid(bx::kInvalidHandle32) );
+
+	handleAlloc->free(handle[1]);
+	REQUIRE(!handleAlloc->isValid(handle[1]) );
+	REQUIRE( handleAlloc->isValid(handle[3]) );
+
+	// Reused index gets new generation, and stale handle stays invalid.
+	const uint32_t reused = handleAlloc->alloc();
+	REQUIRE(bx::HandleAlloc32::getIndex(reused) == bx::HandleAlloc32::getIndex(handle[1]) );
+	REQUIRE(1 == bx::HandleAlloc32::getGeneration(reused) );
+	REQUIRE( handleAlloc->isValid(reused) );
+	REQUIRE(!handleAlloc->isValid(handle[1]) );
+
+	handleAlloc->reset();
+	REQUIRE(0 == handleAlloc->getNumHandles() );
+	REQUIRE(!handleAlloc->isValid(reused) );
+	REQUIRE(!handleAlloc->isValid(handle[0]) );
+
+	while (bx::kInvalidHandle32 != handleAlloc->alloc() ) {}
+	REQUIRE(100000 == handleAlloc->getNumHandles() );
+	REQUIRE(!handleAlloc->isValid(handle[0]) );
+	REQUIRE(!handleAlloc->isValid(reused) );
+
+	bx::destroyHandleAlloc32(&allocator, handleAlloc);
+}
 
 TEST_CASE("HandleListT", "")
 {
@@ -79,6 +122,107 @@ TEST_CASE("HandleAllocLruT", "")
 	}
 }
 
+TEST_CASE("HandleAllocLruT batch touch", "")
+{
+	bx::HandleAllocLruT<16> lru;
+
+	uint16_t handle[4] =
+	{
+		lru.alloc(),
+		lru.alloc(),
+		lru.alloc(),
+		lru.alloc(),
+	};
+
+	lru.free(handle[2]);
+
+	const uint16_t touched[] = { handle[0], handle[2], handle[1], handle[0] };
+	lru.touch(touched, BX_COUNTOF(touched) );
+
+	uint16_t expected0[] = { handle[0], handle[1], handle[3] };
+	uint16_t count = 0;
+	for (uint16_t it = lru.getFront(); it != UINT16_MAX; it = lru.getNext(it), ++count)
+	{
+		REQUIRE(it == expected0[count]);
+	}
+
+	REQUIRE(3 == count);
+
+	// Batch touch must produce the same order as touching each handle.
+	bx::HandleAllocLruT<16> single;
+	bx::HandleAllocLruT<16> batch;
+
+	for (uint32_t ii = 0; ii < 16; ++ii)
+	{
+		single.alloc();
+		batch.alloc();
+	}
+
+	bx::RngMwc rng;
+	uint32_t numErrors = 0;
+
+	for (uint32_t iter = 0; iter < 1000; ++iter)
+	{
+		uint16_t batchHandles[24];
+		const uint32_t num = rng.gen() % BX_COUNTOF(batchHandles);
+
+		for (uint32_t ii = 0; ii < num; ++ii)
+		{
+			// Few distinct handles, so that runs have duplicates.
+			batchHandles[ii] = uint16_t(rng.gen() % 8);
+			single.touch(batchHandles[ii]);
+		}
+
+		batch.touch(batchHandles, num);
+
+		uint16_t prev = bx::kInvalidHandle;
+		for (uint16_t it = single.getFront(), jt = batch.getFront(); it != bx::kInvalidHandle; it = single.getNext(it), jt = batch.getNext(jt) )
+		{
+			numErrors += it != jt;
+			numErrors += prev != batch.getPrev(jt);
+			prev = jt;
+		}
+
+		numErrors += single.getBack() != batch.getBack();
+	}
+
+	REQUIRE(0 == numErrors);
+}
+
+TEST_CASE("HandleAllocClockT", "")
+{
+	bx::HandleAllocClockT<4> clock;
+
+	REQUIRE(bx::kInvalidHandle == clock.getVictim() );
+
+	uint16_t handle[4] =
+	{
+		clock.alloc(),
+		clock.alloc(),
+		clock.alloc(),
+		clock.alloc(),
+	};
+
+	REQUIRE(bx::kInvalidHandle == clock.alloc() );
+
+	// All handles are referenced after alloc, first sweep clears reference bits.
+	REQUIRE(handle[0] == clock.getVictim() );
+
+	clock.touch(handle[1]);
+	REQUIRE(handle[2] == clock.getVictim() );
+
+	clock.free(handle[2]);
+	REQUIRE(3 == clock.getNumHandles() );
+
+	const uint16_t touched[] = { handle[3], handle[2], handle[0] };
+	clock.touch(touched, BX_COUNTOF(touched) );
+	REQUIRE(handle[1] == clock.getVictim() );
+
+	clock.reset();
+	REQUIRE(0 == clock.getNumHandles() );
+	REQUIRE(bx::kInvalidHandle == clock.getVictim() );
+}
+
 TEST_CASE("HandleHashTable", "")
 {
 	typedef bx::HandleHashMapT<512> HashMap;
@@ -117,3 +261,315 @@ TEST_CASE("HandleHashTable", "")
 		REQUIRE(ok);
 	}
 }
+
+TEST_CASE("HandleHashMapT removeByHandle", "")
+{
+	typedef bx::HandleHashMapT<384, uint32_t, 256> HashMap;
+
+	HashMap hm;
+
+	bx::RngMwc rng;
+	uint32_t key[256];
+
+	for (uint32_t ii = 0; ii < BX_COUNTOF(key); ++ii)
+	{
+		key[ii] = UINT32_MAX;
+	}
+
+	for (uint32_t ii = 0; ii < 20000; ++ii)
+	{
+		const uint16_t handle = uint16_t(rng.gen() % BX_COUNTOF(key) );
+
+		if (UINT32_MAX == key[handle])
+		{
+			// Keys with few bits set collide often, and exercise backward shift deletion.
+			key[handle] = rng.gen() & 0x0f0f;
+
+			if (!hm.insert(key[handle], handle) )
+			{
+				key[handle] = UINT32_MAX;
+			}
+		}
+		else if (0 == (ii & 1) )
+		{
+			REQUIRE(hm.removeByHandle(handle) );
+			REQUIRE(!hm.removeByHandle(handle) );
+			key[handle] = UINT32_MAX;
+		}
+		else
+		{
+			REQUIRE(hm.removeByKey(key[handle]) );
+			key[handle] = UINT32_MAX;
+		}
+	}
+
+	uint32_t num = 0;
+
+	for (uint32_t ii = 0; ii < BX_COUNTOF(key); ++ii)
+	{
+		if (UINT32_MAX != key[ii])
+		{
+			REQUIRE(ii == hm.find(key[ii]) );
+			++num;
+		}
+	}
+
+	REQUIRE(num == hm.getNumElements() );
+}
+
+TEST_CASE("GrowableHandleHashMapT", "")
+{
+	bx::DefaultAllocator allocator;
+
+	typedef bx::GrowableHandleHashMapT<uint64_t> HashMap;
+	HashMap hm(&allocator);
+
+	REQUIRE(0 == hm.getMaxCapacity() );
+	REQUIRE(bx::kInvalidHandle == hm.find(0) );
+	REQUIRE(!hm.removeByKey(0) );
+
+	for (uint32_t ii = 0; ii < 10000; ++ii)
+	{
+		REQUIRE(hm.insert(uint64_t(ii)*7919, uint16_t(ii) ) );
+	}
+
+	REQUIRE(!hm.insert(0, 1) );
+	REQUIRE(10000 == hm.getNumElements() );
+	REQUIRE(bx::isPowerOf2(hm.getMaxCapacity() ) );
+	REQUIRE(10000*8 <= hm.getMaxCapacity()*7);
+
+	uint32_t sum = 0;
+	uint32_t num = 0;
+	for (HashMap::Iterator it = hm.first(); hm.next(it); ++num)
+	{
+		sum += it.handle;
+	}
+
+	REQUIRE(10000 == num);
+	REQUIRE(10000*9999/2 == sum);
+
+	for (uint32_t ii = 0; ii < 10000; ii += 2)
+	{
+		REQUIRE(hm.removeByKey(uint64_t(ii)*7919) );
+	}
+
+	REQUIRE(hm.removeByHandle(1) );
+	REQUIRE(!hm.removeByHandle(1) );
+	REQUIRE(4999 == hm.getNumElements() );
+
+	for (uint32_t ii = 0; ii < 10000; ++ii)
+	{
+		const uint16_t expected = 0 == (ii & 1) || 1 == ii ? bx::kInvalidHandle : uint16_t(ii);
+		REQUIRE(expected == hm.find(uint64_t(ii)*7919) );
+	}
+
+	// Churn, deleted slots are recycled without growing table.
+	const uint32_t capacity = hm.getMaxCapacity();
+
+	for (uint32_t ii = 0; ii < 100000; ++ii)
+	{
+		const uint64_t key = UINT64_C(1)<<40 | ii;
+		hm.insert(key, 1);
+		hm.removeByKey(key);
+	}
+
+	REQUIRE(capacity == hm.getMaxCapacity() );
+	REQUIRE(4999 == hm.getNumElements() );
+
+	hm.reset();
+	REQUIRE(0 == hm.getNumElements() );
+	REQUIRE(bx::kInvalidHandle == hm.find(3*7919) );
+}
+
+template<typename HashMapT>
+static void hashMapIteration(HashMapT& _hm)
+{
+	typename HashMapT::Iterator it = _hm.first();
+	REQUIRE(!_hm.next(it) );
+
+	bool found[256] = {};
+
+	for (uint32_t ii = 0; ii < 200; ++ii)
+	{
+		REQUIRE(_hm.insert(ii*31, uint16_t(ii) ) );
+	}
+
+	uint32_t num = 0;
+	for (it = _hm.first(); _hm.next(it); ++num)
+	{
+		REQUIRE(it.handle < 200);
+		REQUIRE(!found[it.handle]);
+		found[it.handle] = true;
+	}
+
+	REQUIRE(200 == num);
+	REQUIRE(!_hm.next(it) );
+
+	_hm.reset();
+	REQUIRE(_hm.insert(7, 3) );
+
+	num = 0;
+	for (it = _hm.first(); _hm.next(it); ++num)
+	{
+		REQUIRE(3 == it.handle);
+	}
+
+	REQUIRE(1 == num);
+}
+
+TEST_CASE("HandleHashMapT iteration", "")
+{
+	bx::HandleHashMapT<256> hm;
+	hashMapIteration(hm);
+
+	bx::DefaultAllocator allocator;
+	bx::GrowableHandleHashMapT<uint32_t> ghm(&allocator);
+	hashMapIteration(ghm);
+}
+
+struct SparseSetPosition
+{
+	float x, y, z;
+};
+
+TEST_CASE("SparseSetT", "")
+{
+	bx::SparseSetT<64, SparseSetPosition, float, uint32_t> sparseSet;
+
+	uint16_t handle[64];
+
+	for (uint32_t ii = 0; ii < BX_COUNTOF(handle); ++ii)
+	{
+		handle[ii] = sparseSet.alloc();
+		sparseSet.get<0>(handle[ii]).x = float(ii);
+		sparseSet.get<1>(handle[ii])   = float(ii*2);
+		sparseSet.get<2>(handle[ii])   = ii;
+	}
+
+	REQUIRE(bx::kInvalidHandle == sparseSet.alloc() );
+
+	for (uint32_t ii = 0; ii < BX_COUNTOF(handle); ii += 3)
+	{
+		sparseSet.free(handle[ii]);
+		REQUIRE(!sparseSet.isValid(handle[ii]) );
+	}
+
+	REQUIRE(42 == sparseSet.getNumHandles() );
+
+	const uint16_t*          handles  = sparseSet.getHandles();
+	const SparseSetPosition* position = sparseSet.getData<0>();
+	const float*             scale    = sparseSet.getData<1>();
+	const uint32_t*          id       = sparseSet.getData<2>();
+
+	uint32_t numErrors = 0;
+
+	for (uint16_t ii = 0, num = sparseSet.getNumHandles(); ii < num; ++ii)
+	{
+		const uint16_t hh = handles[ii];
+		numErrors += 0 == hh%3;
+		numErrors += id[ii] != hh;
+		numErrors += position[ii].x != float(hh);
+		numErrors += scale[ii] != float(hh*2);
+	}
+
+	REQUIRE(0 == numErrors);
+
+	const uint16_t newHandle = sparseSet.alloc();
+	REQUIRE(sparseSet.isValid(newHandle) );
+	REQUIRE(0 == sparseSet.get<2>(newHandle) );
+	REQUIRE(0.0f == sparseSet.get<1>(newHandle) );
+
+	sparseSet.reset();
+	REQUIRE(0 == sparseSet.getNumHandles() );
+}
+
+TEST_CASE("ConcurrentHandleAllocT", "")
+{
+	bx::ConcurrentHandleAllocT<64> handleAlloc;
+	REQUIRE(64 == handleAlloc.getMaxHandles() );
+
+	uint16_t handle[64];
+
+	for (uint32_t ii = 0; ii < BX_COUNTOF(handle); ++ii)
+	{
+		handle[ii] = handleAlloc.alloc();
+		REQUIRE(ii == handle[ii]);
+		REQUIRE(handleAlloc.isValid(handle[ii]) );
+	}
+
+	REQUIRE(bx::kInvalidHandle == handleAlloc.alloc() );
+	REQUIRE(!handleAlloc.isValid(bx::kInvalidHandle) );
+
+	handleAlloc.free(handle[7]);
+	REQUIRE(!handleAlloc.isValid(handle[7]) );
+	REQUIRE(63 == handleAlloc.getNumHandles() );
+	REQUIRE(7 == handleAlloc.alloc() );
+
+	handleAlloc.reset();
+	REQUIRE(0 == handleAlloc.getNumHandles() );
+	REQUIRE(!handleAlloc.isValid(handle[0]) );
+}
+
+#if BX_CONFIG_SUPPORTS_THREADING
+struct ConcurrentHandleAllocTest
+{
+	bx::ConcurrentHandleAllocT<256> handleAlloc;
+	volatile int32_t owner[256];
+	volatile int32_t numErrors;
+};
+
+static int32_t concurrentHandleAllocThread(bx::Thread* _self, void* _userData)
+{
+	BX_UNUSED(_self);
+	ConcurrentHandleAllocTest& test = *(ConcurrentHandleAllocTest*)_userData;
+
+	uint16_t handle[32];
+
+	for (uint32_t ii = 0; ii < 2000; ++ii)
+	{
+		for (uint32_t jj = 0; jj < BX_COUNTOF(handle); ++jj)
+		{
+			handle[jj] = test.handleAlloc.alloc();
+
+			if (bx::kInvalidHandle == handle[jj]
+			||  1 != bx::atomicAddAndFetch<int32_t>(&test.owner[handle[jj] ], 1)
+			||  !test.handleAlloc.isValid(handle[jj]) )
+			{
+				bx::atomicFetchAndAdd<int32_t>(&test.numErrors, 1);
+				return bx::kExitFailure;
+			}
+		}
+
+		for (uint32_t jj = 0; jj < BX_COUNTOF(handle); ++jj)
+		{
+			bx::atomicFetchAndSub<int32_t>(&test.owner[handle[jj] ], 1);
+			test.handleAlloc.free(handle[jj]);
+		}
+	}
+
+	return bx::kExitSuccess;
+}
+
+TEST_CASE("ConcurrentHandleAllocT threads", "")
+{
+	ConcurrentHandleAllocTest test;
+	bx::memSet( (void*)test.owner, 0, sizeof(test.owner) );
+	test.numErrors = 0;
+
+	bx::Thread thread[8];
+
+	for (uint32_t ii = 0; ii < BX_COUNTOF(thread); ++ii)
+	{
+		thread[ii].init(concurrentHandleAllocThread, &test);
+	}
+
+	for (uint32_t ii = 0; ii < BX_COUNTOF(thread); ++ii)
+	{
+		thread[ii].shutdown();
+		REQUIRE(bx::kExitSuccess == thread[ii].getExitCode() );
+	}
+
+	REQUIRE(0 == test.numErrors);
+	REQUIRE(0 == test.handleAlloc.getNumHandles() );
+}
+#endif // BX_CONFIG_SUPPORTS_THREADING
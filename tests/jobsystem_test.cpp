@@ -0,0 +1,382 @@
+/*
+ * Copyright 2010-2023 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bx/blob/master/LICENSE
+ */
+
+#include "test.h"
+#include <bx/bounds.h>
+#include <bx/fiber.h>
+#include <bx/jobsystem.h>
+#include <bx/os.h>
+#include <bx/rng.h>
+
+#if BX_CONFIG_SUPPORTS_THREADING
+
+struct JobSystemTest
+{
+	bx::JobSystem*  system;
+	bx::JobCounter* counter;
+	volatile int32_t sum;
+};
+
+static void jobAdd(void* _userData)
+{
+	JobSystemTest* test = (JobSystemTest*)_userData;
+	bx::atomicFetchAndAdd<int32_t>(&test->sum, 1);
+}
+
+static void jobSpawn(void* _userData)
+{
+	JobSystemTest* test = (JobSystemTest*)_userData;
+
+	// Nested jobs go to worker's own deque, and are waited on from inside of job.
+	bx::JobCounter counter;
+	for (uint32_t ii = 0; ii < 16; ++ii)
+	{
+		test->system->add(jobAdd, test, &counter);
+	}
+
+	test->system->wait(&counter);
+}
+
+TEST_CASE("JobSystem", "")
+{
+	bx::DefaultAllocator allocator;
+	bx::JobSystem system(&allocator, 4, 64);
+	REQUIRE(4 == system.getNumWorkers() );
+
+	JobSystemTest test;
+	test.system = &system;
+	test.sum    = 0;
+
+	bx::JobCounter counter;
+	REQUIRE(counter.isDone() );
+	REQUIRE(!system.runOne() );
+
+	// More jobs than job pool capacity.
+	for (uint32_t ii = 0; ii < 1000; ++ii)
+	{
+		system.add(jobAdd, &test, &counter);
+	}
+
+	system.wait(&counter);
+	REQUIRE(1000 == test.sum);
+
+	test.sum = 0;
+	for (uint32_t ii = 0; ii < 32; ++ii)
+	{
+		system.add(jobSpawn, &test, &counter);
+	}
+
+	system.wait(&counter, false);
+	REQUIRE(counter.isDone() );
+	REQUIRE(32*16 == test.sum);
+}
+
+TEST_CASE("JobSystem default workers", "")
+{
+	bx::DefaultAllocator allocator;
+	bx::JobSystem system(&allocator);
+	REQUIRE(bx::getNumCpus() == system.getNumWorkers() );
+
+	JobSystemTest test;
+	test.system = &system;
+	test.sum    = 0;
+
+	bx::JobCounter counter;
+	for (uint32_t ii = 0; ii < 100; ++ii)
+	{
+		system.add(jobAdd, &test, &counter);
+	}
+
+	system.wait(&counter);
+	REQUIRE(100 == test.sum);
+}
+
+#if BX_CONFIG_SUPPORTS_FIBERS
+struct FiberTest
+{
+	bx::Fiber* thread;
+	bx::Fiber* fiber;
+	uint32_t   value;
+};
+
+static void fiberPingPong(void* _userData)
+{
+	FiberTest* test = (FiberTest*)_userData;
+
+	for (;;)
+	{
+		test->value *= 2;
+		bx::Fiber::switchTo(test->fiber, test->thread);
+	}
+}
+
+TEST_CASE("Fiber", "")
+{
+	bx::DefaultAllocator allocator;
+
+	bx::Fiber thread(&allocator);
+	thread.initFromThread();
+
+	bx::Fiber fiber(&allocator);
+
+	FiberTest test;
+	test.thread = &thread;
+	test.fiber  = &fiber;
+	test.value  = 1;
+
+	REQUIRE(fiber.init(fiberPingPong, &test, 16<<10) );
+
+	for (uint32_t ii = 0; ii < 10; ++ii)
+	{
+		bx::Fiber::switchTo(&thread, &fiber);
+	}
+
+	REQUIRE(1024 == test.value);
+}
+
+struct JobChainTest
+{
+	bx::JobSystem*   system;
+	uint32_t         depth;
+	volatile int32_t sum;
+	volatile int32_t numMigrated;
+};
+
+struct JobChain
+{
+	JobChainTest* test;
+	uint32_t      depth;
+};
+
+static void jobChain(void* _userData)
+{
+	const JobChain& chain = *(const JobChain*)_userData;
+	JobChainTest*   test  = chain.test;
+
+	bx::atomicFetchAndAdd<int32_t>(&test->sum, 1);
+
+	if (chain.depth < test->depth)
+	{
+		const uint32_t tid = bx::getTid();
+
+		// Each job waits on its child, without fibers this would park one thread per level.
+		JobChain child = { test, chain.depth + 1 };
+		bx::JobCounter counter;
+		test->system->add(jobChain, &child, &counter);
+		test->system->wait(&counter);
+
+		// Suspended fiber must resume on the same worker.
+		bx::atomicFetchAndAdd<int32_t>(&test->numMigrated, tid != bx::getTid() );
+	}
+}
+
+TEST_CASE("JobSystem fibers", "")
+{
+	bx::DefaultAllocator allocator;
+	bx::JobSystem system(&allocator, 2, 256, 64);
+	REQUIRE(64 == system.getNumFibers() );
+
+	JobChainTest test;
+	test.system      = &system;
+	test.depth       = 32;
+	test.sum         = 0;
+	test.numMigrated = 0;
+
+	bx::JobCounter counter;
+	JobChain chain[4];
+
+	for (uint32_t ii = 0; ii < BX_COUNTOF(chain); ++ii)
+	{
+		chain[ii].test  = &test;
+		chain[ii].depth = 0;
+		system.add(jobChain, &chain[ii], &counter);
+	}
+
+	system.wait(&counter);
+	REQUIRE(4*33 == test.sum);
+	REQUIRE(0 == test.numMigrated);
+
+	// Nested jobs from first test, and more chains than fibers, remaining jobs run directly on
+	// worker threads.
+	JobSystemTest spawn;
+	spawn.system = &system;
+	spawn.sum    = 0;
+
+	for (uint32_t ii = 0; ii < 128; ++ii)
+	{
+		system.add(jobSpawn, &spawn, &counter);
+	}
+
+	test.sum = 0;
+	JobChain deep[8];
+
+	for (uint32_t ii = 0; ii < BX_COUNTOF(deep); ++ii)
+	{
+		deep[ii].test  = &test;
+		deep[ii].depth = 0;
+		system.add(jobChain, &deep[ii], &counter);
+	}
+
+	system.wait(&counter);
+	REQUIRE(128*16 == spawn.sum);
+	REQUIRE(8*33 == test.sum);
+	REQUIRE(0 == test.numMigrated);
+}
+
+struct FiberPinnedTest
+{
+	bx::JobSystem*  system;
+	bx::JobCounter  suspended; // Fiber job is done.
+	bx::JobCounter  done;
+	uint32_t        numRuns;
+};
+
+static void jobNop(void* _userData)
+{
+	BX_UNUSED(_userData);
+}
+
+static void jobWaitOnFiber(void* _userData)
+{
+	FiberPinnedTest* test = (FiberPinnedTest*)_userData;
+
+	// Runs directly on worker, since the only fiber is suspended. Waiting must resume fiber
+	// pinned to this worker, otherwise counter never reaches zero.
+	test->system->wait(&test->suspended);
+	++test->numRuns;
+}
+
+static void jobSuspend(void* _userData)
+{
+	FiberPinnedTest* test = (FiberPinnedTest*)_userData;
+
+	bx::JobCounter counter;
+	test->system->add(jobNop, NULL, &counter);
+	test->system->add(jobWaitOnFiber, test, &test->done);
+	test->system->wait(&counter);
+
+	++test->numRuns;
+	bx::atomicFetchAndSub<int32_t>(&test->suspended.m_value, 1);
+}
+
+TEST_CASE("JobSystem fibers exhausted", "")
+{
+	bx::DefaultAllocator allocator;
+	bx::JobSystem system(&allocator, 1, 16, 1);
+
+	FiberPinnedTest test;
+	test.system  = &system;
+	test.numRuns = 0;
+	test.suspended.m_value = 1;
+
+	system.add(jobSuspend, &test, &test.done);
+	system.wait(&test.done, false);
+
+	REQUIRE(test.suspended.isDone() );
+	REQUIRE(2 == test.numRuns);
+}
+#endif // BX_CONFIG_SUPPORTS_FIBERS
+
+TEST_CASE("parallelFor", "")
+{
+	bx::DefaultAllocator allocator;
+	bx::JobSystem system(&allocator, 3);
+
+	static uint32_t s_data[100000];
+
+	bx::parallelFor(&system, 0, BX_COUNTOF(s_data), 1000
+		, [&](uint32_t _begin, uint32_t _end)
+		{
+			for (uint32_t ii = _begin; ii < _end; ++ii)
+			{
+				s_data[ii] = ii;
+			}
+		});
+
+	uint32_t numErrors = 0;
+	for (uint32_t ii = 0; ii < BX_COUNTOF(s_data); ++ii)
+	{
+		numErrors += ii != s_data[ii];
+	}
+
+	REQUIRE(0 == numErrors);
+
+	// Nested parallelFor from inside of job.
+	volatile int32_t sum = 0;
+	bx::parallelFor(&system, 0, 16, 1
+		, [&](uint32_t _begin, uint32_t _end)
+		{
+			for (uint32_t ii = _begin; ii < _end; ++ii)
+			{
+				bx::parallelFor(&system, 0, 1000, 10
+					, [&](uint32_t _innerBegin, uint32_t _innerEnd)
+					{
+						bx::atomicFetchAndAdd<int32_t>(&sum, int32_t(_innerEnd - _innerBegin) );
+					});
+			}
+		});
+
+	REQUIRE(16000 == sum);
+
+	const uint64_t total = bx::parallelReduce(&system, 1, 100001, 100, uint64_t(0)
+		, [](uint32_t _begin, uint32_t _end)
+		{
+			uint64_t partial = 0;
+			for (uint32_t ii = _begin; ii < _end; ++ii)
+			{
+				partial += ii;
+			}
+
+			return partial;
+		}
+		, [](uint64_t _a, uint64_t _b)
+		{
+			return _a + _b;
+		});
+
+	REQUIRE(UINT64_C(5000050000) == total);
+
+	// Without job system everything runs on calling thread.
+	const uint32_t numChunks = bx::parallelReduce<uint32_t>(NULL, 0, 100, 1, 0
+		, [](uint32_t _begin, uint32_t _end) { BX_UNUSED(_begin, _end); return 1; }
+		, [](uint32_t _a, uint32_t _b) { return _a + _b; }
+		);
+	REQUIRE(1 == numChunks);
+}
+
+TEST_CASE("parallel bounds", "")
+{
+	bx::DefaultAllocator allocator;
+	bx::JobSystem system(&allocator, 3);
+
+	const uint32_t numVertices = 200000;
+	bx::Vec3* vertices = (bx::Vec3*)BX_ALLOC(&allocator, numVertices*sizeof(bx::Vec3) );
+
+	bx::RngMwc rng;
+	for (uint32_t ii = 0; ii < numVertices; ++ii)
+	{
+		vertices[ii] = bx::mul(bx::randUnitSphere(&rng), bx::frnd(&rng)*100.0f);
+	}
+
+	bx::Aabb aabb;
+	bx::toAabb(aabb, vertices, numVertices, sizeof(bx::Vec3) );
+
+	bx::Aabb parallelAabb;
+	bx::toAabb(parallelAabb, vertices, numVertices, sizeof(bx::Vec3), &system);
+
+	REQUIRE(0 == bx::memCmp(&aabb, &parallelAabb, sizeof(bx::Aabb) ) );
+
+	bx::Sphere sphere;
+	bx::calcMaxBoundingSphere(sphere, vertices, numVertices, sizeof(bx::Vec3) );
+
+	bx::Sphere parallelSphere;
+	bx::calcMaxBoundingSphere(parallelSphere, vertices, numVertices, sizeof(bx::Vec3), &system);
+
+	REQUIRE(0 == bx::memCmp(&sphere, &parallelSphere, sizeof(bx::Sphere) ) );
+
+	BX_FREE(&allocator, vertices);
+}
+
+#endif // BX_CONFIG_SUPPORTS_THREADING
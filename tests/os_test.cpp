@@ -4,9 +4,12 @@
  */
 
 #include "test.h"
+#include <bx/cputopology.h>
 #include <bx/os.h>
 #include <bx/semaphore.h>
+#include <bx/string.h>
 #include <bx/timer.h>
+#include <bx/uint32_t.h>
 
 TEST_CASE("getProcessMemoryUsed", "")
 {
@@ -14,6 +17,147 @@ TEST_CASE("getProcessMemoryUsed", "")
 //	DBG("bx::getProcessMemoryUsed %d", bx::getProcessMemoryUsed() );
 }
 
+TEST_CASE("getNumCpus", "")
+{
+	REQUIRE(0 < bx::getNumCpus() );
+}
+
+static void checkCpuTopology(const bx::CpuTopology& _topology)
+{
+	const uint32_t numCpus = _topology.getNumCpus();
+	REQUIRE(0 < numCpus);
+	REQUIRE(numCpus <= uint32_t(bx::CpuTopology::kMaxCpus) );
+	REQUIRE(0 < _topology.getNumCores() );
+	REQUIRE(_topology.getNumCores() <= numCpus);
+	REQUIRE(0 < _topology.getNumPackages() );
+	REQUIRE(0 < _topology.getNumNumaNodes() );
+	REQUIRE(0 < _topology.getNumL2() );
+	REQUIRE(0 < _topology.getNumL3() );
+
+	const uint64_t mask = _topology.getMask();
+	REQUIRE(numCpus == bx::uint32_cntbits(mask) );
+
+	// One CPU per core, and every CPU belongs to exactly one core, L2, L3 and NUMA node.
+	const uint64_t physicalCoreMask = _topology.getPhysicalCoreMask();
+	REQUIRE(_topology.getNumCores() == bx::uint32_cntbits(physicalCoreMask) );
+	REQUIRE(physicalCoreMask == (physicalCoreMask & mask) );
+
+	uint64_t coreMask = 0;
+	for (uint32_t ii = 0; ii < _topology.getNumCores(); ++ii)
+	{
+		REQUIRE(0 == (coreMask & _topology.getCoreMask(ii) ) );
+		coreMask |= _topology.getCoreMask(ii);
+	}
+
+	REQUIRE(mask == coreMask);
+
+	uint32_t numErrors = 0;
+	for (uint32_t ii = 0; ii < numCpus; ++ii)
+	{
+		const bx::CpuInfo& cpu = _topology.getCpu(ii);
+		const uint64_t bit = UINT64_C(1) << cpu.id;
+
+		numErrors += 0 == (_topology.getCoreMask(cpu.core)         & bit);
+		numErrors += 0 == (_topology.getL2Mask(cpu.l2)             & bit);
+		numErrors += 0 == (_topology.getL3Mask(cpu.l3)             & bit);
+		numErrors += 0 == (_topology.getNumaNodeMask(cpu.numaNode) & bit);
+	}
+
+	REQUIRE(0 == numErrors);
+}
+
+TEST_CASE("CpuTopology", "")
+{
+	bx::CpuTopology topology;
+	checkCpuTopology(topology);
+
+	// Topology used when system topology is not available.
+	bx::CpuTopology fallback(bx::getNumCpus() );
+	checkCpuTopology(fallback);
+	REQUIRE(bx::min(bx::getNumCpus(), uint32_t(bx::CpuTopology::kMaxCpus) ) == fallback.getNumCpus() );
+	REQUIRE(fallback.getNumCpus() == fallback.getNumCores() );
+	REQUIRE(1 == fallback.getNumPackages() );
+	REQUIRE(1 == fallback.getNumL3() );
+
+	bx::CpuTopology large(100);
+	checkCpuTopology(large);
+	REQUIRE(bx::CpuTopology::kMaxCpus == large.getNumCpus() );
+	REQUIRE(UINT64_MAX == large.getMask() );
+}
+
+#if BX_PLATFORM_LINUX
+#	include <stdio.h>
+
+// Returns true if mapping containing address has huge page hint.
+static bool hasHugePageHint(const void* _ptr)
+{
+	FILE* file = fopen("/proc/self/smaps", "r");
+	if (NULL == file)
+	{
+		return false;
+	}
+
+	const uintptr_t addr = uintptr_t(_ptr);
+	bool inRange = false;
+	bool result  = false;
+
+	char line[512];
+	while (NULL != fgets(line, sizeof(line), file) )
+	{
+		unsigned long long begin, end;
+		if (2 == sscanf(line, "%llx-%llx ", &begin, &end) )
+		{
+			inRange = begin <= addr && addr < end;
+		}
+		else if (inRange
+		&&  0 == bx::strCmp(line, "VmFlags:", 8) )
+		{
+			result = !bx::strFind(line, " hg").isEmpty();
+			break;
+		}
+	}
+
+	fclose(file);
+
+	return result;
+}
+#endif // BX_PLATFORM_LINUX
+
+TEST_CASE("virtualMemory", "")
+{
+	const size_t pageSize = bx::getPageSize();
+	REQUIRE(bx::isPowerOf2(pageSize) );
+
+	const size_t size = 16*pageSize;
+	uint8_t* ptr = (uint8_t*)bx::virtualReserve(size, true);
+	REQUIRE(ptr != NULL);
+	REQUIRE(bx::isAligned(ptr, int32_t(pageSize) ) );
+
+	REQUIRE(bx::virtualCommit(ptr, 2*pageSize) );
+	bx::memSet(ptr, 0xfe, 2*pageSize);
+	REQUIRE(0xfe == ptr[2*pageSize-1]);
+
+	REQUIRE(bx::virtualProtect(ptr, pageSize, bx::PageProtect::Read) );
+	REQUIRE(0xfe == ptr[0]);
+	REQUIRE(bx::virtualProtect(ptr, pageSize, bx::PageProtect::ReadWrite) );
+
+#if BX_PLATFORM_LINUX
+	const bool hugePages = hasHugePageHint(ptr);
+#endif // BX_PLATFORM_LINUX
+
+	bx::virtualDecommit(ptr, 2*pageSize);
+
+	REQUIRE(bx::virtualCommit(ptr, pageSize) );
+	REQUIRE(0 == ptr[0]);
+
+#if BX_PLATFORM_LINUX
+	// Decommit must not drop huge page hint of reserved range.
+	REQUIRE(hugePages == hasHugePageHint(ptr) );
+#endif // BX_PLATFORM_LINUX
+
+	bx::virtualRelease(ptr, size);
+}
+
 #if BX_CONFIG_SUPPORTS_THREADING
 
 TEST_CASE("semaphore_timeout", "")
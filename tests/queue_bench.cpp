@@ -0,0 +1,290 @@
+/*
+ * Copyright 2010-2023 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bx/blob/master/LICENSE
+ */
+
+#include <bx/allocator.h>
+#include <bx/file.h>
+#include <bx/os.h>
+#include <bx/spscqueue.h>
+#include <bx/string.h>
+#include <bx/thread.h>
+#include <bx/timer.h>
+#include <bx/workstealingdeque.h>
+
+static const uint32_t kNumItems      = 1<<20;
+static const uint32_t kNumBurstItems = 1<<10;
+
+struct CountingAllocator : public bx::AllocatorI
+{
+	CountingAllocator()
+		: m_numAllocs(0)
+	{
+	}
+
+	virtual void* realloc(
+		  void* _ptr
+		, size_t _size
+		, size_t _align
+		, const char* _file
+		, uint32_t _line
+		) override
+	{
+		if (0 != _size)
+		{
+			bx::atomicFetchAndAdd<int32_t>(&m_numAllocs, 1);
+		}
+
+		return m_allocator.realloc(_ptr, _size, _align, _file, _line);
+	}
+
+	bx::DefaultAllocator m_allocator;
+	volatile int32_t m_numAllocs;
+};
+
+template<typename QueueT>
+static void pushPop(const char* _name)
+{
+	bx::WriterI* writer = bx::getStdOut();
+	bx::Error err;
+
+	CountingAllocator allocator;
+	QueueT queue(&allocator);
+
+	const int32_t numAllocs = allocator.m_numAllocs;
+	int64_t elapsed = -bx::getHPCounter();
+
+	for (uint32_t ii = 0; ii < kNumItems/kNumBurstItems; ++ii)
+	{
+		for (uint32_t jj = 0; jj < kNumBurstItems; ++jj)
+		{
+			queue.push( (void*)uintptr_t(jj+1) );
+		}
+
+		for (uint32_t jj = 0; jj < kNumBurstItems; ++jj)
+		{
+			queue.pop();
+		}
+	}
+
+	elapsed += bx::getHPCounter();
+
+	bx::write(writer, &err, "%-26s: %15f, allocs %d\n", _name, double(elapsed), allocator.m_numAllocs - numAllocs);
+}
+
+#if BX_CONFIG_SUPPORTS_THREADING
+template<typename QueueT>
+static int32_t producerThread(bx::Thread* _self, void* _userData)
+{
+	BX_UNUSED(_self);
+	QueueT* queue = (QueueT*)_userData;
+
+	for (uint32_t ii = 0; ii < kNumItems; ++ii)
+	{
+		queue->push( (void*)uintptr_t(ii+1) );
+	}
+
+	return bx::kExitSuccess;
+}
+
+template<typename QueueT>
+static void producerConsumer(const char* _name)
+{
+	bx::WriterI* writer = bx::getStdOut();
+	bx::Error err;
+
+	CountingAllocator allocator;
+	QueueT queue(&allocator);
+
+	const int32_t numAllocs = allocator.m_numAllocs;
+	int64_t elapsed = -bx::getHPCounter();
+
+	bx::Thread producer;
+	producer.init(producerThread<QueueT>, &queue);
+
+	for (uint32_t ii = 0; ii < kNumItems;)
+	{
+		if (NULL != queue.pop() )
+		{
+			++ii;
+		}
+	}
+
+	producer.shutdown();
+
+	elapsed += bx::getHPCounter();
+
+	bx::write(writer, &err, "%-26s: %15f, allocs %d\n", _name, double(elapsed), allocator.m_numAllocs - numAllocs);
+}
+
+static int32_t boundedProducerThread(bx::Thread* _self, void* _userData)
+{
+	BX_UNUSED(_self);
+	bx::SpScBoundedQueueT<uint64_t>* queue = (bx::SpScBoundedQueueT<uint64_t>*)_userData;
+
+	uint64_t values[64];
+	for (uint32_t ii = 0; ii < kNumItems;)
+	{
+		const uint32_t num = bx::min<uint32_t>(BX_COUNTOF(values), kNumItems-ii);
+		for (uint32_t jj = 0; jj < num; ++jj)
+		{
+			values[jj] = ii+jj;
+		}
+
+		const uint32_t pushed = queue->pushN(values, num);
+		ii += pushed;
+
+		if (0 == pushed)
+		{
+			bx::yield();
+		}
+	}
+
+	return bx::kExitSuccess;
+}
+
+static void boundedProducerConsumer(const char* _name)
+{
+	bx::WriterI* writer = bx::getStdOut();
+	bx::Error err;
+
+	CountingAllocator allocator;
+	bx::SpScBoundedQueueT<uint64_t> queue(&allocator, 4<<10);
+
+	const int32_t numAllocs = allocator.m_numAllocs;
+	int64_t elapsed = -bx::getHPCounter();
+
+	bx::Thread producer;
+	producer.init(boundedProducerThread, &queue);
+
+	uint64_t values[64];
+	for (uint32_t ii = 0; ii < kNumItems;)
+	{
+		const uint32_t popped = queue.popN(values, BX_COUNTOF(values) );
+		ii += popped;
+
+		if (0 == popped)
+		{
+			bx::yield();
+		}
+	}
+
+	producer.shutdown();
+
+	elapsed += bx::getHPCounter();
+
+	bx::write(writer, &err, "%-26s: %15f, allocs %d\n", _name, double(elapsed), allocator.m_numAllocs - numAllocs);
+}
+
+struct StealBench
+{
+	StealBench(bx::AllocatorI* _allocator)
+		: deque(_allocator)
+		, numStolen(0)
+		, done(0)
+	{
+	}
+
+	bx::WorkStealingDeque deque;
+	volatile int32_t numStolen;
+	volatile int32_t done;
+};
+
+static int32_t thiefThread(bx::Thread* _self, void* _userData)
+{
+	BX_UNUSED(_self);
+	StealBench& bench = *(StealBench*)_userData;
+
+	int32_t numStolen = 0;
+
+	while (0 == bx::atomicLoad(&bench.done) )
+	{
+		if (NULL != bench.deque.steal() )
+		{
+			++numStolen;
+		}
+		else
+		{
+			bx::yield();
+		}
+	}
+
+	bx::atomicFetchAndAdd(&bench.numStolen, numStolen);
+
+	return bx::kExitSuccess;
+}
+
+static void stealThroughput(uint32_t _numThieves)
+{
+	bx::WriterI* writer = bx::getStdOut();
+	bx::Error err;
+
+	bx::DefaultAllocator allocator;
+	StealBench bench(&allocator);
+
+	bx::Thread thief[8];
+	_numThieves = bx::min<uint32_t>(_numThieves, BX_COUNTOF(thief) );
+
+	int64_t elapsed = -bx::getHPCounter();
+
+	for (uint32_t ii = 0; ii < _numThieves; ++ii)
+	{
+		thief[ii].init(thiefThread, &bench);
+	}
+
+	// Owner pushes work and pops half of it back, thieves take the rest.
+	int32_t numPopped = 0;
+
+	for (uint32_t ii = 0; ii < kNumItems; ii += 2)
+	{
+		bench.deque.push( (void*)uintptr_t(ii+1) );
+		bench.deque.push( (void*)uintptr_t(ii+2) );
+
+		numPopped += NULL != bench.deque.pop();
+	}
+
+	for (void* ptr = bench.deque.pop(); NULL != ptr; ptr = bench.deque.pop() )
+	{
+		++numPopped;
+	}
+
+	bx::atomicStore<int32_t>(&bench.done, 1);
+
+	for (uint32_t ii = 0; ii < _numThieves; ++ii)
+	{
+		thief[ii].shutdown();
+	}
+
+	elapsed += bx::getHPCounter();
+
+	char name[32];
+	bx::snprintf(name, BX_COUNTOF(name), "Steal, %d thieves", _numThieves);
+	bx::write(writer, &err, "%-26s: %15f, popped %d, stolen %d\n", name, double(elapsed), numPopped, bench.numStolen);
+}
+#endif // BX_CONFIG_SUPPORTS_THREADING
+
+void queue_bench()
+{
+	bx::WriterI* writer = bx::getStdOut();
+	bx::Error err;
+	bx::write(writer, &err, "Queue bench\n\n");
+
+	pushPop<bx::SpScUnboundedQueue>("SpScUnboundedQueue");
+	pushPop<bx::SpScUnboundedChunkedQueue>("SpScUnboundedChunkedQueue");
+
+#if BX_CONFIG_SUPPORTS_THREADING
+	bx::write(writer, &err, "\nQueue producer/consumer threads\n\n");
+
+	producerConsumer<bx::SpScUnboundedQueue>("SpScUnboundedQueue");
+	producerConsumer<bx::SpScUnboundedChunkedQueue>("SpScUnboundedChunkedQueue");
+	boundedProducerConsumer("SpScBoundedQueueT popN");
+
+	bx::write(writer, &err, "\nWork-stealing deque\n\n");
+
+	stealThroughput(1);
+	stealThroughput(2);
+	stealThroughput(4);
+#endif // BX_CONFIG_SUPPORTS_THREADING
+
+	bx::write(writer, &err, "\n");
+}
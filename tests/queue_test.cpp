@@ -6,6 +6,10 @@
 #include "test.h"
 #include <bx/spscqueue.h>
 #include <bx/mpscqueue.h>
+#include <bx/mpmcqueue.h>
+#include <bx/workstealingdeque.h>
+#include <bx/os.h>
+#include <bx/thread.h>
 
 void* bitsToPtr(uintptr_t _ui)
 {
@@ -27,6 +31,172 @@ TEST_CASE("SpSc", "")
 	REQUIRE(0xdeadbeef == ptrToBits(queue.pop() ) );
 }
 
+TEST_CASE("SpScChunked", "")
+{
+	bx::DefaultAllocator allocator;
+	bx::SpScUnboundedChunkedQueue queue(&allocator, 4);
+	REQUIRE(NULL == queue.pop() );
+
+	queue.push(bitsToPtr(0xdeadbeef) );
+	REQUIRE(0xdeadbeef == ptrToBits(queue.peek() ) );
+	REQUIRE(0xdeadbeef == ptrToBits(queue.pop() ) );
+	REQUIRE(NULL == queue.peek() );
+
+	uint32_t numErrors = 0;
+
+	for (uint32_t ii = 0; ii < 100; ++ii)
+	{
+		for (uint32_t jj = 0; jj < ii%11; ++jj)
+		{
+			queue.push(bitsToPtr(ii*16+jj+1) );
+		}
+
+		for (uint32_t jj = 0; jj < ii%11; ++jj)
+		{
+			numErrors += ii*16+jj+1 != ptrToBits(queue.pop() );
+		}
+	}
+
+	REQUIRE(0 == numErrors);
+	REQUIRE(NULL == queue.pop() );
+}
+
+#if BX_CONFIG_SUPPORTS_THREADING
+static constexpr uint32_t kSpScNumItems = 100000;
+
+static int32_t spscChunkedProducer(bx::Thread* _self, void* _userData)
+{
+	BX_UNUSED(_self);
+	bx::SpScUnboundedChunkedQueue* queue = (bx::SpScUnboundedChunkedQueue*)_userData;
+
+	for (uint32_t ii = 1; ii <= kSpScNumItems; ++ii)
+	{
+		queue->push(bitsToPtr(ii) );
+	}
+
+	return bx::kExitSuccess;
+}
+
+TEST_CASE("SpScChunked threads", "")
+{
+	bx::DefaultAllocator allocator;
+	bx::SpScUnboundedChunkedQueue queue(&allocator, 64);
+
+	bx::Thread producer;
+	producer.init(spscChunkedProducer, &queue);
+
+	uint32_t numErrors = 0;
+
+	for (uint32_t ii = 1; ii <= kSpScNumItems;)
+	{
+		void* ptr = queue.pop();
+
+		if (NULL != ptr)
+		{
+			numErrors += ii != ptrToBits(ptr);
+			++ii;
+		}
+	}
+
+	producer.shutdown();
+
+	REQUIRE(0 == numErrors);
+	REQUIRE(NULL == queue.pop() );
+}
+#endif // BX_CONFIG_SUPPORTS_THREADING
+
+struct SpScRecord
+{
+	uint32_t id;
+	float value[3];
+};
+
+TEST_CASE("SpScBounded", "")
+{
+	bx::DefaultAllocator allocator;
+	bx::SpScBoundedQueueT<SpScRecord> queue(&allocator, 5);
+	REQUIRE(8 == queue.getCapacity() );
+
+	SpScRecord record = { 1, { 1.0f, 2.0f, 3.0f } };
+	REQUIRE(NULL == queue.peek() );
+	REQUIRE(!queue.pop(record) );
+	REQUIRE(queue.push(record) );
+	REQUIRE(1 == queue.peek()->id);
+
+	SpScRecord popped;
+	REQUIRE(queue.pop(popped) );
+	REQUIRE(1 == popped.id);
+	REQUIRE(3.0f == popped.value[2]);
+
+	SpScRecord records[10];
+	for (uint32_t ii = 0; ii < BX_COUNTOF(records); ++ii)
+	{
+		records[ii].id = ii;
+	}
+
+	// Wraps around end of ring.
+	REQUIRE(8 == queue.pushN(records, BX_COUNTOF(records) ) );
+	REQUIRE(!queue.push(record) );
+
+	SpScRecord out[10];
+	REQUIRE(5 == queue.popN(out, 5) );
+	REQUIRE(4 == out[4].id);
+	REQUIRE(2 == queue.pushN(&records[8], 2) );
+	REQUIRE(5 == queue.popN(out, BX_COUNTOF(out) ) );
+	REQUIRE(5 == out[0].id);
+	REQUIRE(9 == out[4].id);
+	REQUIRE(0 == queue.popN(out, BX_COUNTOF(out) ) );
+}
+
+#if BX_CONFIG_SUPPORTS_THREADING
+static int32_t spscBoundedProducer(bx::Thread* _self, void* _userData)
+{
+	BX_UNUSED(_self);
+	bx::SpScBoundedQueueT<uint32_t>* queue = (bx::SpScBoundedQueueT<uint32_t>*)_userData;
+
+	uint32_t values[7];
+	for (uint32_t ii = 0; ii < kSpScNumItems;)
+	{
+		const uint32_t num = bx::min<uint32_t>(BX_COUNTOF(values), kSpScNumItems-ii);
+		for (uint32_t jj = 0; jj < num; ++jj)
+		{
+			values[jj] = ii+jj;
+		}
+
+		ii += queue->pushN(values, num);
+	}
+
+	return bx::kExitSuccess;
+}
+
+TEST_CASE("SpScBounded threads", "")
+{
+	bx::DefaultAllocator allocator;
+	bx::SpScBoundedQueueT<uint32_t> queue(&allocator, 64);
+
+	bx::Thread producer;
+	producer.init(spscBoundedProducer, &queue);
+
+	uint32_t numErrors = 0;
+	uint32_t values[5];
+
+	for (uint32_t ii = 0; ii < kSpScNumItems;)
+	{
+		const uint32_t num = queue.popN(values, BX_COUNTOF(values) );
+
+		for (uint32_t jj = 0; jj < num; ++jj, ++ii)
+		{
+			numErrors += ii != values[jj];
+		}
+	}
+
+	producer.shutdown();
+
+	REQUIRE(0 == numErrors);
+	REQUIRE(NULL == queue.peek() );
+}
+#endif // BX_CONFIG_SUPPORTS_THREADING
+
 TEST_CASE("MpSc", "")
 {
 	bx::DefaultAllocator allocator;
@@ -34,3 +204,368 @@ TEST_CASE("MpSc", "")
 	queue.push(bitsToPtr(0xdeadbeef) );
 	REQUIRE(0xdeadbeef == ptrToBits(queue.pop() ) );
 }
+
+TEST_CASE("MpSc lock-free", "")
+{
+	bx::DefaultAllocator allocator;
+	bx::MpScUnboundedLockFreeQueueT<void> queue(&allocator);
+	REQUIRE(NULL == queue.peek() );
+	REQUIRE(NULL == queue.pop() );
+
+	queue.push(bitsToPtr(0xdeadbeef) );
+	queue.push(bitsToPtr(0xc0ffee) );
+	REQUIRE(0xdeadbeef == ptrToBits(queue.peek() ) );
+	REQUIRE(0xdeadbeef == ptrToBits(queue.pop() ) );
+	REQUIRE(0xc0ffee   == ptrToBits(queue.pop() ) );
+	REQUIRE(NULL == queue.pop() );
+
+	// Nodes still in queue are freed by destructor.
+	queue.push(bitsToPtr(1) );
+}
+
+#if BX_CONFIG_SUPPORTS_THREADING
+static constexpr uint32_t kMpScNumItems = 20000;
+
+template<typename QueueT>
+static int32_t mpscProducer(bx::Thread* _self, void* _userData)
+{
+	BX_UNUSED(_self);
+	QueueT* queue = (QueueT*)_userData;
+
+	for (uint32_t ii = 1; ii <= kMpScNumItems; ++ii)
+	{
+		queue->push(bitsToPtr(ii) );
+	}
+
+	return bx::kExitSuccess;
+}
+
+// Pops items pushed by producers, and checks that items from each producer arrive in order they
+// were pushed. Returns number of errors.
+template<typename QueueT, uint32_t NumProducersT>
+static uint32_t mpscConsume(QueueT& _queue)
+{
+	bx::Thread producer[NumProducersT];
+
+	for (uint32_t ii = 0; ii < NumProducersT; ++ii)
+	{
+		producer[ii].init(mpscProducer<QueueT>, &_queue);
+	}
+
+	uint32_t last[NumProducersT] = {};
+	uint32_t numErrors = 0;
+	uint64_t sum = 0;
+
+	for (uint32_t ii = 0; ii < NumProducersT*kMpScNumItems; ++ii)
+	{
+		void* ptr = _queue.pop();
+
+		// Lock-free queue returns NULL while it's empty, or while producer didn't link its node
+		// yet.
+		while (NULL == ptr)
+		{
+			bx::yield();
+			ptr = _queue.pop();
+		}
+
+		const uint32_t value = uint32_t(ptrToBits(ptr) );
+		sum += value;
+
+		uint32_t jj = 0;
+		for (; jj < NumProducersT && last[jj]+1 != value; ++jj)
+		{
+		}
+
+		if (jj < NumProducersT)
+		{
+			last[jj] = value;
+		}
+		else
+		{
+			++numErrors;
+		}
+	}
+
+	for (uint32_t ii = 0; ii < NumProducersT; ++ii)
+	{
+		producer[ii].shutdown();
+	}
+
+	if (uint64_t(NumProducersT)*kMpScNumItems*(kMpScNumItems+1)/2 != sum)
+	{
+		++numErrors;
+	}
+
+	return numErrors;
+}
+
+TEST_CASE("MpSc threads", "")
+{
+	bx::DefaultAllocator allocator;
+
+	bx::MpScUnboundedBlockingQueue<void> queue(&allocator);
+	REQUIRE(0 == mpscConsume<bx::MpScUnboundedBlockingQueue<void>, 4>(queue) );
+
+	bx::MpScUnboundedLockFreeQueueT<void> lockFreeQueue(&allocator);
+	REQUIRE(0 == mpscConsume<bx::MpScUnboundedLockFreeQueueT<void>, 4>(lockFreeQueue) );
+	REQUIRE(NULL == lockFreeQueue.pop() );
+}
+#endif // BX_CONFIG_SUPPORTS_THREADING
+
+TEST_CASE("MpMc", "")
+{
+	bx::DefaultAllocator allocator;
+	bx::MpMcBoundedQueue queue(&allocator, 6);
+	REQUIRE(8 == queue.getCapacity() );
+
+	REQUIRE(NULL == queue.tryPop() );
+	REQUIRE(queue.tryPush(bitsToPtr(0xdeadbeef) ) );
+	REQUIRE(0xdeadbeef == ptrToBits(queue.tryPop() ) );
+	REQUIRE(NULL == queue.tryPop() );
+
+	void* ptrs[10];
+	for (uint32_t ii = 0; ii < BX_COUNTOF(ptrs); ++ii)
+	{
+		ptrs[ii] = bitsToPtr(ii+1);
+	}
+
+	REQUIRE(8 == queue.tryPush(ptrs, BX_COUNTOF(ptrs) ) );
+	REQUIRE(!queue.tryPush(ptrs[8]) );
+
+	void* popped[10];
+	REQUIRE(3 == queue.tryPop(popped, 3) );
+	REQUIRE(2 == queue.tryPush(&ptrs[8], 2) );
+	REQUIRE(queue.tryPush(ptrs[0]) );
+	REQUIRE(8 == queue.tryPop(popped, BX_COUNTOF(popped) ) );
+	REQUIRE(4 == ptrToBits(popped[0]) );
+	REQUIRE(10 == ptrToBits(popped[6]) );
+	REQUIRE(1 == ptrToBits(popped[7]) );
+	REQUIRE(0 == queue.tryPop(popped, BX_COUNTOF(popped) ) );
+}
+
+#if BX_CONFIG_SUPPORTS_THREADING
+struct MpMcTest
+{
+	MpMcTest(bx::AllocatorI* _allocator)
+		: queue(_allocator, 64)
+		, sum(0)
+		, numPopped(0)
+	{
+	}
+
+	bx::MpMcBoundedQueue queue;
+	volatile int64_t sum;
+	volatile int32_t numPopped;
+};
+
+static constexpr uint32_t kMpMcNumItems = 20000;
+
+static int32_t mpmcProducer(bx::Thread* _self, void* _userData)
+{
+	BX_UNUSED(_self);
+	MpMcTest& test = *(MpMcTest*)_userData;
+
+	void* ptrs[4];
+	for (uint32_t ii = 1; ii <= kMpMcNumItems;)
+	{
+		const uint32_t num = bx::min<uint32_t>(BX_COUNTOF(ptrs), kMpMcNumItems-ii+1);
+		for (uint32_t jj = 0; jj < num; ++jj)
+		{
+			ptrs[jj] = bitsToPtr(ii+jj);
+		}
+
+		ii += test.queue.tryPush(ptrs, num);
+	}
+
+	return bx::kExitSuccess;
+}
+
+static int32_t mpmcConsumer(bx::Thread* _self, void* _userData)
+{
+	BX_UNUSED(_self);
+	MpMcTest& test = *(MpMcTest*)_userData;
+
+	void* ptrs[3];
+	while (bx::atomicLoad(&test.numPopped) < int32_t(2*kMpMcNumItems) )
+	{
+		const uint32_t num = test.queue.tryPop(ptrs, BX_COUNTOF(ptrs) );
+
+		int64_t sum = 0;
+		for (uint32_t ii = 0; ii < num; ++ii)
+		{
+			sum += int64_t(ptrToBits(ptrs[ii]) );
+		}
+
+		bx::atomicFetchAndAdd<int64_t>(&test.sum, sum);
+		bx::atomicFetchAndAdd<int32_t>(&test.numPopped, int32_t(num) );
+	}
+
+	return bx::kExitSuccess;
+}
+
+TEST_CASE("MpMc threads", "")
+{
+	bx::DefaultAllocator allocator;
+	MpMcTest test(&allocator);
+
+	bx::Thread producer[2];
+	bx::Thread consumer[2];
+
+	for (uint32_t ii = 0; ii < BX_COUNTOF(producer); ++ii)
+	{
+		producer[ii].init(mpmcProducer, &test);
+		consumer[ii].init(mpmcConsumer, &test);
+	}
+
+	for (uint32_t ii = 0; ii < BX_COUNTOF(producer); ++ii)
+	{
+		producer[ii].shutdown();
+		consumer[ii].shutdown();
+	}
+
+	const int64_t expected = int64_t(kMpMcNumItems)*(kMpMcNumItems+1);
+	REQUIRE(expected == test.sum);
+	REQUIRE(NULL == test.queue.tryPop() );
+}
+#endif // BX_CONFIG_SUPPORTS_THREADING
+
+TEST_CASE("WorkStealingDeque", "")
+{
+	bx::DefaultAllocator allocator;
+	bx::WorkStealingDeque deque(&allocator, 2);
+
+	REQUIRE(NULL == deque.pop() );
+	REQUIRE(NULL == deque.steal() );
+
+	// Grows past initial capacity.
+	for (uint32_t ii = 1; ii <= 10; ++ii)
+	{
+		deque.push(bitsToPtr(ii) );
+	}
+
+	REQUIRE(10 == deque.getNumItems() );
+	REQUIRE(10 == ptrToBits(deque.pop() ) );
+	REQUIRE(1  == ptrToBits(deque.steal() ) );
+	REQUIRE(2  == ptrToBits(deque.steal() ) );
+	REQUIRE(9  == ptrToBits(deque.pop() ) );
+	REQUIRE(6  == deque.getNumItems() );
+
+	uint32_t num = 0;
+	for (void* ptr = deque.pop(); NULL != ptr; ptr = deque.pop() )
+	{
+		++num;
+	}
+
+	REQUIRE(6 == num);
+
+	REQUIRE(NULL == deque.pop() );
+	REQUIRE(NULL == deque.steal() );
+	REQUIRE(0 == deque.getNumItems() );
+}
+
+#if BX_CONFIG_SUPPORTS_THREADING
+static constexpr uint32_t kWsdNumItems = 50000;
+
+struct WorkStealingDequeTest
+{
+	WorkStealingDequeTest(bx::AllocatorI* _allocator)
+		: deque(_allocator, 16)
+		, numTaken(0)
+		, done(0)
+	{
+		bx::memSet( (void*)taken, 0, sizeof(taken) );
+	}
+
+	bx::WorkStealingDeque deque;
+	volatile int32_t taken[kWsdNumItems+1];
+	volatile int32_t numTaken;
+	volatile int32_t done;
+};
+
+static void workStealingTake(WorkStealingDequeTest& _test, void* _ptr)
+{
+	bx::atomicFetchAndAdd<int32_t>(&_test.taken[ptrToBits(_ptr)], 1);
+	bx::atomicFetchAndAdd<int32_t>(&_test.numTaken, 1);
+}
+
+static int32_t workStealingThief(bx::Thread* _self, void* _userData)
+{
+	BX_UNUSED(_self);
+	WorkStealingDequeTest& test = *(WorkStealingDequeTest*)_userData;
+
+	while (0 == bx::atomicLoad(&test.done) )
+	{
+		void* ptr = test.deque.steal();
+
+		if (NULL != ptr)
+		{
+			workStealingTake(test, ptr);
+		}
+		else
+		{
+			bx::yield();
+		}
+	}
+
+	return bx::kExitSuccess;
+}
+
+TEST_CASE("WorkStealingDeque threads", "")
+{
+	bx::DefaultAllocator allocator;
+	WorkStealingDequeTest* test = BX_NEW(&allocator, WorkStealingDequeTest)(&allocator);
+
+	bx::Thread thief[4];
+
+	for (uint32_t ii = 0; ii < BX_COUNTOF(thief); ++ii)
+	{
+		thief[ii].init(workStealingThief, test);
+	}
+
+	// Owner pushes in bursts and pops some of its own items, while thieves steal.
+	for (uint32_t ii = 1; ii <= kWsdNumItems;)
+	{
+		for (uint32_t jj = 0; jj < 64 && ii <= kWsdNumItems; ++jj, ++ii)
+		{
+			test->deque.push(bitsToPtr(ii) );
+		}
+
+		for (uint32_t jj = 0; jj < 16; ++jj)
+		{
+			void* ptr = test->deque.pop();
+
+			if (NULL != ptr)
+			{
+				workStealingTake(*test, ptr);
+			}
+		}
+	}
+
+	for (void* ptr = test->deque.pop(); NULL != ptr; ptr = test->deque.pop() )
+	{
+		workStealingTake(*test, ptr);
+	}
+
+	while (int32_t(kWsdNumItems) != bx::atomicLoad(&test->numTaken) )
+	{
+		bx::yield();
+	}
+
+	bx::atomicStore<int32_t>(&test->done, 1);
+
+	for (uint32_t ii = 0; ii < BX_COUNTOF(thief); ++ii)
+	{
+		thief[ii].shutdown();
+	}
+
+	uint32_t numErrors = 0;
+	for (uint32_t ii = 1; ii <= kWsdNumItems; ++ii)
+	{
+		numErrors += 1 != test->taken[ii];
+	}
+
+	REQUIRE(0 == numErrors);
+
+	BX_DELETE(&allocator, test);
+}
+#endif // BX_CONFIG_SUPPORTS_THREADING
@@ -29,3 +29,72 @@ TEST_CASE("writeBE", "")
 	REQUIRE(err.isOk() );
 	REQUIRE(total == 4);
 }
+
+TEST_CASE("MemoryWriter", "")
+{
+	bx::DefaultAllocator allocator;
+	bx::MemoryBlock mb(&allocator);
+	bx::MemoryWriter writer(&mb);
+
+	bx::Error err;
+
+	int32_t total = 0;
+
+	for (uint32_t ii = 0; ii < 100000; ++ii)
+	{
+		total += bx::write(&writer, ii, &err);
+	}
+
+	REQUIRE(err.isOk() );
+	REQUIRE(400000 == total);
+	REQUIRE(400000 == bx::seek(&writer, 0, bx::Whence::Current) );
+	REQUIRE(400000 <= mb.getSize() );
+
+	const uint32_t* data = (const uint32_t*)mb.more();
+	REQUIRE(0     == data[0]);
+	REQUIRE(99999 == data[99999]);
+}
+
+TEST_CASE("ChunkedMemoryWriter", "")
+{
+	bx::DefaultAllocator allocator;
+	bx::ChunkedMemoryBlock cmb(&allocator, 1<<10);
+	bx::ChunkedMemoryWriter writer(&cmb);
+
+	bx::Error err;
+
+	int32_t total = 0;
+
+	for (uint32_t ii = 0; ii < 100000; ++ii)
+	{
+		total += bx::write(&writer, ii, &err);
+	}
+
+	REQUIRE(err.isOk() );
+	REQUIRE(400000 == total);
+	REQUIRE(400000 == cmb.getSize() );
+	REQUIRE(1 < cmb.getNumChunks() );
+
+	// Overwrite across chunk boundary.
+	const uint32_t overwrite[2] = { UINT32_MAX, UINT32_MAX };
+	bx::seek(&writer, 1020, bx::Whence::Begin);
+	REQUIRE(8 == bx::write(&writer, overwrite, sizeof(overwrite), &err) );
+	REQUIRE(400000 == bx::seek(&writer, 0, bx::Whence::End) );
+
+	uint32_t* data = (uint32_t*)BX_ALLOC(&allocator, 400000);
+	REQUIRE(400000 == cmb.flatten(data, 400000) );
+
+	REQUIRE(0          == data[0]);
+	REQUIRE(254        == data[254]);
+	REQUIRE(UINT32_MAX == data[255]);
+	REQUIRE(UINT32_MAX == data[256]);
+	REQUIRE(257        == data[257]);
+	REQUIRE(99999      == data[99999]);
+
+	bx::MemoryBlock mb(&allocator);
+	bx::MemoryWriter mw(&mb);
+	REQUIRE(400000 == cmb.gather(&mw, &err) );
+	REQUIRE(0 == bx::memCmp(mb.more(), data, 400000) );
+
+	BX_FREE(&allocator, data);
+}
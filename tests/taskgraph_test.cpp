@@ -0,0 +1,236 @@
+/*
+ * Copyright 2010-2023 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bx/blob/master/LICENSE
+ */
+
+#include "test.h"
+#include <bx/taskgraph.h>
+
+#if BX_CONFIG_SUPPORTS_THREADING
+
+struct TaskGraphTest;
+
+struct TaskGraphTask
+{
+	TaskGraphTest* test;
+	uint16_t       predecessor[2];
+	uint32_t       numPredecessors;
+	int32_t        order;
+};
+
+struct TaskGraphTest
+{
+	TaskGraphTask    task[16];
+	volatile int32_t numDone;
+	volatile int32_t numErrors;
+};
+
+static void taskGraphFn(void* _userData)
+{
+	TaskGraphTask* task = (TaskGraphTask*)_userData;
+	TaskGraphTest* test = task->test;
+
+	// All predecessors must be done before task runs.
+	for (uint32_t ii = 0; ii < task->numPredecessors; ++ii)
+	{
+		const TaskGraphTask& predecessor = test->task[task->predecessor[ii] ];
+		bx::atomicFetchAndAdd<int32_t>(&test->numErrors, 0 > bx::atomicLoad(&predecessor.order) );
+	}
+
+	bx::atomicStore(&task->order, bx::atomicFetchAndAdd<int32_t>(&test->numDone, 1) );
+}
+
+TEST_CASE("TaskGraph", "")
+{
+	bx::DefaultAllocator allocator;
+	bx::TaskGraph graph(&allocator, 16, 32);
+
+	TaskGraphTest test;
+
+	// Pipeline of 4 stages over 4 independent items: decode -> transform -> cull -> pack, and
+	// each stage also depends on the same stage of previous item.
+	for (uint16_t ii = 0; ii < 16; ++ii)
+	{
+		TaskGraphTask& task = test.task[ii];
+		task.test            = &test;
+		task.numPredecessors = 0;
+
+		REQUIRE(ii == graph.add(taskGraphFn, &task, 1 + ii%4) );
+	}
+
+	for (uint16_t item = 0; item < 4; ++item)
+	{
+		for (uint16_t stage = 0; stage < 4; ++stage)
+		{
+			const uint16_t index = item*4 + stage;
+			TaskGraphTask& task = test.task[index];
+
+			if (0 < stage)
+			{
+				task.predecessor[task.numPredecessors++] = index - 1;
+				REQUIRE(graph.addEdge(index - 1, index) );
+			}
+
+			if (0 < item)
+			{
+				task.predecessor[task.numPredecessors++] = index - 4;
+				REQUIRE(graph.addEdge(index - 4, index) );
+			}
+		}
+	}
+
+	REQUIRE(16 == graph.getNumTasks() );
+
+	// Critical path from first task goes through all items and all stages.
+	REQUIRE(1+2+3+4 + 3*4 == graph.getPriority(0) );
+	REQUIRE(4 == graph.getPriority(15) );
+
+	bx::JobSystem system(&allocator, 3, 64);
+
+	for (uint32_t run = 0; run < 100; ++run)
+	{
+		for (uint32_t ii = 0; ii < 16; ++ii)
+		{
+			test.task[ii].order = -1;
+		}
+
+		test.numDone   = 0;
+		test.numErrors = 0;
+
+		REQUIRE(graph.run(0 == run ? NULL : &system) );
+
+		REQUIRE(16 == test.numDone);
+		REQUIRE(0 == test.numErrors);
+	}
+
+	graph.reset();
+	REQUIRE(0 == graph.getNumTasks() );
+}
+
+struct TaskGraphOrderTest
+{
+	bx::TaskGraph* graph;
+	bx::JobSystem* system;
+	uint16_t       order[8];
+	uint32_t       num;
+	bool           ok;
+};
+
+struct TaskGraphOrderTask
+{
+	TaskGraphOrderTest* test;
+	uint16_t            index;
+};
+
+static void taskGraphOrderFn(void* _userData)
+{
+	const TaskGraphOrderTask& task = *(const TaskGraphOrderTask*)_userData;
+	task.test->order[task.test->num++] = task.index;
+}
+
+static void taskGraphRunFn(void* _userData)
+{
+	TaskGraphOrderTest* test = (TaskGraphOrderTest*)_userData;
+
+	// Running graph from worker, ready tasks go to worker's own deque.
+	test->ok = test->graph->run(test->system);
+}
+
+TEST_CASE("TaskGraph priority order", "")
+{
+	bx::DefaultAllocator allocator;
+	bx::TaskGraph graph(&allocator, 8, 8);
+	bx::JobSystem system(&allocator, 1, 16);
+
+	TaskGraphOrderTest test;
+	test.graph  = &graph;
+	test.system = &system;
+	test.num    = 0;
+	test.ok     = false;
+
+	// Root 0 has successors with priorities 1, 5, 3 and 4. Single worker runs them in
+	// descending priority order.
+	static const uint32_t cost[] = { 1, 1, 5, 3, 4 };
+
+	TaskGraphOrderTask task[BX_COUNTOF(cost)];
+
+	for (uint16_t ii = 0; ii < BX_COUNTOF(cost); ++ii)
+	{
+		task[ii].test  = &test;
+		task[ii].index = ii;
+		REQUIRE(ii == graph.add(taskGraphOrderFn, &task[ii], cost[ii]) );
+
+		if (0 < ii)
+		{
+			REQUIRE(graph.addEdge(0, ii) );
+		}
+	}
+
+	bx::JobCounter counter;
+	system.add(taskGraphRunFn, &test, &counter);
+	system.wait(&counter, false);
+
+	REQUIRE(test.ok);
+	REQUIRE(5 == test.num);
+	REQUIRE(0 == test.order[0]);
+	REQUIRE(2 == test.order[1]);
+	REQUIRE(4 == test.order[2]);
+	REQUIRE(3 == test.order[3]);
+	REQUIRE(1 == test.order[4]);
+}
+
+TEST_CASE("TaskGraph full", "")
+{
+	bx::DefaultAllocator allocator;
+	bx::TaskGraph graph(&allocator, 2, 1);
+
+	REQUIRE(0 == graph.add(taskGraphFn, NULL) );
+	REQUIRE(1 == graph.add(taskGraphFn, NULL) );
+	REQUIRE(bx::kInvalidHandle == graph.add(taskGraphFn, NULL) );
+
+	REQUIRE( graph.addEdge(0, 1) );
+	REQUIRE(!graph.addEdge(0, 1) );
+}
+
+TEST_CASE("TaskGraph cycle", "")
+{
+	bx::DefaultAllocator allocator;
+	bx::TaskGraph graph(&allocator, 4, 4);
+
+	TaskGraphTest test;
+	test.numDone   = 0;
+	test.numErrors = 0;
+
+	for (uint16_t ii = 0; ii < 4; ++ii)
+	{
+		test.task[ii].test            = &test;
+		test.task[ii].numPredecessors = 0;
+		test.task[ii].order           = -1;
+		REQUIRE(ii == graph.add(taskGraphFn, &test.task[ii]) );
+	}
+
+	// 0 -> 1 -> 2 -> 1, and 3 is independent.
+	REQUIRE(graph.addEdge(0, 1) );
+	REQUIRE(graph.addEdge(1, 2) );
+	REQUIRE(graph.addEdge(2, 1) );
+
+	bx::JobSystem system(&allocator, 2, 16);
+
+	// Graph with cycle is rejected, and none of its tasks run.
+	REQUIRE(!graph.run(NULL) );
+	REQUIRE(!graph.run(&system) );
+	REQUIRE(0 == test.numDone);
+
+	graph.reset();
+
+	for (uint16_t ii = 0; ii < 2; ++ii)
+	{
+		REQUIRE(ii == graph.add(taskGraphFn, &test.task[ii]) );
+	}
+
+	REQUIRE(graph.addEdge(0, 1) );
+	REQUIRE(graph.run(&system) );
+	REQUIRE(2 == test.numDone);
+}
+
+#endif // BX_CONFIG_SUPPORTS_THREADING
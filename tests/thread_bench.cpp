@@ -0,0 +1,320 @@
+/*
+ * Copyright 2010-2023 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bx/blob/master/LICENSE
+ */
+
+#include <bx/file.h>
+#include <bx/mutex.h>
+#include <bx/rwlock.h>
+#include <bx/semaphore.h>
+#include <bx/string.h>
+#include <bx/thread.h>
+#include <bx/timer.h>
+
+#if BX_CONFIG_SUPPORTS_THREADING
+
+#if BX_PLATFORM_POSIX
+#	include <pthread.h>
+#endif // BX_PLATFORM_POSIX
+
+static const uint32_t kNumLocks = 1<<20;
+
+#if BX_PLATFORM_POSIX
+// Recursive pthread mutex, same as bx::Mutex implementation before futex, used as baseline.
+struct PthreadMutex
+{
+	PthreadMutex()
+	{
+		pthread_mutexattr_t attr;
+		pthread_mutexattr_init(&attr);
+		pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+		pthread_mutex_init(&m_mutex, &attr);
+		pthread_mutexattr_destroy(&attr);
+	}
+
+	~PthreadMutex()
+	{
+		pthread_mutex_destroy(&m_mutex);
+	}
+
+	void lock()
+	{
+		pthread_mutex_lock(&m_mutex);
+	}
+
+	void unlock()
+	{
+		pthread_mutex_unlock(&m_mutex);
+	}
+
+	pthread_mutex_t m_mutex;
+};
+#endif // BX_PLATFORM_POSIX
+
+template<typename MutexT>
+struct MutexBench
+{
+	MutexT   mutex;
+	uint32_t numLocks;
+	uint32_t value;
+};
+
+template<typename MutexT>
+static int32_t mutexThread(bx::Thread* _self, void* _userData)
+{
+	BX_UNUSED(_self);
+	MutexBench<MutexT>* bench = (MutexBench<MutexT>*)_userData;
+
+	for (uint32_t ii = 0, num = bench->numLocks; ii < num; ++ii)
+	{
+		bench->mutex.lock();
+		++bench->value;
+		bench->mutex.unlock();
+	}
+
+	return bx::kExitSuccess;
+}
+
+template<typename MutexT>
+static void mutexContention(const char* _name, uint32_t _numThreads)
+{
+	bx::WriterI* writer = bx::getStdOut();
+	bx::Error err;
+
+	MutexBench<MutexT> bench;
+	bench.numLocks = kNumLocks/bx::max<uint32_t>(_numThreads, 1);
+	bench.value    = 0;
+
+	bx::Thread thread[8];
+	_numThreads = bx::min<uint32_t>(_numThreads, BX_COUNTOF(thread) );
+
+	int64_t elapsed = -bx::getHPCounter();
+
+	if (0 == _numThreads)
+	{
+		mutexThread<MutexT>(NULL, &bench);
+	}
+
+	for (uint32_t ii = 0; ii < _numThreads; ++ii)
+	{
+		thread[ii].init(mutexThread<MutexT>, &bench);
+	}
+
+	for (uint32_t ii = 0; ii < _numThreads; ++ii)
+	{
+		thread[ii].shutdown();
+	}
+
+	elapsed += bx::getHPCounter();
+
+	char name[64];
+	if (0 == _numThreads)
+	{
+		bx::snprintf(name, BX_COUNTOF(name), "%s, uncontended", _name);
+	}
+	else
+	{
+		bx::snprintf(name, BX_COUNTOF(name), "%s, %d threads", _name, _numThreads);
+	}
+
+	bx::write(writer, &err, "%-26s: %15f, value %d\n", name, double(elapsed), bench.value);
+}
+
+struct ReadMostlyValue
+{
+	uint32_t data[4];
+};
+
+struct ReadMostlyBench
+{
+	bx::Mutex    mutex;
+	bx::RwLock   rwLock;
+	bx::SeqLockT<ReadMostlyValue> seqLock;
+	ReadMostlyValue value;
+	uint32_t numReads;
+	uint32_t type;
+	volatile int32_t sum;
+};
+
+// One write per 64 reads.
+static const uint32_t kReadMostlyWriteRate = 64;
+
+static int32_t readMostlyThread(bx::Thread* _self, void* _userData)
+{
+	BX_UNUSED(_self);
+	ReadMostlyBench* bench = (ReadMostlyBench*)_userData;
+
+	uint32_t sum = 0;
+
+	for (uint32_t ii = 0, num = bench->numReads; ii < num; ++ii)
+	{
+		const bool write = 0 == ii%kReadMostlyWriteRate;
+
+		switch (bench->type)
+		{
+		case 0:
+			{
+				bx::MutexScope scope(bench->mutex);
+				bench->value.data[0] += write;
+				sum += bench->value.data[0];
+			}
+			break;
+
+		case 1:
+			if (write)
+			{
+				bx::RwLockWriteScope scope(bench->rwLock);
+				++bench->value.data[0];
+			}
+			else
+			{
+				bx::RwLockReadScope scope(bench->rwLock);
+				sum += bench->value.data[0];
+			}
+			break;
+
+		default:
+			if (write)
+			{
+				ReadMostlyValue value = bench->seqLock.read();
+				++value.data[0];
+				bench->seqLock.write(value);
+			}
+			else
+			{
+				sum += bench->seqLock.read().data[0];
+			}
+			break;
+		}
+	}
+
+	bx::atomicFetchAndAdd(&bench->sum, int32_t(sum) );
+
+	return bx::kExitSuccess;
+}
+
+static void readMostly(const char* _name, uint32_t _type, uint32_t _numThreads)
+{
+	bx::WriterI* writer = bx::getStdOut();
+	bx::Error err;
+
+	ReadMostlyBench bench;
+	bx::memSet(&bench.value, 0, sizeof(bench.value) );
+	bench.numReads = kNumLocks/_numThreads;
+	bench.type     = _type;
+	bench.sum      = 0;
+
+	bx::Thread thread[8];
+	_numThreads = bx::min<uint32_t>(_numThreads, BX_COUNTOF(thread) );
+
+	int64_t elapsed = -bx::getHPCounter();
+
+	for (uint32_t ii = 0; ii < _numThreads; ++ii)
+	{
+		thread[ii].init(readMostlyThread, &bench);
+	}
+
+	for (uint32_t ii = 0; ii < _numThreads; ++ii)
+	{
+		thread[ii].shutdown();
+	}
+
+	elapsed += bx::getHPCounter();
+
+	char name[64];
+	bx::snprintf(name, BX_COUNTOF(name), "%s, %d threads", _name, _numThreads);
+	bx::write(writer, &err, "%-26s: %15f\n", name, double(elapsed) );
+}
+
+static void semaphoreUncontended()
+{
+	bx::WriterI* writer = bx::getStdOut();
+	bx::Error err;
+
+	bx::Semaphore sem;
+
+	int64_t elapsed = -bx::getHPCounter();
+
+	for (uint32_t ii = 0; ii < kNumLocks; ++ii)
+	{
+		sem.post();
+		sem.wait();
+	}
+
+	elapsed += bx::getHPCounter();
+
+	bx::write(writer, &err, "%-26s: %15f\n", "Semaphore post/wait", double(elapsed) );
+}
+
+static int32_t pongThread(bx::Thread* _self, void* _userData)
+{
+	BX_UNUSED(_self);
+	bx::Semaphore* sem = (bx::Semaphore*)_userData;
+
+	for (uint32_t ii = 0; ii < kNumLocks/16; ++ii)
+	{
+		sem[0].wait();
+		sem[1].post();
+	}
+
+	return bx::kExitSuccess;
+}
+
+static void semaphorePingPong()
+{
+	bx::WriterI* writer = bx::getStdOut();
+	bx::Error err;
+
+	bx::Semaphore sem[2];
+
+	int64_t elapsed = -bx::getHPCounter();
+
+	bx::Thread thread;
+	thread.init(pongThread, sem);
+
+	for (uint32_t ii = 0; ii < kNumLocks/16; ++ii)
+	{
+		sem[0].post();
+		sem[1].wait();
+	}
+
+	thread.shutdown();
+
+	elapsed += bx::getHPCounter();
+
+	bx::write(writer, &err, "%-26s: %15f\n", "Semaphore ping-pong", double(elapsed) );
+}
+#endif // BX_CONFIG_SUPPORTS_THREADING
+
+void thread_bench()
+{
+#if BX_CONFIG_SUPPORTS_THREADING
+	bx::WriterI* writer = bx::getStdOut();
+	bx::Error err;
+	bx::write(writer, &err, "Mutex contention\n\n");
+
+	for (uint32_t numThreads = 0; numThreads <= 8; numThreads = bx::max<uint32_t>(numThreads*2, 1) )
+	{
+		mutexContention<bx::Mutex>("Mutex", numThreads);
+#if BX_PLATFORM_POSIX
+		mutexContention<PthreadMutex>("pthread_mutex", numThreads);
+#endif // BX_PLATFORM_POSIX
+	}
+
+	bx::write(writer, &err, "\nRead-mostly, 1 write per %d reads\n\n", kReadMostlyWriteRate);
+
+	for (uint32_t numThreads = 1; numThreads <= 8; numThreads *= 2)
+	{
+		readMostly("Mutex",    0, numThreads);
+		readMostly("RwLock",   1, numThreads);
+		readMostly("SeqLockT", 2, numThreads);
+	}
+
+	bx::write(writer, &err, "\nSemaphore\n\n");
+
+	semaphoreUncontended();
+	semaphorePingPong();
+
+	bx::write(writer, &err, "\n");
+#endif // BX_CONFIG_SUPPORTS_THREADING
+}
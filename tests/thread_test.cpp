@@ -4,6 +4,9 @@
  */
 
 #include "test.h"
+#include <bx/cputopology.h>
+#include <bx/mutex.h>
+#include <bx/rwlock.h>
 #include <bx/thread.h>
 
 #if BX_CONFIG_SUPPORTS_THREADING
@@ -38,6 +41,212 @@ TEST_CASE("Semaphore", "")
 	REQUIRE(sem.wait() );
 }
 
+TEST_CASE("Semaphore threads", "")
+{
+	bx::Semaphore sem;
+
+	sem.post(3);
+	REQUIRE(sem.wait(0) );
+	REQUIRE(sem.wait(0) );
+	REQUIRE(sem.wait(0) );
+	REQUIRE(!sem.wait(0) );
+
+	struct SemaphorePingPong
+	{
+		static int32_t threadFn(bx::Thread* _thread, void* _userData)
+		{
+			BX_UNUSED(_thread);
+			bx::Semaphore* sem = (bx::Semaphore*)_userData;
+
+			for (uint32_t ii = 0; ii < 1000; ++ii)
+			{
+				sem[0].wait();
+				sem[1].post();
+			}
+
+			return bx::kExitSuccess;
+		}
+	};
+
+	bx::Semaphore pingPong[2];
+
+	bx::Thread thread;
+	thread.init(SemaphorePingPong::threadFn, pingPong);
+
+	uint32_t numPongs = 0;
+	for (uint32_t ii = 0; ii < 1000; ++ii)
+	{
+		pingPong[0].post();
+		numPongs += pingPong[1].wait();
+	}
+
+	thread.shutdown();
+	REQUIRE(1000 == numPongs);
+}
+
+struct MutexTest
+{
+	bx::Mutex mutex;
+	uint32_t  value;
+};
+
+static int32_t mutexThread(bx::Thread* _thread, void* _userData)
+{
+	BX_UNUSED(_thread);
+	MutexTest* test = (MutexTest*)_userData;
+
+	for (uint32_t ii = 0; ii < 10000; ++ii)
+	{
+		bx::MutexScope scope(test->mutex);
+
+		// Mutex is recursive.
+		bx::MutexScope nested(test->mutex);
+		++test->value;
+	}
+
+	return bx::kExitSuccess;
+}
+
+TEST_CASE("Mutex", "")
+{
+	MutexTest test;
+	test.value = 0;
+
+	bx::Thread thread[4];
+	for (uint32_t ii = 0; ii < BX_COUNTOF(thread); ++ii)
+	{
+		thread[ii].init(mutexThread, &test);
+	}
+
+	for (uint32_t ii = 0; ii < BX_COUNTOF(thread); ++ii)
+	{
+		thread[ii].shutdown();
+	}
+
+	REQUIRE(BX_COUNTOF(thread)*10000 == test.value);
+}
+
+struct RwLockTest
+{
+	bx::RwLock lock;
+	uint32_t   value[2];
+	volatile int32_t numErrors;
+};
+
+static int32_t rwLockThread(bx::Thread* _thread, void* _userData)
+{
+	BX_UNUSED(_thread);
+	RwLockTest* test = (RwLockTest*)_userData;
+
+	int32_t numErrors = 0;
+
+	for (uint32_t ii = 0; ii < 10000; ++ii)
+	{
+		if (0 == ii%16)
+		{
+			bx::RwLockWriteScope scope(test->lock);
+			++test->value[0];
+			++test->value[1];
+		}
+		else
+		{
+			bx::RwLockReadScope scope(test->lock);
+			numErrors += test->value[0] != test->value[1];
+		}
+	}
+
+	bx::atomicFetchAndAdd(&test->numErrors, numErrors);
+
+	return bx::kExitSuccess;
+}
+
+TEST_CASE("RwLock", "")
+{
+	RwLockTest test;
+	test.value[0]  = 0;
+	test.value[1]  = 0;
+	test.numErrors = 0;
+
+	{
+		// Multiple readers can hold lock at the same time.
+		bx::RwLockReadScope scope0(test.lock);
+		bx::RwLockReadScope scope1(test.lock);
+	}
+
+	bx::Thread thread[4];
+	for (uint32_t ii = 0; ii < BX_COUNTOF(thread); ++ii)
+	{
+		thread[ii].init(rwLockThread, &test);
+	}
+
+	for (uint32_t ii = 0; ii < BX_COUNTOF(thread); ++ii)
+	{
+		thread[ii].shutdown();
+	}
+
+	REQUIRE(0 == test.numErrors);
+	REQUIRE(BX_COUNTOF(thread)*10000/16 == test.value[0]);
+}
+
+struct SeqLockValue
+{
+	uint32_t a;
+	uint32_t b;
+	uint32_t c;
+};
+
+struct SeqLockTest
+{
+	bx::SeqLockT<SeqLockValue> value;
+	volatile int32_t done;
+};
+
+static int32_t seqLockThread(bx::Thread* _thread, void* _userData)
+{
+	BX_UNUSED(_thread);
+	SeqLockTest* test = (SeqLockTest*)_userData;
+
+	for (uint32_t ii = 1; ii <= 10000; ++ii)
+	{
+		const SeqLockValue value = { ii, ii*2, ii*3 };
+		test->value.write(value);
+	}
+
+	bx::atomicStore<int32_t>(&test->done, 1);
+
+	return bx::kExitSuccess;
+}
+
+TEST_CASE("SeqLock", "")
+{
+	SeqLockTest test;
+	test.done = 0;
+
+	SeqLockValue value = test.value.read();
+	REQUIRE(0 == value.a);
+
+	bx::Thread thread;
+	thread.init(seqLockThread, &test);
+
+	uint32_t numErrors = 0;
+	uint32_t last      = 0;
+
+	while (0 == bx::atomicLoad(&test.done) )
+	{
+		value = test.value.read();
+
+		// Value is never torn, and never goes back.
+		numErrors += value.b != value.a*2 || value.c != value.a*3 || value.a < last;
+		last = value.a;
+	}
+
+	thread.shutdown();
+
+	value = test.value.read();
+	REQUIRE(0 == numErrors);
+	REQUIRE(10000 == value.a);
+}
+
 TEST_CASE("Thread", "")
 {
 	bx::Thread th;
@@ -62,6 +271,28 @@ TEST_CASE("Thread", "")
 	REQUIRE(th.getExitCode() == 1);
 }
 
+TEST_CASE("Thread affinity and priority", "")
+{
+	bx::CpuTopology topology;
+
+	bx::Thread th;
+	REQUIRE(th.init(threadExit0, NULL, 0, "affinity", topology.getCoreMask(0), bx::ThreadPriority::Low) );
+
+#if BX_PLATFORM_LINUX
+	REQUIRE(th.setAffinity(topology.getPhysicalCoreMask() ) );
+	REQUIRE(th.setAffinity(topology.getMask() ) );
+
+	// Lowering priority doesn't require privileges.
+	REQUIRE(th.setPriority(bx::ThreadPriority::Lowest) );
+	REQUIRE(th.setPriority(bx::ThreadPriority::Idle) );
+#endif // BX_PLATFORM_LINUX
+
+	th.push(NULL);
+	th.shutdown();
+	REQUIRE(th.getExitCode() == 0);
+	REQUIRE(reinterpret_cast<void*>(uintptr_t(0x1300) ) == s_mpsc.pop() );
+}
+
 TEST_CASE("MpScUnboundedBlockingQueue", "")
 {
 	void* p0 = s_mpsc.pop();
@@ -72,4 +303,123 @@ TEST_CASE("MpScUnboundedBlockingQueue", "")
 	REQUIRE(result == 0x1389);
 }
 
+static int32_t threadCachingAlloc(bx::Thread* _self, void* _userData)
+{
+	BX_UNUSED(_self);
+	bx::AllocatorI* allocator = (bx::AllocatorI*)_userData;
+
+	void* ptr[100];
+
+	for (uint32_t ii = 0; ii < 100; ++ii)
+	{
+		for (uint32_t jj = 0; jj < BX_COUNTOF(ptr); ++jj)
+		{
+			const size_t size = 1 + (jj*37)%3000;
+			ptr[jj] = BX_ALLOC(allocator, size);
+			bx::memSet(ptr[jj], uint8_t(jj), size);
+		}
+
+		for (uint32_t jj = 0; jj < BX_COUNTOF(ptr); ++jj)
+		{
+			if (uint8_t(jj) != *(uint8_t*)ptr[jj])
+			{
+				return bx::kExitFailure;
+			}
+
+			BX_FREE(allocator, ptr[jj]);
+		}
+	}
+
+	return bx::kExitSuccess;
+}
+
+static int32_t threadCachingRelease(bx::Thread* _self, void* _userData)
+{
+	BX_UNUSED(_self);
+	bx::ThreadCachingAllocator* tca = (bx::ThreadCachingAllocator*)_userData;
+
+	void* ptr[64];
+
+	for (uint32_t ii = 0; ii < BX_COUNTOF(ptr); ++ii)
+	{
+		ptr[ii] = BX_ALLOC(tca, 48);
+	}
+
+	for (uint32_t ii = 0; ii < BX_COUNTOF(ptr); ++ii)
+	{
+		BX_FREE(tca, ptr[ii]);
+	}
+
+	tca->releaseThreadCache();
+
+	return bx::kExitSuccess;
+}
+
+TEST_CASE("ThreadCachingAllocator", "")
+{
+	bx::DefaultAllocator allocator;
+	bx::ThreadCachingAllocator tca(&allocator);
+
+	REQUIRE(0 == tca.getStats(NULL, 0) );
+
+	uint8_t* ptr0 = (uint8_t*)BX_ALLOC(&tca, 20);
+	REQUIRE(bx::isAligned(ptr0, 16) );
+	bx::memSet(ptr0, 0x55, 20);
+
+	REQUIRE(ptr0 == BX_REALLOC(&tca, ptr0, 32) );
+
+	uint8_t* ptr1 = (uint8_t*)BX_REALLOC(&tca, ptr0, 4096);
+	REQUIRE(ptr0 != ptr1);
+	REQUIRE(0x55 == ptr1[19]);
+
+	void* ptr2 = BX_ALIGNED_ALLOC(&tca, 16, 64);
+	REQUIRE(bx::isAligned(ptr2, 64) );
+	BX_ALIGNED_FREE(&tca, ptr2, 64);
+
+	BX_FREE(&tca, ptr1);
+
+	bx::Thread thread[4];
+
+	for (uint32_t ii = 0; ii < BX_COUNTOF(thread); ++ii)
+	{
+		thread[ii].init(threadCachingAlloc, &tca);
+	}
+
+	for (uint32_t ii = 0; ii < BX_COUNTOF(thread); ++ii)
+	{
+		thread[ii].shutdown();
+		REQUIRE(bx::kExitSuccess == thread[ii].getExitCode() );
+	}
+
+	bx::ThreadCacheStats stats[8];
+	const uint32_t num = tca.getStats(stats, BX_COUNTOF(stats) );
+	REQUIRE(5 == num);
+
+	uint64_t numHits   = 0;
+	uint64_t numMisses = 0;
+
+	for (uint32_t ii = 0; ii < num; ++ii)
+	{
+		numHits   += stats[ii].numHits;
+		numMisses += stats[ii].numMisses;
+	}
+
+	REQUIRE(numHits > numMisses);
+
+	// Released cache is unlinked, and memory it held is reused by other threads.
+	tca.releaseThreadCache();
+	REQUIRE(4 == tca.getStats(NULL, 0) );
+
+	thread[0].init(threadCachingRelease, &tca);
+	thread[0].shutdown();
+	REQUIRE(bx::kExitSuccess == thread[0].getExitCode() );
+	REQUIRE(4 == tca.getStats(NULL, 0) );
+
+	void* ptr3 = BX_ALLOC(&tca, 20);
+	REQUIRE(bx::isAligned(ptr3, 16) );
+	bx::memSet(ptr3, 0x55, 20);
+	REQUIRE(5 == tca.getStats(NULL, 0) );
+	BX_FREE(&tca, ptr3);
+}
+
 #endif // BX_CONFIG_SUPPORTS_THREADING